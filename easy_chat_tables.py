@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+# Writes the membership bitmaps easy_chat.c uses to validate words in the
+# Pokémon and move groups, whose indices are species and move ids rather
+# than positions in the group.
+#
+# Run by make, from the root of the repository:
+#   python3 easy_chat_tables.py > src/data/easy_chat/easy_chat_value_list_bitmaps.h
+
+import re
+import sys
+
+EC_INDEX_COUNT = 0x200
+EASY_CHAT_DIR = "src/data/easy_chat/"
+
+DEFINE_RE = re.compile(r"^\s*#define\s+(\w+)\s+(\w+)\s*(?://.*)?$")
+ENTRY_RE = re.compile(r"^\s*(\w+)\s*,")
+ARRAY_RE = re.compile(r"^\s*static const u16 (\w+)\[\]")
+INCLUDE_RE = re.compile(r'^\s*#include "(easy_chat_group_\w+\.h)"')
+GROUP_RE = re.compile(r"\.wordData = \{\.(valueList|words) = (\w+)\}")
+NUM_WORDS_RE = re.compile(r"\.numWords = (\w+)")
+
+
+def read_defines(path):
+    defines = {}
+    with open(path) as header:
+        for line in header:
+            match = DEFINE_RE.match(line)
+            if match:
+                defines[match.group(1)] = match.group(2)
+    return defines
+
+
+def resolve(name, defines):
+    seen = set()
+    while not re.match(r"^(0x[0-9a-fA-F]+|\d+)$", name):
+        if name in seen or name not in defines:
+            sys.exit("easy_chat_tables.py: can't resolve %s" % name)
+        seen.add(name)
+        name = defines[name]
+    return int(name, 0)
+
+
+def read_value_lists(defines):
+    # sEasyChatGroups is indexed by group id; the entries that use a value
+    # list name the array, which lives in one of the included group headers.
+    # Only the first numWords values of a list count.
+    arrays = {}
+    groups = []
+    with open(EASY_CHAT_DIR + "easy_chat_groups.h") as header:
+        for line in header:
+            match = INCLUDE_RE.match(line)
+            if match:
+                arrays.update(read_arrays(EASY_CHAT_DIR + match.group(1), defines))
+                continue
+            match = GROUP_RE.search(line)
+            if match:
+                groups.append(arrays[match.group(2)] if match.group(1) == "valueList" else None)
+                continue
+            match = NUM_WORDS_RE.search(line)
+            if match and groups[-1] is not None:
+                groups[-1] = groups[-1][:resolve(match.group(1), defines)]
+    return groups
+
+
+def read_arrays(path, defines):
+    arrays = {}
+    values = None
+    with open(path) as header:
+        for line in header:
+            match = ARRAY_RE.match(line)
+            if match:
+                values = arrays.setdefault(match.group(1), [])
+                continue
+            match = ENTRY_RE.match(line)
+            if match and values is not None:
+                values.append(resolve(match.group(1), defines))
+    return arrays
+
+
+def main():
+    defines = read_defines("include/constants/species.h")
+    defines.update(read_defines("include/constants/moves.h"))
+
+    print("// Generated by easy_chat_tables.py from the Pokémon and move group lists; do not edit.")
+    print("")
+    print("static const u32 sEasyChatValueListBitmaps[EC_NUM_GROUPS][%d] = {" % (EC_INDEX_COUNT // 32))
+    for group, values in enumerate(read_value_lists(defines)):
+        if values is None:
+            continue
+        words = [0] * (EC_INDEX_COUNT // 32)
+        for value in values:
+            if value >= EC_INDEX_COUNT:
+                sys.exit("easy_chat_tables.py: %d in group %d doesn't fit in an easy chat word" % (value, group))
+            words[value // 32] |= 1 << (value % 32)
+        print("    [%d] = {" % group)
+        for i in range(0, len(words), 4):
+            print("        " + ", ".join("0x%08X" % word for word in words[i:i + 4]) + ",")
+        print("    },")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,899 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "global.h"
+#include "battle.h"
+#include "decompress.h"
+#include "easy_chat.h"
+#include "fieldmap.h"
+#include "pokemon.h"
+#include "random.h"
+#include "util.h"
+#include "constants/easy_chat.h"
+#include "constants/moves.h"
+#include "constants/pokemon.h"
+#include "constants/species.h"
+#include "gba/m4a_internal.h"
+#include "m4a_mixer.h"
+#include "check.h"
+
+// Host benchmarks for the pure-logic parts of the engine. Each benchmark
+// folds its results into a checksum, printed next to the timings, so an
+// algorithmic change that alters behaviour shows up as a different sum for
+// the same seed and iteration count.
+
+#define BENCH_MON_COUNT 256
+#define BENCH_MAP_WIDTH 48
+#define BENCH_MAP_HEIGHT 48
+#define BENCH_COORD_COUNT 1024
+#define BENCH_SOUND_FRAMES 64
+#define BENCH_SOUND_FRAME_LENGTH 0xE0 // 13379 Hz, the game's mixing rate
+#define BENCH_SOUND_DMA_PERIOD 7
+#define BENCH_SOUND_CHANNELS 5
+#define BENCH_LZ_SIZE 0x2000
+#define BENCH_LZ_SLICE 0x100
+#define BENCH_LZ_TILE_SIZE 32
+#define BENCH_LZ_MAX_SIZE(size) (4 + (size) + (size) / 8 + 1)
+#define BENCH_PIC_COUNT (BENCH_LZ_SIZE / BENCH_PIC_SIZE)
+#define BENCH_PIC_SIZE 0x800
+#define BENCH_CRC_SIZE 0x14C // sizeof(struct MEWonderCardData)
+
+struct Benchmark
+{
+    const char *name;
+    u32 (*func)(u32 iterations);
+};
+
+static struct Pokemon sMons[BENCH_MON_COUNT];
+static struct BattlePokemon sBattleMons[BENCH_MON_COUNT];
+
+static u32 sBenchMetatileAttributes[NUM_METATILES_TOTAL];
+static u16 sBenchMapBlocks[BENCH_MAP_WIDTH * BENCH_MAP_HEIGHT];
+static u16 sBenchBorder[4];
+static struct Tileset sBenchPrimaryTileset;
+static struct Tileset sBenchSecondaryTileset;
+static struct MapLayout sBenchMapLayout;
+static s16 sBenchCoords[BENCH_COORD_COUNT][2];
+static u32 sBenchSoundFrames[BENCH_SOUND_FRAMES][BENCH_SOUND_FRAME_LENGTH];
+static u32 sBenchHqBuffer[BENCH_SOUND_FRAME_LENGTH];
+static struct SoundInfo sBenchSoundInfo;
+static u8 sBenchLZRaw[BENCH_LZ_SIZE];
+static u8 sBenchLZData[BENCH_LZ_MAX_SIZE(BENCH_LZ_SIZE)];
+static u8 sBenchLZOut[BENCH_LZ_SIZE];
+static u32 sBenchPicData[BENCH_PIC_COUNT][(BENCH_LZ_MAX_SIZE(BENCH_PIC_SIZE) + 3) / 4];
+static struct CompressedSpriteSheet sBenchPics[BENCH_PIC_COUNT];
+static u32 sBenchPicOut[BENCH_PIC_SIZE / 4];
+
+static void CopyToBattleMon(struct Pokemon *mon, struct BattlePokemon *battleMon)
+{
+    u32 i;
+
+    battleMon->species = GetMonData(mon, MON_DATA_SPECIES, NULL);
+    battleMon->level = GetMonData(mon, MON_DATA_LEVEL, NULL);
+    battleMon->hp = GetMonData(mon, MON_DATA_HP, NULL);
+    battleMon->maxHP = GetMonData(mon, MON_DATA_MAX_HP, NULL);
+    battleMon->attack = GetMonData(mon, MON_DATA_ATK, NULL);
+    battleMon->defense = GetMonData(mon, MON_DATA_DEF, NULL);
+    battleMon->speed = GetMonData(mon, MON_DATA_SPEED, NULL);
+    battleMon->spAttack = GetMonData(mon, MON_DATA_SPATK, NULL);
+    battleMon->spDefense = GetMonData(mon, MON_DATA_SPDEF, NULL);
+    battleMon->type1 = gBaseStats[battleMon->species].type1;
+    battleMon->type2 = gBaseStats[battleMon->species].type2;
+    battleMon->ability = GetAbilityBySpecies(battleMon->species, GetMonData(mon, MON_DATA_ABILITY_NUM, NULL));
+    for (i = 0; i < MAX_MON_MOVES; i++)
+        battleMon->moves[i] = GetMonData(mon, MON_DATA_MOVE1 + i, NULL);
+    for (i = 0; i < NUM_BATTLE_STATS; i++)
+        battleMon->statStages[i] = DEFAULT_STAT_STAGE;
+}
+
+static void InitBenchMons(void)
+{
+    u32 i;
+
+    SeedRng(0x1234);
+    for (i = 0; i < BENCH_MON_COUNT; i++)
+    {
+        u16 species = (Random() % (SPECIES_CHIMECHO)) + 1;
+        u8 level = (Random() % MAX_LEVEL) + 1;
+
+        // Skip the unused Gen 2/3 placeholder slots between Celebi and Treecko.
+        if (species > SPECIES_CELEBI && species < SPECIES_TREECKO)
+            species = SPECIES_CELEBI;
+        CreateMon(&sMons[i], species, level, 32, FALSE, 0, OT_ID_PLAYER_ID, 0);
+        CopyToBattleMon(&sMons[i], &sBattleMons[i]);
+    }
+}
+
+// A map of random metatiles, with attribute values in the same ranges as the
+// real tilesets, loaded through InitMap like any other.
+static void InitBenchMap(void)
+{
+    u32 i;
+
+    SeedRng(0x5678);
+    for (i = 0; i < NUM_METATILES_TOTAL; i++)
+    {
+        sBenchMetatileAttributes[i] = (Random() % 0xE4)
+                                    | ((Random() % 4) << 9)
+                                    | ((Random() % 3) << 24)
+                                    | ((Random() % 3) << 29);
+    }
+    for (i = 0; i < NELEMS(sBenchMapBlocks); i++)
+        sBenchMapBlocks[i] = (Random() % NUM_METATILES_TOTAL) | ((Random() % 2) << 10);
+    for (i = 0; i < NELEMS(sBenchBorder); i++)
+        sBenchBorder[i] = Random() % NUM_METATILES_IN_PRIMARY;
+
+    sBenchPrimaryTileset.numMetatiles = NUM_METATILES_IN_PRIMARY;
+    sBenchPrimaryTileset.metatileAttributes = sBenchMetatileAttributes;
+    sBenchSecondaryTileset.isSecondary = TRUE;
+    sBenchSecondaryTileset.numMetatiles = NUM_METATILES_TOTAL - NUM_METATILES_IN_PRIMARY;
+    sBenchSecondaryTileset.metatileAttributes = sBenchMetatileAttributes + NUM_METATILES_IN_PRIMARY;
+    sBenchMapLayout.width = BENCH_MAP_WIDTH;
+    sBenchMapLayout.height = BENCH_MAP_HEIGHT;
+    sBenchMapLayout.border = sBenchBorder;
+    sBenchMapLayout.map = sBenchMapBlocks;
+    sBenchMapLayout.primaryTileset = &sBenchPrimaryTileset;
+    sBenchMapLayout.secondaryTileset = &sBenchSecondaryTileset;
+    sBenchMapLayout.borderWidth = 2;
+    sBenchMapLayout.borderHeight = 2;
+    gMapHeader.mapLayout = &sBenchMapLayout;
+    gMapHeader.connections = NULL;
+    InitMap();
+
+    // Mostly inside the map, with some border tiles, as around the player.
+    for (i = 0; i < BENCH_COORD_COUNT; i++)
+    {
+        sBenchCoords[i][0] = Random() % (BENCH_MAP_WIDTH + 16);
+        sBenchCoords[i][1] = Random() % (BENCH_MAP_HEIGHT + 16);
+    }
+}
+
+// What the channel mixer adds to hq_buffer_ptr each frame: a few channels
+// of 8-bit samples at random volumes, left in the upper half of each word
+// and right in the lower, loud enough to clip now and then.
+static void InitBenchSound(void)
+{
+    u32 i, j, chan;
+
+    SeedRng(0x9ABC);
+    for (i = 0; i < BENCH_SOUND_FRAMES; i++)
+    {
+        for (chan = 0; chan < BENCH_SOUND_CHANNELS; chan++)
+        {
+            s32 leftVolume = Random() % 128;
+            s32 rightVolume = Random() % 128;
+            u32 phase = Random();
+            u32 step = (Random() % 0x800) + 0x40;
+
+            for (j = 0; j < BENCH_SOUND_FRAME_LENGTH; j++, phase += step)
+            {
+                s32 sample = (s8)(phase >> 8) ^ (s8)(Random() & 7);
+
+                sBenchSoundFrames[i][j] += ((u32)(sample * leftVolume) << 8) + (u32)(sample * rightVolume);
+            }
+        }
+    }
+}
+
+// A greedy LZ77 encoding in the BIOS format. Like gbagfx, it never refers
+// back less than 2 bytes, so the data is fit for LZ77UnCompVram too.
+static void CompressBenchLZ(const u8 *raw, u32 size, u8 *data)
+{
+    u32 i, in, out, flagsPos;
+
+    data[0] = 0x10;
+    data[1] = size;
+    data[2] = size >> 8;
+    data[3] = size >> 16;
+    in = 0;
+    out = 4;
+    while (in < size)
+    {
+        flagsPos = out++;
+        data[flagsPos] = 0;
+        for (i = 0; i < 8 && in < size; i++)
+        {
+            u32 bestLength = 0, bestOffset = 0, offset, length;
+
+            for (offset = 2; offset <= 0x1000 && offset <= in; offset++)
+            {
+                for (length = 0; length < 18 && in + length < size; length++)
+                {
+                    if (raw[in + length] != raw[in + length - offset])
+                        break;
+                }
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestOffset = offset;
+                    if (length == 18)
+                        break;
+                }
+            }
+            if (bestLength >= 3)
+            {
+                data[flagsPos] |= 0x80 >> i;
+                data[out++] = ((bestLength - 3) << 4) | ((bestOffset - 1) >> 8);
+                data[out++] = bestOffset - 1;
+                in += bestLength;
+            }
+            else
+            {
+                data[out++] = raw[in++];
+            }
+        }
+    }
+}
+
+// A sheet of 4bpp tiles, each either a copy of a recent one with a few
+// pixels changed or made up of a handful of colors, compressed whole for the
+// LZ benchmarks and in 64x64 pieces to stand in for mon pics.
+static void MakeBenchTiles(u8 *raw, u32 size)
+{
+    u32 i, j;
+
+    for (i = 0; i < size; i += BENCH_LZ_TILE_SIZE)
+    {
+        if (i != 0 && Random() % 2)
+        {
+            u32 from = i - BENCH_LZ_TILE_SIZE * (1 + Random() % min(i / BENCH_LZ_TILE_SIZE, 64));
+
+            memcpy(&raw[i], &raw[from], BENCH_LZ_TILE_SIZE);
+            for (j = Random() % 4; j != 0; j--)
+                raw[i + Random() % BENCH_LZ_TILE_SIZE] ^= Random() & 0xFF;
+        }
+        else
+        {
+            for (j = 0; j < BENCH_LZ_TILE_SIZE; j++)
+                raw[i + j] = (Random() % 4) * 0x11;
+        }
+    }
+}
+
+static void InitBenchLZ(void)
+{
+    u32 i;
+
+    SeedRng(0xDEF0);
+    MakeBenchTiles(sBenchLZRaw, BENCH_LZ_SIZE);
+    CompressBenchLZ(sBenchLZRaw, BENCH_LZ_SIZE, sBenchLZData);
+    for (i = 0; i < BENCH_PIC_COUNT; i++)
+    {
+        CompressBenchLZ(&sBenchLZRaw[i * BENCH_PIC_SIZE], BENCH_PIC_SIZE, (u8 *)sBenchPicData[i]);
+        sBenchPics[i].data = sBenchPicData[i];
+        sBenchPics[i].size = BENCH_PIC_SIZE;
+        sBenchPics[i].tag = SPECIES_BULBASAUR + i;
+    }
+}
+
+static u32 RunSoundMainDownsample(u32 iterations, u8 reverb, bool8 dryPath)
+{
+    u32 i, j;
+    u32 sum = 0;
+    u8 dmaCounter = BENCH_SOUND_DMA_PERIOD;
+
+    memset(&sBenchSoundInfo, 0, sizeof(sBenchSoundInfo));
+    memset(sBenchHqBuffer, 0, sizeof(sBenchHqBuffer));
+    sBenchSoundInfo.reverb = reverb;
+    for (i = 0; i < iterations; i++)
+    {
+        const u32 *frame = sBenchSoundFrames[i % BENCH_SOUND_FRAMES];
+        s8 *bufferPos = sBenchSoundInfo.pcmBuffer;
+
+        // As SoundMain picks the buffer position from pcmDmaCounter.
+        if (dmaCounter > 1)
+            bufferPos += BENCH_SOUND_FRAME_LENGTH * (BENCH_SOUND_DMA_PERIOD - (dmaCounter - 1));
+        for (j = 0; j < BENCH_SOUND_FRAME_LENGTH; j++)
+            sBenchHqBuffer[j] += frame[j];
+        HostSoundMainDownsample(&sBenchSoundInfo, sBenchHqBuffer, bufferPos, BENCH_SOUND_FRAME_LENGTH, dmaCounter, dryPath);
+        sum = sum * 31 + (u8)bufferPos[0] + ((u8)bufferPos[PCM_DMA_BUF_SIZE] << 8) + sBenchHqBuffer[0];
+        if (--dmaCounter == 0)
+            dmaCounter = BENCH_SOUND_DMA_PERIOD;
+    }
+    for (j = 0; j < NELEMS(sBenchSoundInfo.pcmBuffer); j++)
+        sum = sum * 31 + (u8)sBenchSoundInfo.pcmBuffer[j];
+    for (j = 0; j < BENCH_SOUND_FRAME_LENGTH; j++)
+        sum = sum * 31 + sBenchHqBuffer[j];
+    return sum * 31 + sBenchSoundInfo.gap[1] + (sBenchSoundInfo.gap[2] << 8);
+}
+
+// With no reverb the dry loop has to give the same sum as the full one.
+static u32 Bench_SoundMainDownsample(u32 iterations)
+{
+    return RunSoundMainDownsample(iterations, 0, FALSE);
+}
+
+static u32 Bench_SoundMainDownsampleDry(u32 iterations)
+{
+    return RunSoundMainDownsample(iterations, 0, TRUE);
+}
+
+static u32 Bench_SoundMainDownsampleReverb(u32 iterations)
+{
+    return RunSoundMainDownsample(iterations, 0x50, TRUE);
+}
+
+// One call per iteration, each with the same budget, as a task would make
+// once a frame; the sheet is started over whenever it is done.
+static u32 RunLZDecompressStream(u32 iterations, bool8 vram)
+{
+    struct LZDecompressStream stream;
+    u32 i;
+    u32 sum = 0;
+
+    LZDecompressStreamInit(&stream, sBenchLZData, sBenchLZOut, vram);
+    for (i = 0; i < iterations; i++)
+    {
+        if (LZDecompressStreamRun(&stream, BENCH_LZ_SLICE))
+        {
+            sum = sum * 31 + (memcmp(sBenchLZOut, sBenchLZRaw, BENCH_LZ_SIZE) == 0);
+            LZDecompressStreamInit(&stream, sBenchLZData, sBenchLZOut, vram);
+        }
+        sum = sum * 31 + sBenchLZOut[(i * 97) % BENCH_LZ_SIZE];
+    }
+    return sum;
+}
+
+static u32 Bench_LZDecompressStream(u32 iterations)
+{
+    return RunLZDecompressStream(iterations, FALSE);
+}
+
+static u32 Bench_LZDecompressStreamVram(u32 iterations)
+{
+    return RunLZDecompressStream(iterations, TRUE);
+}
+
+// Front pics of a few mons loaded in turn, as switch-ins and the summary
+// screen do. Resetting the cache before every load gives the cost of
+// decompressing each time.
+static u32 RunLoadSpecialPokePic(u32 iterations, bool8 cached)
+{
+    u32 i, j;
+    u32 sum = 0;
+
+    ResetMonPicCache();
+    for (i = 0; i < iterations; i++)
+    {
+        const struct CompressedSpriteSheet *pic = &sBenchPics[i % BENCH_PIC_COUNT];
+
+        if (!cached)
+            ResetMonPicCache();
+        LoadSpecialPokePic(pic, sBenchPicOut, pic->tag, i, TRUE);
+        for (j = 0; j < NELEMS(sBenchPicOut); j += 61)
+            sum = sum * 31 + sBenchPicOut[j];
+    }
+    return sum;
+}
+
+static u32 Bench_LoadSpecialPokePic(u32 iterations)
+{
+    return RunLoadSpecialPokePic(iterations, FALSE);
+}
+
+static u32 Bench_LoadSpecialPokePicCached(u32 iterations)
+{
+    return RunLoadSpecialPokePic(iterations, TRUE);
+}
+
+static u32 Bench_CalculateMonStats(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        struct Pokemon *mon = &sMons[i % BENCH_MON_COUNT];
+
+        CalculateMonStats(mon);
+        sum += GetMonData(mon, MON_DATA_MAX_HP, NULL) + GetMonData(mon, MON_DATA_SPEED, NULL);
+    }
+    return sum;
+}
+
+static u32 Bench_CalculateBaseDamage(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        struct BattlePokemon *attacker = &sBattleMons[i % BENCH_MON_COUNT];
+        struct BattlePokemon *defender = &sBattleMons[(i * 7 + 3) % BENCH_MON_COUNT];
+        u16 move = attacker->moves[i % MAX_MON_MOVES];
+
+        if (move == MOVE_NONE)
+            move = MOVE_TACKLE;
+        sum += CalculateBaseDamage(attacker, defender, move, 0, 0, 0, B_POSITION_PLAYER_LEFT, B_POSITION_OPPONENT_LEFT);
+    }
+    return sum;
+}
+
+static u32 Bench_GetEvolutionTargetSpecies(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+        sum += GetEvolutionTargetSpecies(&sMons[i % BENCH_MON_COUNT], EVO_MODE_NORMAL, 0);
+    return sum;
+}
+
+static u32 Bench_GetLevelFromBoxMonExp(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+        sum += GetLevelFromBoxMonExp(&sMons[i % BENCH_MON_COUNT].box);
+    return sum;
+}
+
+static u32 Bench_PokedexOrder(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        u16 species = (i % (NUM_SPECIES - 1)) + 1;
+
+        sum += NationalPokedexNumToSpecies(SpeciesToNationalPokedexNum(species));
+        sum += SpeciesToPokedexNum(species);
+    }
+    return sum;
+}
+
+static u32 Bench_MapGridGetMetatileBehaviorAt(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        s16 *coords = sBenchCoords[i % BENCH_COORD_COUNT];
+
+        sum += MapGridGetMetatileBehaviorAt(coords[0], coords[1]);
+    }
+    return sum;
+}
+
+static u32 Bench_MapGridGetMetatileAttributeAt(u32 iterations)
+{
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        s16 *coords = sBenchCoords[i % BENCH_COORD_COUNT];
+
+        sum += MapGridGetMetatileAttributeAt(coords[0], coords[1], METATILE_ATTRIBUTE_TERRAIN)
+             + MapGridGetMetatileAttributeAt(coords[0], coords[1], METATILE_ATTRIBUTE_ENCOUNTER_TYPE) * 4
+             + MapGridGetMetatileLayerTypeAt(coords[0], coords[1]) * 32;
+    }
+    return sum;
+}
+
+// Every index of the Pokémon and move groups in turn, so the sum records
+// which of them are valid words. The other groups' words are text, which
+// isn't encoded for the game's charmap in this build.
+static u32 Bench_CopyEasyChatWord(u32 iterations)
+{
+    static const u8 valueListGroups[] = {EC_GROUP_POKEMON_2, EC_GROUP_MOVE_1, EC_GROUP_MOVE_2, EC_GROUP_POKEMON};
+    u32 i;
+    u32 sum = 0;
+    u8 buffer[32];
+
+    for (i = 0; i < iterations; i++)
+    {
+        u16 word = EC_WORD(valueListGroups[(i >> 9) % NELEMS(valueListGroups)], i);
+        u8 *end = CopyEasyChatWord(buffer, word);
+
+        sum = sum * 31 + (end - buffer) + buffer[0];
+    }
+    return sum;
+}
+
+// One Wonder Card sized block per iteration, starting at each alignment in
+// turn.
+static u32 Bench_CalcCRC16(u32 iterations)
+{
+    static u32 buffer[(BENCH_CRC_SIZE + 4) / 4];
+    u8 *bytes = (u8 *)buffer;
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < sizeof(buffer); i++)
+        bytes[i] = Random();
+    for (i = 0; i < iterations; i++)
+        sum += CalcCRC16(bytes + i % 4, BENCH_CRC_SIZE);
+    return sum;
+}
+
+static u32 Bench_CalcByteArraySum(u32 iterations)
+{
+    static u32 buffer[(BENCH_CRC_SIZE + 4) / 4];
+    u8 *bytes = (u8 *)buffer;
+    u32 i;
+    u32 sum = 0;
+
+    for (i = 0; i < sizeof(buffer); i++)
+        bytes[i] = Random();
+    for (i = 0; i < iterations; i++)
+        sum += CalcByteArraySum(bytes + i % 4, BENCH_CRC_SIZE);
+    return sum;
+}
+
+static const struct Benchmark sBenchmarks[] =
+{
+    {"CalculateMonStats",         Bench_CalculateMonStats},
+    {"CalculateBaseDamage",       Bench_CalculateBaseDamage},
+    {"GetEvolutionTargetSpecies", Bench_GetEvolutionTargetSpecies},
+    {"GetLevelFromBoxMonExp",     Bench_GetLevelFromBoxMonExp},
+    {"PokedexOrder",              Bench_PokedexOrder},
+    {"MapGridGetMetatileBehaviorAt",  Bench_MapGridGetMetatileBehaviorAt},
+    {"MapGridGetMetatileAttributeAt", Bench_MapGridGetMetatileAttributeAt},
+    {"CopyEasyChatWord",          Bench_CopyEasyChatWord},
+    {"SoundMainDownsample",       Bench_SoundMainDownsample},
+    {"SoundMainDownsampleDry",    Bench_SoundMainDownsampleDry},
+    {"SoundMainDownsampleReverb", Bench_SoundMainDownsampleReverb},
+    {"LZDecompressStream",        Bench_LZDecompressStream},
+    {"LZDecompressStreamVram",    Bench_LZDecompressStreamVram},
+    {"LoadSpecialPokePic",        Bench_LoadSpecialPokePic},
+    {"LoadSpecialPokePicCached",  Bench_LoadSpecialPokePicCached},
+    {"CalcCRC16",                 Bench_CalcCRC16},
+    {"CalcByteArraySum",          Bench_CalcByteArraySum},
+};
+
+static double GetSeconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void Usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-n ITERATIONS] [BENCHMARK...]\n", program);
+    fprintf(stderr, "       %s -lz FILE.lz...\n", program);
+    fprintf(stderr, "       %s -warps [FRAME_BUDGET_US]\n", program);
+    fprintf(stderr, "       %s -check [CHECK...]\n", program);
+    fprintf(stderr, "       %s -ai ROM.gba ROM.map\n", program);
+    exit(1);
+}
+
+static u8 *ReadWholeFile(const char *path, long *size)
+{
+    FILE *fp = fopen(path, "rb");
+    u8 *buffer;
+
+    if (fp == NULL)
+        return NULL;
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    rewind(fp);
+    buffer = malloc(*size + 1);
+    if (fread(buffer, 1, *size, fp) != (size_t)*size)
+    {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(fp);
+    return buffer;
+}
+
+// Decompresses an asset with the BIOS model in stubs.c, checks the result
+// against the file it was compressed from when that is next to it, and then
+// checks that the streaming decoder gives the same bytes for a range of
+// budgets, writing to WRAM or VRAM, without touching anything past the end.
+static bool8 CheckLZFile(const char *path)
+{
+    static const u32 budgets[] = {1, 2, 3, 17, 0x100, 0x1000, 0xFFFFFFFF};
+    struct LZDecompressStream stream;
+    u8 *data, *source, *expected, *actual;
+    long dataSize, sourceSize;
+    char sourcePath[1024];
+    u32 size, i, calls;
+    bool8 ok = TRUE;
+    int vram;
+
+    data = ReadWholeFile(path, &dataSize);
+    if (data == NULL)
+    {
+        fprintf(stderr, "%s: can't read file\n", path);
+        return FALSE;
+    }
+    if (dataSize < 4 || data[0] != 0x10)
+    {
+        fprintf(stderr, "%s: not LZ77 compressed\n", path);
+        free(data);
+        return FALSE;
+    }
+
+    size = GetDecompressedDataSize(data);
+    expected = malloc(size + 2);
+    actual = malloc(size + 2);
+    LZ77UnCompWram(data, expected);
+
+    snprintf(sourcePath, sizeof(sourcePath), "%s", path);
+    if (strlen(sourcePath) > 3 && strcmp(sourcePath + strlen(sourcePath) - 3, ".lz") == 0)
+    {
+        sourcePath[strlen(sourcePath) - 3] = '\0';
+        source = ReadWholeFile(sourcePath, &sourceSize);
+        if (source != NULL)
+        {
+            if ((u32)sourceSize != size || memcmp(source, expected, size) != 0)
+            {
+                fprintf(stderr, "%s: doesn't decompress to %s\n", path, sourcePath);
+                ok = FALSE;
+            }
+            free(source);
+        }
+    }
+
+    for (vram = FALSE; vram <= TRUE; vram++)
+    {
+        for (i = 0; i < NELEMS(budgets); i++)
+        {
+            memset(actual, 0xAA, size + 2);
+            LZDecompressStreamInit(&stream, data, actual, vram);
+            for (calls = 0; !LZDecompressStreamRun(&stream, budgets[i]); calls++)
+            {
+                if (calls > size)
+                    break;
+            }
+            if (memcmp(actual, expected, size) != 0 || actual[size] != 0xAA || actual[size + 1] != 0xAA)
+            {
+                fprintf(stderr, "%s: stream decoder differs (%s, %u bytes per call)\n", path, vram ? "VRAM" : "WRAM", budgets[i]);
+                ok = FALSE;
+            }
+        }
+    }
+
+    free(actual);
+    free(expected);
+    free(data);
+    return ok;
+}
+
+static int CheckLZFiles(int count, char **paths)
+{
+    int i;
+    int failed = 0;
+
+    if (count == 0)
+    {
+        fprintf(stderr, "no LZ77 files given\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (!CheckLZFile(paths[i]))
+            failed++;
+    }
+    printf("%d of %d LZ77 files decompressed correctly\n", count - failed, count);
+    return failed != 0;
+}
+
+// A warp route through maps the size of the game's and of larger custom ones,
+// each with compressed tilesets. Every map's layout and tiles are loaded both
+// in one go, which is what a single map load frame used to do, and a step at
+// a time. The steps are then packed into frames the way CB2_LoadMap2 does:
+// steps run back to back until the frame's budget has gone by, so only the
+// step that crosses it can make a frame run long. The report compares the
+// load in one go with the longest of those frames. Times are the best of
+// several loads.
+struct BenchWarp
+{
+    const char *name;
+    u16 width;
+    u16 height;
+    u8 connections;
+};
+
+static const struct BenchWarp sBenchWarpRoute[] = {
+    {"house",        16,  12, 0},
+    {"town",         24,  20, 2},
+    {"route",        24,  80, 2},
+    {"city",         48,  40, 4},
+    {"custom wide", 110,  60, 4},
+    {"custom tall",  40, 150, 2},
+};
+
+#define BENCH_WARP_REPEATS 50
+#define BENCH_WARP_MAX_STEPS 64
+// Stands in for the part of a frame CB2_LoadMap2 may fill on hardware, about
+// four 4 KiB tileset steps, at host speed.
+#define BENCH_WARP_DEFAULT_BUDGET_US 40
+
+static const u8 sBenchWarpDirections[] = {CONNECTION_NORTH, CONNECTION_SOUTH, CONNECTION_WEST, CONNECTION_EAST};
+
+static int RunWarpRoute(double budget)
+{
+    static u8 primaryRaw[NUM_TILES_IN_PRIMARY * TILE_SIZE_4BPP];
+    static u8 secondaryRaw[(NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY) * TILE_SIZE_4BPP];
+    static u32 primaryData[(BENCH_LZ_MAX_SIZE(sizeof(primaryRaw)) + 3) / 4];
+    static u32 secondaryData[(BENCH_LZ_MAX_SIZE(sizeof(secondaryRaw)) + 3) / 4];
+    static struct Tileset primary, secondary;
+    static struct MapLayout layout;
+    static struct MapConnection connections[NELEMS(sBenchWarpDirections)];
+    static struct MapConnections mapConnections;
+    double stepTimes[BENCH_WARP_MAX_STEPS];
+    u16 *blocks;
+    u32 i, j, rep, steps, frames;
+
+    SeedRng(0x9ABC);
+    MakeBenchTiles(primaryRaw, sizeof(primaryRaw));
+    MakeBenchTiles(secondaryRaw, sizeof(secondaryRaw));
+    CompressBenchLZ(primaryRaw, sizeof(primaryRaw), (u8 *)primaryData);
+    CompressBenchLZ(secondaryRaw, sizeof(secondaryRaw), (u8 *)secondaryData);
+    primary.isCompressed = TRUE;
+    primary.tiles = primaryData;
+    primary.numMetatiles = NUM_METATILES_IN_PRIMARY;
+    primary.metatileAttributes = sBenchMetatileAttributes;
+    secondary.isCompressed = TRUE;
+    secondary.isSecondary = TRUE;
+    secondary.numMetatiles = NUM_METATILES_TOTAL - NUM_METATILES_IN_PRIMARY;
+    secondary.tiles = secondaryData;
+    secondary.metatileAttributes = sBenchMetatileAttributes + NUM_METATILES_IN_PRIMARY;
+    for (i = 0; i < NELEMS(connections); i++)
+        connections[i].direction = sBenchWarpDirections[i];
+
+    printf("frame budget %.1f us\n", budget * 1e6);
+    printf("%-14s %9s %11s %12s %7s %7s %16s\n", "map", "size", "connections", "one go (us)", "steps", "frames", "max frame (us)");
+    for (i = 0; i < NELEMS(sBenchWarpRoute); i++)
+    {
+        const struct BenchWarp *warp = &sBenchWarpRoute[i];
+        double best = 1e9, start, longest, frame;
+
+        blocks = malloc(warp->width * warp->height * sizeof(u16));
+        for (j = 0; j < (u32)warp->width * warp->height; j++)
+            blocks[j] = Random() % NUM_METATILES_TOTAL;
+        layout.width = warp->width;
+        layout.height = warp->height;
+        layout.map = blocks;
+        layout.border = sBenchBorder;
+        layout.primaryTileset = &primary;
+        layout.secondaryTileset = &secondary;
+        mapConnections.count = warp->connections;
+        mapConnections.connections = connections;
+        gMapHeader.mapLayout = &layout;
+        gMapHeader.connections = &mapConnections;
+
+        for (rep = 0; rep < BENCH_WARP_REPEATS; rep++)
+        {
+            start = GetSeconds();
+            StartLoadMapLayout();
+            while (!LoadMapLayoutStep())
+                ;
+            StartCopyMapTilesetsToVram(&layout);
+            while (!CopyMapTilesetsToVramStep())
+                ;
+            best = min(best, GetSeconds() - start);
+        }
+
+        for (j = 0; j < BENCH_WARP_MAX_STEPS; j++)
+            stepTimes[j] = 1e9;
+        for (rep = 0; rep < BENCH_WARP_REPEATS; rep++)
+        {
+            bool8 done = FALSE;
+
+            steps = 0;
+            StartLoadMapLayout();
+            StartCopyMapTilesetsToVram(&layout);
+            while (!done && steps < BENCH_WARP_MAX_STEPS)
+            {
+                start = GetSeconds();
+                done = LoadMapLayoutStep();
+                stepTimes[steps] = min(stepTimes[steps], GetSeconds() - start);
+                steps++;
+            }
+            done = FALSE;
+            while (!done && steps < BENCH_WARP_MAX_STEPS)
+            {
+                start = GetSeconds();
+                done = CopyMapTilesetsToVramStep();
+                stepTimes[steps] = min(stepTimes[steps], GetSeconds() - start);
+                steps++;
+            }
+        }
+        longest = 0;
+        frames = 0;
+        frame = 0;
+        for (j = 0; j < steps; j++)
+        {
+            frame += stepTimes[j];
+            if (frame >= budget || j == steps - 1)
+            {
+                longest = max(longest, frame);
+                frames++;
+                frame = 0;
+            }
+        }
+
+        printf("%-14s %4ux%-4u %11u %12.1f %7u %7u %16.1f\n",
+               warp->name, warp->width, warp->height, warp->connections,
+               best * 1e6, steps, frames, longest * 1e6);
+        free(blocks);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    u32 iterations = 1000000;
+    u32 i;
+    int arg;
+    int filtered = 0;
+
+    if (argc > 1 && strcmp(argv[1], "-lz") == 0)
+        return CheckLZFiles(argc - 2, argv + 2);
+    if (argc > 1 && strcmp(argv[1], "-check") == 0)
+        return RunHostChecks(argc - 2, argv + 2) != 0;
+    if (argc > 1 && strcmp(argv[1], "-ai") == 0)
+    {
+        if (argc != 4)
+            Usage(argv[0]);
+        return CheckAIScripts(argv[2], argv[3]);
+    }
+    if (argc > 1 && strcmp(argv[1], "-warps") == 0)
+    {
+        double budget = BENCH_WARP_DEFAULT_BUDGET_US;
+
+        if (argc > 3)
+            Usage(argv[0]);
+        if (argc == 3)
+            budget = strtod(argv[2], NULL);
+        if (!(budget > 0))
+            Usage(argv[0]);
+        InitBenchMap();
+        return RunWarpRoute(budget / 1e6);
+    }
+
+    for (arg = 1; arg < argc && argv[arg][0] == '-'; arg++)
+    {
+        if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc)
+            iterations = strtoul(argv[++arg], NULL, 0);
+        else
+            Usage(argv[0]);
+    }
+    filtered = arg < argc;
+
+    InitBenchMons();
+    InitBenchMap();
+    InitBenchSound();
+    InitBenchLZ();
+    printf("%-30s %12s %10s %10s %10s\n", "benchmark", "iterations", "ns/op", "Mops/s", "checksum");
+    for (i = 0; i < NELEMS(sBenchmarks); i++)
+    {
+        const struct Benchmark *bench = &sBenchmarks[i];
+        double start, elapsed;
+        u32 sum;
+        int j;
+
+        if (filtered)
+        {
+            for (j = arg; j < argc; j++)
+            {
+                if (strcmp(argv[j], bench->name) == 0)
+                    break;
+            }
+            if (j == argc)
+                continue;
+        }
+
+        SeedRng(0x1234);
+        start = GetSeconds();
+        sum = bench->func(iterations);
+        elapsed = GetSeconds() - start;
+        printf("%-30s %12u %10.1f %10.2f   %08x\n",
+               bench->name,
+               iterations,
+               elapsed * 1e9 / iterations,
+               iterations / elapsed / 1e6,
+               sum);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "global.h"
+
+// BIOS calls, following the control word layout in include/gba/syscall.h.
+void CpuSet(const void *src, void *dest, u32 control)
+{
+    u32 count = control & 0x1FFFFF;
+    bool32 fill = (control & CPU_SET_SRC_FIXED) != 0;
+    u32 i;
+
+    if (control & CPU_SET_32BIT)
+    {
+        for (i = 0; i < count; i++)
+            ((u32 *)dest)[i] = fill ? *(const u32 *)src : ((const u32 *)src)[i];
+    }
+    else
+    {
+        for (i = 0; i < count; i++)
+            ((u16 *)dest)[i] = fill ? *(const u16 *)src : ((const u16 *)src)[i];
+    }
+}
+
+void CpuFastSet(const void *src, void *dest, u32 control)
+{
+    u32 count = ((control & 0x1FFFFF) + 7) & ~7;
+
+    CpuSet(src, dest, count | CPU_SET_32BIT | (control & CPU_SET_SRC_FIXED));
+}
+
+// The two differ only in whether VRAM sees byte writes, which doesn't
+// matter here.
+void LZ77UnCompWram(const void *src, void *dest)
+{
+    const u8 *in = src;
+    u8 *out = dest;
+    u8 *end = out + (in[1] | (in[2] << 8) | (in[3] << 16));
+    u8 flags;
+    s32 i;
+
+    in += 4;
+    while (out < end)
+    {
+        flags = *in++;
+        for (i = 0; i < 8 && out < end; i++, flags <<= 1)
+        {
+            if (flags & 0x80)
+            {
+                u32 length = (in[0] >> 4) + 3;
+                u32 offset = (((in[0] & 0xF) << 8) | in[1]) + 1;
+
+                in += 2;
+                for (; length != 0 && out < end; length--, out++)
+                    *out = *(out - offset);
+            }
+            else
+            {
+                *out++ = *in++;
+            }
+        }
+    }
+}
+
+void LZ77UnCompVram(const void *src, void *dest)
+{
+    LZ77UnCompWram(src, dest);
+}
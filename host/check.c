@@ -0,0 +1,987 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "global.h"
+#include "battle.h"
+#include "battle_ai_script_commands.h"
+#include "easy_chat.h"
+#include "gba/m4a_internal.h"
+#include "m4a_mixer.h"
+#include "pokemon.h"
+#include "random.h"
+#include "string_util.h"
+#include "strings.h"
+#include "task.h"
+#include "util.h"
+#include "constants/abilities.h"
+#include "constants/battle_ai.h"
+#include "constants/easy_chat.h"
+#include "constants/hold_effects.h"
+#include "constants/items.h"
+#include "constants/moves.h"
+#include "constants/species.h"
+#include "check.h"
+
+// Equivalence checks for engine code that was rewritten for speed. Each one
+// runs the current code and a copy of the code it replaced over the same
+// inputs and prints the first CHECK_MAX_REPORTS inputs on which they
+// disagree. The replaced code is kept here, and only here, as the reference.
+
+#define CHECK_MAX_REPORTS 8
+#define CHECK_BUFFER_SIZE 0x4000
+#define CHECK_BUFFER_RUNS 20000
+#define CHECK_SOUND_FRAME_LENGTH 0xE0 // 13379 Hz, the game's mixing rate
+#define CHECK_SOUND_DMA_PERIOD 7
+#define CHECK_SOUND_FRAMES 4000
+#define CHECK_TASK_SCRIPTS 2000
+#define CHECK_TASK_OPS 400
+#define CHECK_TASK_LOG_SIZE 0x4000
+#define CHECK_TASK_HEAD 0xFE // task.c's list sentinels
+#define CHECK_TASK_TAIL 0xFF
+#define CHECK_AI_STATES 20000
+#define CHECK_AI_SCRIPTS 32 // one per bit of aiFlags
+#define CHECK_ROM_ADDR 0x08000000
+#define CHECK_ROM_MAX_SIZE 0x2000000
+
+struct HostCheck
+{
+    const char *name;
+    u32 (*func)(void); // returns the number of mismatches
+};
+
+#include "../src/data/easy_chat/easy_chat_groups.h"
+
+// IsECWordInvalid as it was before it looked words of the Pokémon and move
+// groups up in easy_chat_tables.py's bitmaps: a scan of the group's first
+// numWords values.
+static bool8 IsECWordInvalid_Scan(u16 easyChatWord)
+{
+    u16 i;
+    u8 groupId;
+    u32 index;
+    u16 numWords;
+    const u16 *list;
+
+    if (easyChatWord == EC_WORD_UNDEFINED)
+        return FALSE;
+
+    groupId = EC_GROUP(easyChatWord);
+    index = EC_INDEX(easyChatWord);
+    if (groupId >= EC_NUM_GROUPS)
+        return TRUE;
+
+    numWords = sEasyChatGroups[groupId].numWords;
+    switch (groupId)
+    {
+    case EC_GROUP_POKEMON:
+    case EC_GROUP_POKEMON_2:
+    case EC_GROUP_MOVE_1:
+    case EC_GROUP_MOVE_2:
+        list = sEasyChatGroups[groupId].wordData.valueList;
+        for (i = 0; i < numWords; i++)
+        {
+            if (index == list[i])
+                return FALSE;
+        }
+        return TRUE;
+    default:
+        return index >= numWords;
+    }
+}
+
+// IsECWordInvalid is static, so it is observed through CopyEasyChatWord,
+// which copies gText_ThreeQuestionMarks for invalid words. No valid word
+// copies that: species and move names are empty in this build, and the other
+// groups' words aren't encoded for the game's charmap.
+static u32 Check_IsECWordInvalid(void)
+{
+    u32 word;
+    u32 mismatches = 0;
+    u8 buffer[64];
+
+    for (word = 0; word <= 0xFFFF; word++)
+    {
+        bool8 expected = IsECWordInvalid_Scan(word);
+        bool8 actual;
+
+        CopyEasyChatWord(buffer, word);
+        actual = StringCompare(buffer, gText_ThreeQuestionMarks) == 0;
+        if (actual != expected && ++mismatches <= CHECK_MAX_REPORTS)
+            fprintf(stderr, "IsECWordInvalid: word 0x%04x is %s, expected %s\n", word,
+                    actual ? "invalid" : "valid", expected ? "invalid" : "valid");
+    }
+    return mismatches;
+}
+
+// CalcCRC16, CalcCRC16WithTable and CalcByteArraySum as they were before
+// they went a word at a time.
+static u16 CalcCRC16_Bitwise(const u8 *data, u32 length)
+{
+    u16 i, j;
+    u16 crc = 0x1121;
+
+    for (i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (j = 0; j < 8; j++)
+        {
+            if (crc & 1)
+                crc = (crc >> 1) ^ 0x8408;
+            else
+                crc >>= 1;
+        }
+    }
+    return ~crc;
+}
+
+// util.c's gCrc16Table is static; this is the same table, built from the
+// polynomial rather than copied.
+static u16 sCheckCrc16Table[256];
+
+static void InitCheckCrc16Table(void)
+{
+    u32 i, j;
+
+    for (i = 0; i < 256; i++)
+    {
+        u16 crc = i;
+
+        for (j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+        sCheckCrc16Table[i] = crc;
+    }
+}
+
+static u16 CalcCRC16WithTable_Bytewise(const u8 *data, u32 length)
+{
+    u16 i;
+    u16 crc = 0x1121;
+    u8 byte;
+
+    for (i = 0; i < length; i++)
+    {
+        byte = crc >> 8;
+        crc ^= data[i];
+        crc = byte ^ sCheckCrc16Table[(u8)crc];
+    }
+    return ~crc;
+}
+
+static u32 CalcByteArraySum_Bytewise(const u8 *array, u32 size)
+{
+    s32 i;
+    u32 result = 0;
+
+    for (i = 0; i < size; i++)
+        result += array[i];
+    return result;
+}
+
+// Random bytes, except that one run in eight is all 0xFF, the worst case for
+// the lanes CalcByteArraySum sums words in.
+static void FillCheckBuffer(u8 *buffer, u32 run)
+{
+    u32 i;
+
+    for (i = 0; i < CHECK_BUFFER_SIZE + 4; i++)
+        buffer[i] = (run % 8 == 7) ? 0xFF : Random();
+}
+
+// Picks the start and length of a run: every start alignment with every
+// length up to 64 first, then random starts and lengths, mostly short and
+// sometimes up to the whole buffer. Lengths stay below 0x10000, as the old
+// loops' u16 counters would never end otherwise.
+static void PickCheckRun(u32 run, u32 *start, u32 *length)
+{
+    if (run < 4 * 65)
+    {
+        *start = run % 4;
+        *length = run / 4;
+    }
+    else
+    {
+        *start = Random() % 4;
+        *length = (Random() % 4 == 0) ? Random() % CHECK_BUFFER_SIZE : Random() % 256;
+    }
+}
+
+static u32 CheckBufferFunc(const char *name, u32 (*func)(const u8 *, u32), u32 (*reference)(const u8 *, u32))
+{
+    static u32 buffer[(CHECK_BUFFER_SIZE + 4) / 4];
+    u8 *bytes = (u8 *)buffer;
+    u32 run, start, length;
+    u32 mismatches = 0;
+
+    SeedRng(0x2468);
+    for (run = 0; run < CHECK_BUFFER_RUNS; run++)
+    {
+        u32 expected, actual;
+
+        if (run % 64 == 0 || run % 8 == 7)
+            FillCheckBuffer(bytes, run);
+        PickCheckRun(run, &start, &length);
+        expected = reference(bytes + start, length);
+        actual = func(bytes + start, length);
+        if (actual != expected && ++mismatches <= CHECK_MAX_REPORTS)
+            fprintf(stderr, "%s: %u bytes at +%u gave 0x%x, expected 0x%x\n", name, length, start, actual, expected);
+    }
+    return mismatches;
+}
+
+static u32 CalcCRC16_u32(const u8 *data, u32 length)
+{
+    return CalcCRC16(data, length);
+}
+
+static u32 CalcCRC16_Bitwise_u32(const u8 *data, u32 length)
+{
+    return CalcCRC16_Bitwise(data, length);
+}
+
+static u32 CalcCRC16WithTable_u32(const u8 *data, u32 length)
+{
+    return CalcCRC16WithTable(data, length);
+}
+
+static u32 CalcCRC16WithTable_Bytewise_u32(const u8 *data, u32 length)
+{
+    return CalcCRC16WithTable_Bytewise(data, length);
+}
+
+static u32 Check_CalcCRC16(void)
+{
+    return CheckBufferFunc("CalcCRC16", CalcCRC16_u32, CalcCRC16_Bitwise_u32);
+}
+
+static u32 Check_CalcCRC16WithTable(void)
+{
+    InitCheckCrc16Table();
+    return CheckBufferFunc("CalcCRC16WithTable", CalcCRC16WithTable_u32, CalcCRC16WithTable_Bytewise_u32);
+}
+
+static u32 Check_CalcByteArraySum(void)
+{
+    return CheckBufferFunc("CalcByteArraySum", CalcByteArraySum, CalcByteArraySum_Bytewise);
+}
+
+// The downsampler model as it was before it had a loop for reverb level 0:
+// the feedback is always read back and multiplied, by 0 if need be.
+static u32 DownsampleSample_Reference(u32 acc, u32 *noiseShape)
+{
+    u32 doubled = acc + acc;
+
+    if ((s32)(acc ^ doubled) < 0)
+        acc = 0xC0000000 ^ (u32)((s32)doubled >> 31);
+    *noiseShape = acc & 0x007F0000;
+    return (acc >> 15) & 0xFF00;
+}
+
+static void SoundMainDownsample_Reference(struct SoundInfo *soundInfo, u32 *hqBuffer, s8 *bufferPos, s32 frameLength, u8 bufferPosIndexHint)
+{
+    u32 noiseLeft = soundInfo->gap[1] << 16;
+    u32 noiseRight = soundInfo->gap[2] << 16;
+    u32 reverb = soundInfo->reverb >> 2;
+    s32 readOffset;
+    s32 remaining;
+
+    reverb |= reverb << 16;
+    if (bufferPosIndexHint != 2)
+        readOffset = frameLength;
+    else
+        readOffset = soundInfo->pcmBuffer - bufferPos;
+
+    for (remaining = frameLength; remaining > 0; remaining -= 2)
+    {
+        u32 left, right, sample;
+        s32 feedback0, feedback1;
+        s16 pair;
+
+        left = DownsampleSample_Reference(noiseLeft + hqBuffer[0], &noiseLeft);
+        right = DownsampleSample_Reference(noiseRight + (hqBuffer[0] << 16), &noiseRight);
+        sample = DownsampleSample_Reference(noiseLeft + hqBuffer[1], &noiseLeft);
+        left = sample | (left >> 8);
+        sample = DownsampleSample_Reference(noiseRight + (hqBuffer[1] << 16), &noiseRight);
+        right = sample | (right >> 8);
+
+        memcpy(&pair, bufferPos + readOffset, 2);
+        feedback1 = pair >> 8;
+        feedback0 = (s8)pair;
+        memcpy(&pair, bufferPos + readOffset + PCM_DMA_BUF_SIZE, 2);
+        feedback1 += pair >> 8;
+        feedback0 += (s8)pair;
+        memcpy(&pair, bufferPos + PCM_DMA_BUF_SIZE, 2);
+        feedback1 += pair >> 8;
+        feedback0 += (s8)pair;
+        pair = left;
+        memcpy(bufferPos + PCM_DMA_BUF_SIZE, &pair, 2);
+        memcpy(&pair, bufferPos, 2);
+        feedback1 += pair >> 8;
+        feedback0 += (s8)pair;
+        pair = right;
+        memcpy(bufferPos, &pair, 2);
+        hqBuffer[0] = reverb * (u32)feedback0;
+        hqBuffer[1] = reverb * (u32)feedback1;
+        bufferPos += 2;
+        hqBuffer += 2;
+    }
+
+    soundInfo->gap[1] = noiseLeft >> 16;
+    soundInfo->gap[2] = noiseRight >> 16;
+}
+
+// Plays CHECK_SOUND_FRAMES frames through the downsampler model, with songs
+// of different reverb levels one after the other, and records the SoundInfo
+// and hq_buffer_ptr at the start of every frame. From each recorded state the
+// reference and the current model are run side by side and must leave the
+// same PCM buffers, hq_buffer_ptr and noise shaping. The states carry what a
+// zeroed SoundInfo doesn't: PCM buffers full of earlier output, noise shaping
+// left over, feedback still in hq_buffer_ptr when the reverb is turned off,
+// and the buffer position wrapping on the last DMA period.
+//
+// This checks the C model only. The ARM code in m4a_1.s is not run here, so
+// it is unchecked by this.
+static u32 Check_SoundMainDownsample(void)
+{
+    static const u8 sSongReverbs[] = {0, 0x50, 0, 0x7F, 0x04, 0, 0x01, 0x7F, 0};
+    static struct SoundInfo recorded, reference;
+    static u32 recordedHq[CHECK_SOUND_FRAME_LENGTH], referenceHq[CHECK_SOUND_FRAME_LENGTH];
+    u32 frame, i, chan;
+    u32 mismatches = 0;
+    u8 dmaCounter = CHECK_SOUND_DMA_PERIOD;
+
+    SeedRng(0x1357);
+    memset(&recorded, 0, sizeof(recorded));
+    memset(recordedHq, 0, sizeof(recordedHq));
+    for (frame = 0; frame < CHECK_SOUND_FRAMES; frame++)
+    {
+        s32 bufferOffset = 0;
+
+        // A new song every so often, with its own reverb level.
+        recorded.reverb = sSongReverbs[(frame / 300) % NELEMS(sSongReverbs)];
+
+        // What the channel mixer adds on top of last frame's feedback: a
+        // few channels at random volumes, loud enough to clip at times.
+        for (chan = 0; chan < 4; chan++)
+        {
+            s32 leftVolume = Random() % 128;
+            s32 rightVolume = Random() % 128;
+            u32 phase = Random();
+            u32 step = (Random() % 0x800) + 0x40;
+
+            for (i = 0; i < CHECK_SOUND_FRAME_LENGTH; i++, phase += step)
+            {
+                s32 sample = (s8)(phase >> 8);
+
+                recordedHq[i] += ((u32)(sample * leftVolume) << 8) + (u32)(sample * rightVolume);
+            }
+        }
+
+        // As SoundMain picks the buffer position from pcmDmaCounter.
+        if (dmaCounter > 1)
+            bufferOffset = CHECK_SOUND_FRAME_LENGTH * (CHECK_SOUND_DMA_PERIOD - (dmaCounter - 1));
+
+        reference = recorded;
+        memcpy(referenceHq, recordedHq, sizeof(recordedHq));
+        SoundMainDownsample_Reference(&reference, referenceHq, reference.pcmBuffer + bufferOffset, CHECK_SOUND_FRAME_LENGTH, dmaCounter);
+        HostSoundMainDownsample(&recorded, recordedHq, recorded.pcmBuffer + bufferOffset, CHECK_SOUND_FRAME_LENGTH, dmaCounter, TRUE);
+
+        if ((memcmp(recorded.pcmBuffer, reference.pcmBuffer, sizeof(recorded.pcmBuffer)) != 0
+          || memcmp(recordedHq, referenceHq, sizeof(recordedHq)) != 0
+          || recorded.gap[1] != reference.gap[1]
+          || recorded.gap[2] != reference.gap[2])
+         && ++mismatches <= CHECK_MAX_REPORTS)
+            fprintf(stderr, "SoundMainDownsample: frame %u (reverb 0x%02x, dma counter %u) differs\n", frame, recorded.reverb, dmaCounter);
+
+        if (--dmaCounter == 0)
+            dmaCounter = CHECK_SOUND_DMA_PERIOD;
+    }
+    return mismatches;
+}
+
+// The task list as it was before CreateTask found its place by priority
+// bitmap: a walk from the first task for the first higher priority value,
+// and scans of every slot for the head, the count and func lookups. It runs
+// on its own copy of the task array.
+static struct Task sRefTasks[NUM_TASKS];
+
+static void RefResetTasks(void)
+{
+    u8 i;
+
+    for (i = 0; i < NUM_TASKS; i++)
+    {
+        sRefTasks[i].isActive = FALSE;
+        sRefTasks[i].func = TaskDummy;
+        sRefTasks[i].prev = i;
+        sRefTasks[i].next = i + 1;
+        sRefTasks[i].priority = -1;
+        memset(sRefTasks[i].data, 0, sizeof(sRefTasks[i].data));
+    }
+    sRefTasks[0].prev = CHECK_TASK_HEAD;
+    sRefTasks[NUM_TASKS - 1].next = CHECK_TASK_TAIL;
+}
+
+static u8 RefFindFirstActiveTask(void)
+{
+    u8 taskId;
+
+    for (taskId = 0; taskId < NUM_TASKS; taskId++)
+        if (sRefTasks[taskId].isActive == TRUE && sRefTasks[taskId].prev == CHECK_TASK_HEAD)
+            break;
+    return taskId;
+}
+
+static void RefInsertTask(u8 newTaskId)
+{
+    u8 taskId = RefFindFirstActiveTask();
+
+    if (taskId == NUM_TASKS)
+    {
+        sRefTasks[newTaskId].prev = CHECK_TASK_HEAD;
+        sRefTasks[newTaskId].next = CHECK_TASK_TAIL;
+        return;
+    }
+
+    while (1)
+    {
+        if (sRefTasks[newTaskId].priority < sRefTasks[taskId].priority)
+        {
+            sRefTasks[newTaskId].prev = sRefTasks[taskId].prev;
+            sRefTasks[newTaskId].next = taskId;
+            if (sRefTasks[taskId].prev != CHECK_TASK_HEAD)
+                sRefTasks[sRefTasks[taskId].prev].next = newTaskId;
+            sRefTasks[taskId].prev = newTaskId;
+            return;
+        }
+        if (sRefTasks[taskId].next == CHECK_TASK_TAIL)
+        {
+            sRefTasks[newTaskId].prev = taskId;
+            sRefTasks[newTaskId].next = sRefTasks[taskId].next;
+            sRefTasks[taskId].next = newTaskId;
+            return;
+        }
+        taskId = sRefTasks[taskId].next;
+    }
+}
+
+static u8 RefCreateTask(TaskFunc func, u8 priority)
+{
+    u8 i;
+
+    for (i = 0; i < NUM_TASKS; i++)
+    {
+        if (!sRefTasks[i].isActive)
+        {
+            sRefTasks[i].func = func;
+            sRefTasks[i].priority = priority;
+            RefInsertTask(i);
+            memset(sRefTasks[i].data, 0, sizeof(sRefTasks[i].data));
+            sRefTasks[i].isActive = TRUE;
+            return i;
+        }
+    }
+    return 0;
+}
+
+static void RefDestroyTask(u8 taskId)
+{
+    if (sRefTasks[taskId].isActive)
+    {
+        sRefTasks[taskId].isActive = FALSE;
+
+        if (sRefTasks[taskId].prev == CHECK_TASK_HEAD)
+        {
+            if (sRefTasks[taskId].next != CHECK_TASK_TAIL)
+                sRefTasks[sRefTasks[taskId].next].prev = CHECK_TASK_HEAD;
+        }
+        else
+        {
+            if (sRefTasks[taskId].next == CHECK_TASK_TAIL)
+            {
+                sRefTasks[sRefTasks[taskId].prev].next = CHECK_TASK_TAIL;
+            }
+            else
+            {
+                sRefTasks[sRefTasks[taskId].prev].next = sRefTasks[taskId].next;
+                sRefTasks[sRefTasks[taskId].next].prev = sRefTasks[taskId].prev;
+            }
+        }
+    }
+}
+
+static void RefRunTasks(void)
+{
+    u8 taskId = RefFindFirstActiveTask();
+
+    if (taskId != NUM_TASKS)
+    {
+        do
+        {
+            sRefTasks[taskId].func(taskId);
+            taskId = sRefTasks[taskId].next;
+        } while (taskId != CHECK_TASK_TAIL);
+    }
+}
+
+static u8 RefFindTaskIdByFunc(TaskFunc func)
+{
+    s32 i;
+
+    for (i = 0; i < NUM_TASKS; i++)
+        if (sRefTasks[i].isActive == TRUE && sRefTasks[i].func == func)
+            return (u8)i;
+    return -1;
+}
+
+static bool8 RefFuncIsActiveTask(TaskFunc func)
+{
+    return RefFindTaskIdByFunc(func) != 0xFF;
+}
+
+static u8 RefGetTaskCount(void)
+{
+    u8 i;
+    u8 count = 0;
+
+    for (i = 0; i < NUM_TASKS; i++)
+        if (sRefTasks[i].isActive == TRUE)
+            count++;
+    return count;
+}
+
+// Both task lists are driven by the same random script of operations. At
+// the top level an operation creates, destroys, runs the tasks or queries
+// them; each task that runs takes the next one as what it does from inside
+// RunTasks: nothing, create, destroy another task or itself, or switch its
+// func. Every result and every task run goes into a log per list, and the
+// two logs must be the same.
+enum
+{
+    CHECK_TASK_OP_NONE,
+    CHECK_TASK_OP_CREATE,
+    CHECK_TASK_OP_DESTROY,
+    CHECK_TASK_OP_DESTROY_SELF,
+    CHECK_TASK_OP_SWITCH_FUNC,
+    CHECK_TASK_OP_RUN,
+    CHECK_TASK_OP_QUERY,
+};
+
+struct CheckTaskOp
+{
+    u8 kind;
+    u8 func;
+    u8 priority;
+    u8 taskId;
+};
+
+struct CheckTaskList
+{
+    struct Task *tasks;
+    void (*reset)(void);
+    u8 (*create)(TaskFunc func, u8 priority);
+    void (*destroy)(u8 taskId);
+    void (*run)(void);
+    u8 (*findByFunc)(TaskFunc func);
+    bool8 (*isActive)(TaskFunc func);
+    u8 (*count)(void);
+    u32 opPos;
+    u32 logLength;
+    u8 log[CHECK_TASK_LOG_SIZE];
+};
+
+static struct CheckTaskOp sCheckTaskOps[CHECK_TASK_OPS * 4];
+static struct CheckTaskList *sCheckTaskList;
+
+static void CheckTaskFunc0(u8 taskId);
+static void CheckTaskFunc1(u8 taskId);
+static void CheckTaskFunc2(u8 taskId);
+static void CheckTaskFunc3(u8 taskId);
+
+static const TaskFunc sCheckTaskFuncs[] = {CheckTaskFunc0, CheckTaskFunc1, CheckTaskFunc2, CheckTaskFunc3};
+
+static void LogCheckTask(u8 value)
+{
+    if (sCheckTaskList->logLength < CHECK_TASK_LOG_SIZE)
+        sCheckTaskList->log[sCheckTaskList->logLength++] = value;
+}
+
+static void RunCheckTaskFunc(u8 taskId, u8 funcIndex)
+{
+    struct CheckTaskList *list = sCheckTaskList;
+    const struct CheckTaskOp *op = &sCheckTaskOps[list->opPos++ % NELEMS(sCheckTaskOps)];
+
+    LogCheckTask(taskId);
+    LogCheckTask(funcIndex);
+    switch (op->kind)
+    {
+    case CHECK_TASK_OP_CREATE:
+        LogCheckTask(list->create(sCheckTaskFuncs[op->func], op->priority));
+        break;
+    case CHECK_TASK_OP_DESTROY:
+        list->destroy(op->taskId);
+        break;
+    case CHECK_TASK_OP_DESTROY_SELF:
+        list->destroy(taskId);
+        break;
+    case CHECK_TASK_OP_SWITCH_FUNC:
+        list->tasks[taskId].func = sCheckTaskFuncs[op->func];
+        break;
+    }
+}
+
+static void CheckTaskFunc0(u8 taskId)
+{
+    RunCheckTaskFunc(taskId, 0);
+}
+
+static void CheckTaskFunc1(u8 taskId)
+{
+    RunCheckTaskFunc(taskId, 1);
+}
+
+static void CheckTaskFunc2(u8 taskId)
+{
+    RunCheckTaskFunc(taskId, 2);
+}
+
+static void CheckTaskFunc3(u8 taskId)
+{
+    RunCheckTaskFunc(taskId, 3);
+}
+
+static void RunCheckTaskScript(struct CheckTaskList *list)
+{
+    u32 i, j;
+
+    sCheckTaskList = list;
+    list->opPos = 0;
+    list->logLength = 0;
+    list->reset();
+    for (i = 0; i < CHECK_TASK_OPS; i++)
+    {
+        const struct CheckTaskOp *op = &sCheckTaskOps[list->opPos++ % NELEMS(sCheckTaskOps)];
+
+        switch (op->kind)
+        {
+        case CHECK_TASK_OP_CREATE:
+        case CHECK_TASK_OP_SWITCH_FUNC:
+            LogCheckTask(list->create(sCheckTaskFuncs[op->func], op->priority));
+            break;
+        case CHECK_TASK_OP_DESTROY:
+        case CHECK_TASK_OP_DESTROY_SELF:
+            list->destroy(op->taskId);
+            break;
+        case CHECK_TASK_OP_RUN:
+        case CHECK_TASK_OP_NONE:
+            LogCheckTask(0xFD);
+            list->run();
+            break;
+        case CHECK_TASK_OP_QUERY:
+            for (j = 0; j < NELEMS(sCheckTaskFuncs); j++)
+            {
+                LogCheckTask(list->findByFunc(sCheckTaskFuncs[j]));
+                LogCheckTask(list->isActive(sCheckTaskFuncs[j]));
+            }
+            LogCheckTask(list->count());
+            break;
+        }
+    }
+}
+
+// A mix of operations, with priorities from a handful of values so that
+// ties are common, or from the whole range.
+static void MakeCheckTaskScript(u32 script)
+{
+    static const u8 sKinds[] = {
+        CHECK_TASK_OP_NONE, CHECK_TASK_OP_NONE, CHECK_TASK_OP_NONE,
+        CHECK_TASK_OP_CREATE, CHECK_TASK_OP_CREATE, CHECK_TASK_OP_CREATE,
+        CHECK_TASK_OP_DESTROY, CHECK_TASK_OP_DESTROY,
+        CHECK_TASK_OP_DESTROY_SELF, CHECK_TASK_OP_SWITCH_FUNC,
+        CHECK_TASK_OP_RUN, CHECK_TASK_OP_QUERY,
+    };
+    u32 i;
+
+    for (i = 0; i < NELEMS(sCheckTaskOps); i++)
+    {
+        sCheckTaskOps[i].kind = sKinds[Random() % NELEMS(sKinds)];
+        sCheckTaskOps[i].func = Random() % NELEMS(sCheckTaskFuncs);
+        sCheckTaskOps[i].priority = (script % 2) ? Random() % 4 * 40 : Random() % 256;
+        sCheckTaskOps[i].taskId = Random() % NUM_TASKS;
+    }
+}
+
+static u32 Check_TaskList(void)
+{
+    static struct CheckTaskList game = {gTasks, ResetTasks, CreateTask, DestroyTask, RunTasks, FindTaskIdByFunc, FuncIsActiveTask, GetTaskCount};
+    static struct CheckTaskList reference = {sRefTasks, RefResetTasks, RefCreateTask, RefDestroyTask, RefRunTasks, RefFindTaskIdByFunc, RefFuncIsActiveTask, RefGetTaskCount};
+    u32 script;
+    u32 mismatches = 0;
+
+    SeedRng(0x3579);
+    for (script = 0; script < CHECK_TASK_SCRIPTS; script++)
+    {
+        MakeCheckTaskScript(script);
+        RunCheckTaskScript(&reference);
+        RunCheckTaskScript(&game);
+        if ((game.logLength != reference.logLength || memcmp(game.log, reference.log, game.logLength) != 0)
+         && ++mismatches <= CHECK_MAX_REPORTS)
+            fprintf(stderr, "TaskList: script %u differs\n", script);
+    }
+    return mismatches;
+}
+
+static const struct HostCheck sHostChecks[] =
+{
+    {"IsECWordInvalid",     Check_IsECWordInvalid},
+    {"CalcCRC16",           Check_CalcCRC16},
+    {"CalcCRC16WithTable",  Check_CalcCRC16WithTable},
+    {"CalcByteArraySum",    Check_CalcByteArraySum},
+    {"SoundMainDownsample", Check_SoundMainDownsample},
+    {"TaskList",            Check_TaskList},
+};
+
+int RunHostChecks(int count, char **names)
+{
+    u32 i;
+    int j;
+    int failed = 0;
+
+    for (i = 0; i < NELEMS(sHostChecks); i++)
+    {
+        const struct HostCheck *check = &sHostChecks[i];
+        u32 mismatches;
+
+        for (j = 0; j < count; j++)
+        {
+            if (strcmp(names[j], check->name) == 0)
+                break;
+        }
+        if (count != 0 && j == count)
+            continue;
+
+        mismatches = check->func();
+        printf("%-30s %s", check->name, mismatches == 0 ? "ok" : "FAILED");
+        if (mismatches != 0)
+            printf(" (%u mismatches)", mismatches);
+        printf("\n");
+        if (mismatches != 0)
+            failed++;
+    }
+    return failed;
+}
+
+// The AI scripts can't be assembled here, so CheckAIScripts takes both forms
+// from a ROM build: the ROM image is mapped where the GBA has it, which makes
+// the 32-bit pointers in the scripts valid as they are, and the two tables
+// below are filled in from the ones the map file locates.
+u8 *gBattleAI_ScriptsTable[CHECK_AI_SCRIPTS];
+u8 *gBattleAI_CompiledScriptsTable[CHECK_AI_SCRIPTS];
+
+static bool8 FindMapSymbol(const char *mapPath, const char *name, u32 *address)
+{
+    FILE *fp = fopen(mapPath, "r");
+    char line[1024];
+    char symbol[256];
+    char extra;
+    unsigned long value;
+    bool8 found = FALSE;
+
+    if (fp == NULL)
+    {
+        perror(mapPath);
+        return FALSE;
+    }
+    while (!found && fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, " 0x%lx %255s %c", &value, symbol, &extra) == 2 && strcmp(symbol, name) == 0)
+        {
+            *address = value;
+            found = TRUE;
+        }
+    }
+    fclose(fp);
+    if (!found)
+        fprintf(stderr, "%s: no symbol %s\n", mapPath, name);
+    return found;
+}
+
+static bool8 LoadCheckROM(const char *romPath, u32 *size)
+{
+    FILE *fp = fopen(romPath, "rb");
+    long fileSize;
+    bool8 ok;
+
+    if (fp == NULL)
+    {
+        perror(romPath);
+        return FALSE;
+    }
+    fseek(fp, 0, SEEK_END);
+    fileSize = ftell(fp);
+    rewind(fp);
+    if (fileSize <= 0 || fileSize > CHECK_ROM_MAX_SIZE)
+    {
+        fprintf(stderr, "%s: not a ROM image\n", romPath);
+        fclose(fp);
+        return FALSE;
+    }
+    if (mmap((void *)CHECK_ROM_ADDR, fileSize, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void *)CHECK_ROM_ADDR)
+    {
+        perror("can't map the ROM");
+        fclose(fp);
+        return FALSE;
+    }
+    ok = fread((void *)CHECK_ROM_ADDR, 1, fileSize, fp) == (size_t)fileSize;
+    if (!ok)
+        fprintf(stderr, "%s: can't read file\n", romPath);
+    fclose(fp);
+    *size = fileSize;
+    return ok;
+}
+
+static bool8 LoadAIScriptsTable(const char *mapPath, const char *name, u32 romSize, u8 **table)
+{
+    u32 address, i;
+
+    if (!FindMapSymbol(mapPath, name, &address))
+        return FALSE;
+    if (address < CHECK_ROM_ADDR || address + CHECK_AI_SCRIPTS * 4 > CHECK_ROM_ADDR + romSize)
+    {
+        fprintf(stderr, "%s is outside the ROM\n", name);
+        return FALSE;
+    }
+    for (i = 0; i < CHECK_AI_SCRIPTS; i++)
+    {
+        table[i] = T1_READ_PTR((const u8 *)(uintptr_t)address + i * 4);
+        if ((uintptr_t)table[i] < CHECK_ROM_ADDR || (uintptr_t)table[i] >= CHECK_ROM_ADDR + romSize)
+        {
+            fprintf(stderr, "%s[%u] is outside the ROM\n", name, i);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void RandomizeAIBattleMon(u8 battlerId)
+{
+    static const u32 statuses[] = {0, 0, 0, 1, 3, STATUS1_POISON, STATUS1_BURN, STATUS1_FREEZE, STATUS1_PARALYSIS, STATUS1_TOXIC_POISON};
+    struct BattlePokemon *mon = &gBattleMons[battlerId];
+    u16 species = (Random() % SPECIES_CHIMECHO) + 1;
+    s32 i;
+
+    // Skip the unused Gen 2/3 placeholder slots between Celebi and Treecko.
+    if (species > SPECIES_CELEBI && species < SPECIES_TREECKO)
+        species = SPECIES_CELEBI;
+    memset(mon, 0, sizeof(*mon));
+    mon->species = species;
+    mon->level = (Random() % MAX_LEVEL) + 1;
+    mon->maxHP = (Random() % 400) + 1;
+    mon->hp = Random() % 3 == 0 ? Random() % (mon->maxHP + 1) : mon->maxHP;
+    mon->attack = (Random() % 400) + 5;
+    mon->defense = (Random() % 400) + 5;
+    mon->speed = (Random() % 400) + 5;
+    mon->spAttack = (Random() % 400) + 5;
+    mon->spDefense = (Random() % 400) + 5;
+    mon->type1 = gBaseStats[species].type1;
+    mon->type2 = gBaseStats[species].type2;
+    mon->ability = gBaseStats[species].abilities[Random() % 2];
+    mon->item = Random() % 4 == 0 ? Random() % (ITEM_ENIGMA_BERRY + 1) : ITEM_NONE;
+    mon->status1 = statuses[Random() % NELEMS(statuses)];
+    mon->status2 = Random() & Random() & Random();
+    for (i = 0; i < MAX_MON_MOVES; i++)
+    {
+        mon->moves[i] = Random() % 8 == 0 ? MOVE_NONE : Random() % MOVES_COUNT;
+        mon->pp[i] = Random() % 8;
+    }
+    for (i = 0; i < NUM_BATTLE_STATS; i++)
+        mon->statStages[i] = Random() % 2 == 0 ? DEFAULT_STAT_STAGE : Random() % (MAX_STAT_STAGE + 1);
+}
+
+static void RandomizeAIParty(struct Pokemon *party)
+{
+    s32 i;
+
+    for (i = 0; i < PARTY_SIZE; i++)
+    {
+        u16 species = Random() % 4 == 0 ? SPECIES_NONE : (Random() % SPECIES_CELEBI) + 1;
+        u16 hp = Random() % 4 == 0 ? 0 : (Random() % 300) + 1;
+        u32 status = Random() % 2 == 0 ? 0 : STATUS1_POISON << (Random() % 4);
+
+        ZeroMonData(&party[i]);
+        SetMonData(&party[i], MON_DATA_SPECIES, &species);
+        SetMonData(&party[i], MON_DATA_HP, &hp);
+        SetMonData(&party[i], MON_DATA_STATUS, &status);
+    }
+}
+
+// A random battle as seen from the opponent's side, in singles or doubles,
+// with a random set of AI scripts.
+static void RandomizeAIState(u32 seed)
+{
+    static const u32 battleTypes[] = {0, BATTLE_TYPE_TRAINER, BATTLE_TYPE_TRAINER | BATTLE_TYPE_DOUBLE};
+    u8 *disableStructs = (u8 *)gDisableStructs;
+    s32 i;
+
+    SeedRng(seed);
+    gBattleTypeFlags = battleTypes[Random() % NELEMS(battleTypes)];
+    gActiveBattler = (gBattleTypeFlags & BATTLE_TYPE_DOUBLE) ? B_POSITION_OPPONENT_LEFT + (Random() % 2) * 2 : B_POSITION_OPPONENT_LEFT;
+    gAbsentBattlerFlags = 0;
+    gBattleWeather = Random() % 2 == 0 ? 0 : 1 << (Random() % 8);
+    for (i = 0; i < MAX_BATTLERS_COUNT; i++)
+    {
+        RandomizeAIBattleMon(i);
+        gBattlerPartyIndexes[i] = Random() % PARTY_SIZE;
+        gLastMoves[i] = Random() % MOVES_COUNT;
+        gStatuses3[i] = Random() & Random() & Random();
+    }
+    for (i = 0; i < sizeof(gDisableStructs); i++)
+        disableStructs[i] = Random() % 4 == 0 ? Random() : 0;
+    for (i = 0; i < 2; i++)
+        gSideStatuses[i] = Random() & Random() & Random();
+    RandomizeAIParty(gPlayerParty);
+    RandomizeAIParty(gEnemyParty);
+
+    memset(gBattleResources->battleHistory, 0, sizeof(*gBattleResources->battleHistory));
+    for (i = 0; i < 8; i++)
+        gBattleResources->battleHistory->usedMoves[B_SIDE_PLAYER][i] = Random() % 2 == 0 ? MOVE_NONE : Random() % MOVES_COUNT;
+    gBattleResources->battleHistory->abilities[B_SIDE_PLAYER] = Random() % 2 == 0 ? ABILITY_NONE : gBattleMons[B_POSITION_PLAYER_LEFT].ability;
+    gBattleResources->battleHistory->itemEffects[B_SIDE_PLAYER] = Random() % 4 == 0 ? Random() % HOLD_EFFECT_SHELL_BELL : HOLD_EFFECT_NONE;
+
+    BattleAI_SetupAIData();
+    gBattleResources->ai->aiFlags = Random() & (AI_SCRIPT_UNKNOWN * 2 - 1);
+    if (Random() % 8 == 0)
+        gBattleResources->ai->aiFlags |= AI_SCRIPT_ROAMING << (Random() % 3);
+}
+
+// BattleAI_ChooseMoveOrAction runs the byte coded scripts and the compiled
+// ones from the same state in this build, as it does in DEBUG ROM builds,
+// and asserts that both give every move the same score and pick the same
+// action.
+int CheckAIScripts(const char *romPath, const char *mapPath)
+{
+    u32 romSize, state;
+    u32 mismatches = 0;
+
+    if (!LoadCheckROM(romPath, &romSize)
+     || !LoadAIScriptsTable(mapPath, "gBattleAI_ScriptsTable", romSize, gBattleAI_ScriptsTable)
+     || !LoadAIScriptsTable(mapPath, "gBattleAI_CompiledScriptsTable", romSize, gBattleAI_CompiledScriptsTable))
+        return 1;
+
+    gHostCountAsserts = TRUE;
+    for (state = 0; state < CHECK_AI_STATES; state++)
+    {
+        u32 assertCount, aiFlags;
+
+        RandomizeAIState(state);
+        aiFlags = gBattleResources->ai->aiFlags;
+        assertCount = gHostAssertCount;
+        BattleAI_ChooseMoveOrAction();
+        if (gHostAssertCount != assertCount && ++mismatches <= CHECK_MAX_REPORTS)
+            fprintf(stderr, "AI scripts: state %u (scripts 0x%08x) scored differently\n", state, aiFlags);
+    }
+    gHostCountAsserts = FALSE;
+
+    printf("%u of %u battle states scored the same by both forms of the AI scripts\n", CHECK_AI_STATES - mismatches, CHECK_AI_STATES);
+    return mismatches != 0;
+}
@@ -0,0 +1,17 @@
+#ifndef GUARD_HOST_CHECK_H
+#define GUARD_HOST_CHECK_H
+
+// Runs every check in check.c, or only those named, printing one line per
+// check. Returns the number that failed.
+int RunHostChecks(int count, char **names);
+
+// Runs the byte coded and compiled AI scripts of a ROM build side by side
+// over random battle states. Returns nonzero if they ever disagree.
+int CheckAIScripts(const char *romPath, const char *mapPath);
+
+// In stubs.c. While gHostCountAsserts is set, failed assertions are only
+// counted.
+extern bool8 gHostCountAsserts;
+extern u32 gHostAssertCount;
+
+#endif // GUARD_HOST_CHECK_H
@@ -0,0 +1,557 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "global.h"
+#include "decompress.h"
+#include "link.h"
+#include "task.h"
+
+// Two units joined by a simulated link cable, each running the real
+// src/link.c in its own process so that nothing static is shared. The master
+// process keeps the clock: it raises VBlank every frame, fires Timer 3 when
+// link.c has started it, and carries out each multi-player transfer by
+// swapping SIOMLT_SEND words with the slave and running both SerialCBs. The
+// I/O registers live where the game expects them, at 0x4000000.
+//
+// Each unit opens the link and, once the players have been exchanged, sends
+// a series of blocks with SendBlock, checking every block it receives.
+// Blocks that fit in gBlockSendBuffer are exchanged by both units at once;
+// larger ones land in gDecompressionBuffer, so they go one way at a time.
+// The default of 252 bytes is the most the stock protocol can take without
+// its last packet running past gBlockRecvBuffer.
+//
+// Usage: linksim [-rounds N] [-size BYTES] [-noise N] [-seed N]
+//                [-legacy master|slave|both]
+//
+// -noise flips a bit in about one in N words of the command cycles that only
+// carry block windows, as seen by one unit; link.c should drop those cycles
+// and send the windows again. -legacy makes a unit behave like a ROM that
+// doesn't know about block windows.
+
+#define SIM_IO_SIZE 0x1000
+#define SIM_CYCLES_PER_FRAME 280896
+// 115200 bps, with a start and stop bit around each player's 16-bit word.
+#define SIM_TRANSFER_CYCLES(players) ((players) * 18 * 16777216 / 115200)
+#define SIM_TIMER_CYCLES(reload) ((0x10000 - (reload)) * 64)
+#define SIM_NEVER 0xFFFFFFFFFFFFFFFFull
+#define SIM_CONNECT_FRAMES 600
+
+enum
+{
+    SIM_CONNECTING,
+    SIM_RUNNING,
+    SIM_DONE,
+    SIM_FAILED,
+};
+
+enum
+{
+    MSG_FRAME,
+    MSG_TRANSFER,
+    MSG_RECV,
+    MSG_QUIT,
+};
+
+struct SimMsg
+{
+    u8 type;
+    u16 word;
+    u16 noise[2];
+};
+
+struct SimResult
+{
+    u8 state;
+    u32 frame;
+    u32 startFrame;
+    u32 endFrame;
+    u32 badBlocks;
+    u32 linkStatus;
+};
+
+static u32 sRounds = 20;
+static u32 sSize = 252;
+static u32 sNoise;
+static u32 sSeed = 1;
+static bool8 sLegacy[2];
+
+static u8 sLocalId;
+static struct SimResult sResult;
+static u32 sRound;
+static bool8 sSent;
+static u8 sSendData[sizeof(gDecompressionBuffer)];
+
+static u32 sNoiseRng;
+static u64 sTransfers;
+static u64 sWindowTransfers;
+static u32 sInjected;
+
+static void WriteAll(int fd, const void *data, size_t size)
+{
+    const u8 *p = data;
+    ssize_t n;
+
+    while (size != 0)
+    {
+        n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            perror("linksim: write");
+            exit(1);
+        }
+        p += n;
+        size -= n;
+    }
+}
+
+static void ReadAll(int fd, void *data, size_t size)
+{
+    u8 *p = data;
+    ssize_t n;
+
+    while (size != 0)
+    {
+        n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            fprintf(stderr, "linksim: the other unit went away\n");
+            exit(1);
+        }
+        p += n;
+        size -= n;
+    }
+}
+
+static u8 GetBlockByte(u8 player, u32 round, u32 i)
+{
+    u32 x = (sSeed * 0x9E3779B1) ^ (player << 24) ^ (round << 12) ^ i;
+
+    x ^= x >> 15;
+    x *= 0x2C1B3C6D;
+    x ^= x >> 12;
+    return x;
+}
+
+static bool32 IsBigRound(void)
+{
+    return sSize > BLOCK_BUFFER_SIZE;
+}
+
+static u8 GetExpectedBlocks(void)
+{
+    if (IsBigRound())
+        return 1 << (sRound % 2);
+    return 3;
+}
+
+static bool32 CheckReceivedBlocks(u8 received)
+{
+    const u8 *data;
+    u8 player;
+    u32 i;
+
+    for (player = 0; player < 2; player++)
+    {
+        if (!(received & (1 << player)))
+            continue;
+        if (IsBigRound())
+            data = gDecompressionBuffer;
+        else
+            data = (const u8 *)gBlockRecvBuffer[player];
+        for (i = 0; i < sSize; i++)
+        {
+            if (data[i] != GetBlockByte(player, sRound, i))
+                return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// What the unit's game code would be doing this frame.
+static void UpdateUnit(void)
+{
+    u8 expected;
+    u32 i;
+
+    if (HasLinkErrorOccurred())
+    {
+        sResult.state = SIM_FAILED;
+        return;
+    }
+
+    switch (sResult.state)
+    {
+    case SIM_CONNECTING:
+        if (sLocalId == 0 && !(gLinkStatus & LINK_STAT_CONN_ESTABLISHED))
+            CheckShouldAdvanceLinkState();
+        if (gReceivedRemoteLinkPlayers && IsLinkTaskFinished())
+        {
+            sResult.state = SIM_RUNNING;
+            sResult.startFrame = sResult.frame;
+        }
+        else if (sResult.frame > SIM_CONNECT_FRAMES)
+        {
+            sResult.state = SIM_FAILED;
+        }
+        break;
+    case SIM_RUNNING:
+        expected = GetExpectedBlocks();
+        if (!sSent)
+        {
+            if (!(expected & (1 << sLocalId)))
+            {
+                sSent = TRUE;
+            }
+            else if (IsLinkTaskFinished())
+            {
+                for (i = 0; i < sSize; i++)
+                    sSendData[i] = GetBlockByte(sLocalId, sRound, i);
+                sSent = SendBlock(0, sSendData, sSize);
+            }
+        }
+        if (sSent && (GetBlockReceivedStatus() & expected) == expected)
+        {
+            if (!CheckReceivedBlocks(expected))
+                sResult.badBlocks++;
+            ResetBlockReceivedFlags();
+            sSent = FALSE;
+            if (++sRound == sRounds)
+            {
+                sResult.state = SIM_DONE;
+                sResult.endFrame = sResult.frame;
+            }
+        }
+        break;
+    }
+}
+
+// The terminals and ID are read-only on hardware, so put them back after
+// link.c has written to SIOCNT.
+static void SetSioTerminals(void)
+{
+    u16 terminals = sLocalId == 0 ? SIO_MULTI_SD : (SIO_MULTI_SD | SIO_MULTI_SI);
+
+    REG_SIOCNT = (REG_SIOCNT & ~(SIO_MULTI_SI | SIO_MULTI_SD | SIO_ID | SIO_ERROR)) | terminals | (sLocalId << 4);
+}
+
+static void RunUnitFrame(void)
+{
+    SetSioTerminals();
+    if (!gLinkVSyncDisabled)
+        LinkVSync();
+    HandleLinkConnection();
+    UpdateUnit();
+    RunTasks();
+    sResult.frame++;
+}
+
+static void RunUnitTransfer(u16 master, u16 slave, const u16 *noise)
+{
+    u16 recv[4];
+
+    recv[0] = master ^ noise[0];
+    recv[1] = slave ^ noise[1];
+    recv[2] = 0xFFFF;
+    recv[3] = 0xFFFF;
+    memcpy((void *)REG_ADDR_SIOMLT_RECV, recv, sizeof(recv));
+    REG_SIOCNT &= ~SIO_START;
+    SetSioTerminals();
+    if (REG_SIOCNT & SIO_INTR_ENABLE)
+        SerialCB();
+}
+
+static void InitUnit(u8 localId)
+{
+    sLocalId = localId;
+    gLinkBlockWindowsDisabled = sLegacy[localId];
+    SetSioTerminals();
+    ResetTasks();
+    OpenLink();
+}
+
+// MSG_TRANSFER asks for the slave's SIOMLT_SEND word, and MSG_RECV then hands
+// it what it received so that it can run SerialCB.
+static void RunSlave(int fd)
+{
+    struct SimMsg msg;
+    u16 word;
+
+    InitUnit(1);
+    for (;;)
+    {
+        ReadAll(fd, &msg, sizeof(msg));
+        switch (msg.type)
+        {
+        case MSG_FRAME:
+            RunUnitFrame();
+            sResult.linkStatus = gLinkStatus;
+            WriteAll(fd, &sResult, sizeof(sResult));
+            break;
+        case MSG_TRANSFER:
+            word = (REG_SIOCNT & SIO_INTR_ENABLE) ? REG_SIOMLT_SEND : 0xFFFF;
+            WriteAll(fd, &word, sizeof(word));
+            break;
+        case MSG_RECV:
+            RunUnitTransfer(msg.word, word, msg.noise);
+            break;
+        case MSG_QUIT:
+            exit(0);
+        }
+    }
+}
+
+static int PrintResults(const struct SimResult *slave);
+
+static bool32 IsBlockWindowCmd(u16 cmd)
+{
+    return (cmd & 0xFF00) == LINKCMD_BLOCK_WINDOW_DATA
+        || cmd == LINKCMD_BLOCK_WINDOW_END
+        || cmd == LINKCMD_BLOCK_WINDOW_ACK;
+}
+
+// Picks the bits to flip in what each unit receives. Only the data words of
+// cycles made up of block window commands, and the checksum that follows
+// them, are touched. The master's sendCmdIndex says which word of the cycle
+// is on the wire: 0 is the checksum of the previous cycle, and n the n-1th
+// word of this one.
+static void MakeNoise(u16 master, u16 slave, u16 noise[2][2])
+{
+    static bool8 windowCycle;
+    u32 r;
+
+    memset(noise, 0, sizeof(u16) * 4);
+    if (gLink.state != LINK_STATE_CONN_ESTABLISHED)
+        return;
+    if (gLink.sendCmdIndex == 1)
+    {
+        windowCycle = (IsBlockWindowCmd(master) || IsBlockWindowCmd(slave))
+                   && (master == 0 || IsBlockWindowCmd(master))
+                   && (slave == 0 || IsBlockWindowCmd(slave));
+        return;
+    }
+    if (!windowCycle)
+        return;
+    if (gLink.sendCmdIndex != 0)
+        sWindowTransfers++;
+    else
+        windowCycle = FALSE;
+    if (sNoise == 0)
+        return;
+    sNoiseRng = 1103515245 * sNoiseRng + 12345;
+    r = sNoiseRng >> 8;
+    if (r % sNoise != 0)
+        return;
+    r /= sNoise;
+    noise[r & 1][(r >> 1) & 1] = 1 << ((r >> 2) & 15);
+    sInjected++;
+}
+
+static void DoTransfer(int fd)
+{
+    struct SimMsg msg;
+    u16 noise[2][2];
+    u16 master;
+    u16 slave;
+
+    master = REG_SIOMLT_SEND;
+    msg.type = MSG_TRANSFER;
+    WriteAll(fd, &msg, sizeof(msg));
+    ReadAll(fd, &slave, sizeof(slave));
+    MakeNoise(master, slave, noise);
+    msg.type = MSG_RECV;
+    msg.word = master;
+    msg.noise[0] = noise[1][0];
+    msg.noise[1] = noise[1][1];
+    WriteAll(fd, &msg, sizeof(msg));
+    RunUnitTransfer(master, slave, noise[0]);
+    sTransfers++;
+}
+
+static int RunMaster(int fd, u32 maxFrames)
+{
+    struct SimMsg msg;
+    struct SimResult slave;
+    u64 now = 0;
+    u64 nextVBlank = 0;
+    u64 timerAt = SIM_NEVER;
+    u64 transferAt = SIM_NEVER;
+
+    InitUnit(0);
+    sNoiseRng = sSeed;
+    memset(&slave, 0, sizeof(slave));
+    for (;;)
+    {
+        if (transferAt <= timerAt && transferAt <= nextVBlank)
+        {
+            now = transferAt;
+            transferAt = SIM_NEVER;
+            DoTransfer(fd);
+        }
+        else if (timerAt <= nextVBlank)
+        {
+            now = timerAt;
+            timerAt = SIM_NEVER;
+            Timer3Intr();
+        }
+        else
+        {
+            now = nextVBlank;
+            nextVBlank += SIM_CYCLES_PER_FRAME;
+            msg.type = MSG_FRAME;
+            WriteAll(fd, &msg, sizeof(msg));
+            RunUnitFrame();
+            sResult.linkStatus = gLinkStatus;
+            ReadAll(fd, &slave, sizeof(slave));
+            if (sResult.state == SIM_FAILED || slave.state == SIM_FAILED)
+                break;
+            if (sResult.state == SIM_DONE && slave.state == SIM_DONE)
+                break;
+            if (sResult.frame >= maxFrames)
+            {
+                fprintf(stderr, "linksim: gave up after %u frames\n", sResult.frame);
+                break;
+            }
+        }
+
+        if (!(REG_SIOCNT & SIO_START))
+            transferAt = SIM_NEVER;
+        else if (transferAt == SIM_NEVER)
+            transferAt = now + SIM_TRANSFER_CYCLES(2);
+        if (!(REG_TM3CNT_H & TIMER_ENABLE))
+            timerAt = SIM_NEVER;
+        else if (timerAt == SIM_NEVER)
+            timerAt = now + SIM_TIMER_CYCLES(REG_TM3CNT_L);
+    }
+
+    msg.type = MSG_QUIT;
+    WriteAll(fd, &msg, sizeof(msg));
+    waitpid(-1, NULL, 0);
+    return PrintResults(&slave);
+}
+
+static const char *GetStateName(u8 state)
+{
+    switch (state)
+    {
+    case SIM_CONNECTING:
+        return "still connecting";
+    case SIM_RUNNING:
+        return "still sending";
+    case SIM_DONE:
+        return "done";
+    default:
+        return "failed";
+    }
+}
+
+static int PrintResults(const struct SimResult *slave)
+{
+    const struct SimResult *units[2] = {&sResult, slave};
+    u32 frames;
+    u32 bytes;
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        printf("%s: %s after %u frames, link status %08X",
+               i == 0 ? "master" : "slave", GetStateName(units[i]->state), units[i]->frame, units[i]->linkStatus);
+        if (units[i]->badBlocks != 0)
+            printf(", %u bad blocks", units[i]->badBlocks);
+        putchar('\n');
+    }
+    if (sResult.state != SIM_DONE || slave->state != SIM_DONE || sResult.badBlocks != 0 || slave->badBlocks != 0)
+        return 1;
+
+    frames = sResult.endFrame - sResult.startFrame;
+    if (frames < slave->endFrame - slave->startFrame)
+        frames = slave->endFrame - slave->startFrame;
+    bytes = sRounds * sSize * (IsBigRound() ? 1 : 2);
+    printf("%u bytes in %u frames (%.1f bytes/frame), block windows %s",
+           bytes, frames, (double)bytes / frames, sWindowTransfers != 0 ? "used" : "not used");
+    if (sNoise != 0)
+        printf(", %u words corrupted", sInjected);
+    putchar('\n');
+    return 0;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "Usage: linksim [-rounds N] [-size BYTES] [-noise N] [-seed N] [-legacy master|slave|both]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    int fds[2];
+    pid_t pid;
+    u32 maxFrames;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (i + 1 == argc)
+            Usage();
+        if (strcmp(argv[i], "-rounds") == 0)
+            sRounds = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-size") == 0)
+            sSize = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-noise") == 0)
+            sNoise = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-seed") == 0)
+            sSeed = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-legacy") == 0)
+        {
+            i++;
+            if (strcmp(argv[i], "master") == 0 || strcmp(argv[i], "both") == 0)
+                sLegacy[0] = TRUE;
+            if (strcmp(argv[i], "slave") == 0 || strcmp(argv[i], "both") == 0)
+                sLegacy[1] = TRUE;
+            if (!sLegacy[0] && !sLegacy[1])
+                Usage();
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (sRounds == 0 || sSize == 0 || sSize > sizeof(gDecompressionBuffer))
+        Usage();
+
+    if (mmap((void *)REG_BASE, SIM_IO_SIZE, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void *)REG_BASE)
+    {
+        perror("linksim: can't map the I/O registers");
+        return 1;
+    }
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        perror("linksim: socketpair");
+        return 1;
+    }
+
+    // Plenty of time for the slowest case, the unmodified protocol.
+    maxFrames = SIM_CONNECT_FRAMES + sRounds * (sSize / 7 + 60);
+
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("linksim: fork");
+        return 1;
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        RunSlave(fds[1]);
+    }
+    close(fds[1]);
+    return RunMaster(fds[0], maxFrames);
+}
@@ -0,0 +1,430 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "global.h"
+#include "main.h"
+#include "malloc.h"
+#include "bg.h"
+#include "bg_regs.h"
+#include "event_data.h"
+#include "gpu_regs.h"
+#include "graphics.h"
+#include "item_menu.h"
+#include "link.h"
+#include "link_rfu.h"
+#include "librfu.h"
+#include "m4a.h"
+#include "menu.h"
+#include "new_menu_helpers.h"
+#include "overworld.h"
+#include "palette.h"
+#include "quest_log.h"
+#include "random.h"
+#include "reset_save_heap.h"
+#include "save.h"
+#include "scanline_effect.h"
+#include "sound.h"
+#include "sprite.h"
+#include "string_util.h"
+#include "strings.h"
+#include "text.h"
+#include "trade.h"
+#include "window.h"
+
+// Everything src/link.c, src/task.c and src/util.c reach outside of
+// themselves when built into linksim. The cable is the only hardware that
+// exists: there is nothing to draw, play or save, the wireless adapter is
+// never plugged in, and a reset ends the process.
+
+static struct SaveBlock2 sSaveBlock2 = {.playerName = {EOS}};
+
+struct SaveBlock2 *gSaveBlock2Ptr = &sSaveBlock2;
+struct Main gMain;
+
+const u8 gGameVersion = GAME_VERSION;
+const u8 gGameLanguage = GAME_LANGUAGE;
+
+bool8 gLinkVSyncDisabled;
+u8 gLinkTransferringData;
+bool8 gSoftResetDisabled;
+u16 gHeldKeyCodeToSend;
+u32 gBattleTypeFlags;
+u8 gQuestLogState;
+u16 gSpecialVar_ItemId;
+u8 gDecompressionBuffer[0x4000];
+u8 gHeap[HEAP_SIZE];
+struct Sprite gSprites[MAX_SPRITES + 1];
+struct MusicPlayerInfo gMPlayInfo_SE1;
+struct MusicPlayerInfo gMPlayInfo_SE2;
+struct MusicPlayerInfo gMPlayInfo_SE3;
+
+const u8 gBGControlRegOffsets[4];
+const struct OamData gDummyOamData;
+const union AnimCmd *const gDummySpriteAnimTable[1];
+const union AffineAnimCmd *const gDummySpriteAffineAnimTable[1];
+const u16 gTMCaseMainWindowPalette[16];
+const u8 gText_ABtnRegistrationCounter[] = {EOS};
+const u8 gText_ABtnTitleScreen[] = {EOS};
+const u8 gText_CommErrorCheckConnections[] = {EOS};
+const u8 gText_CommErrorEllipsis[] = {EOS};
+const u8 gText_MoveCloserToLinkPartner[] = {EOS};
+
+static u32 sRngValue;
+
+u16 Random(void)
+{
+    sRngValue = 1103515245 * sRngValue + 24691;
+    return sRngValue >> 16;
+}
+
+void SeedRng(u16 seed)
+{
+    sRngValue = seed;
+}
+
+u8 *StringCopy(u8 *dest, const u8 *src)
+{
+    while (*src != EOS)
+        *dest++ = *src++;
+    *dest = EOS;
+    return dest;
+}
+
+s32 StringCompare(const u8 *str1, const u8 *str2)
+{
+    while (*str1 == *str2)
+    {
+        if (*str1 == EOS)
+            return 0;
+        str1++;
+        str2++;
+    }
+    return *str1 - *str2;
+}
+
+void ConvertInternationalString(u8 *s, u8 language)
+{
+}
+
+void DoSoftReset(void)
+{
+    fprintf(stderr, "linksim: soft reset\n");
+    exit(1);
+}
+
+bool8 FlagGet(u16 id)
+{
+    return FALSE;
+}
+
+bool32 IsNationalPokedexEnabled(void)
+{
+    return FALSE;
+}
+
+bool32 IsSendingKeysOverCable(void)
+{
+    return FALSE;
+}
+
+s32 Trade_CalcLinkPlayerCompatibilityParam(void)
+{
+    return 0;
+}
+
+u8 TrySavingData(u8 saveType)
+{
+    return SAVE_STATUS_OK;
+}
+
+void ResetSaveHeap(void)
+{
+}
+
+void *Alloc(u32 size)
+{
+    return NULL;
+}
+
+void InitHeap(void *pointer, u32 size)
+{
+}
+
+void DisableInterrupts(u16 mask)
+{
+}
+
+void EnableInterrupts(u16 mask)
+{
+}
+
+void RestoreSerialTimer3IntrHandlers(void)
+{
+}
+
+void SetMainCallback2(MainCallback callback)
+{
+}
+
+void SetVBlankCallback(IntrCallback callback)
+{
+}
+
+// Graphics, text and sound
+void SetGpuReg(u8 regOffset, u16 value)
+{
+}
+
+void ClearGpuRegBits(u8 regOffset, u16 mask)
+{
+}
+
+void BgAffineSet(struct BgAffineSrcData *src, struct BgAffineDstData *dest, s32 count)
+{
+}
+
+u8 CreateSprite(const struct SpriteTemplate *template, s16 x, s16 y, u8 subpriority)
+{
+    return MAX_SPRITES;
+}
+
+void SpriteCallbackDummy(struct Sprite *sprite)
+{
+}
+
+void AnimateSprites(void)
+{
+}
+
+void BuildOamBuffer(void)
+{
+}
+
+void LoadOam(void)
+{
+}
+
+void ProcessSpriteCopyRequests(void)
+{
+}
+
+void ResetSpriteData(void)
+{
+}
+
+void FreeAllSpritePalettes(void)
+{
+}
+
+void ResetPaletteFadeControl(void)
+{
+}
+
+bool8 BeginNormalPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor)
+{
+    return TRUE;
+}
+
+u8 UpdatePaletteFade(void)
+{
+    return 0;
+}
+
+void TransferPlttBuffer(void)
+{
+}
+
+void LoadPalette(const void *src, u16 offset, u16 size)
+{
+}
+
+void FillPalette(u16 value, u16 offset, u16 size)
+{
+}
+
+void ResetBgsAndClearDma3BusyFlags(bool32 enableWindowTileAutoAlloc)
+{
+}
+
+void InitBgsFromTemplates(u8 bgMode, const struct BgTemplate *templates, u8 numTemplates)
+{
+}
+
+void SetBgTilemapBuffer(u8 bg, void *tilemap)
+{
+}
+
+void CopyToBgTilemapBuffer(u8 bg, const void *src, u16 mode, u16 destOffset)
+{
+}
+
+void CopyBgTilemapBufferToVram(u8 bg)
+{
+}
+
+void ShowBg(u8 bg)
+{
+}
+
+void DecompressAndLoadBgGfxUsingHeap(u8 bgId, const void *src, u32 size, u16 offset, u8 mode)
+{
+}
+
+void ResetTempTileDataBuffers(void)
+{
+}
+
+void ScanlineEffect_Stop(void)
+{
+}
+
+bool16 InitWindows(const struct WindowTemplate *templates)
+{
+    return TRUE;
+}
+
+void FillWindowPixelBuffer(u8 windowId, u8 fillValue)
+{
+}
+
+void PutWindowTilemap(u8 windowId)
+{
+}
+
+void CopyWindowToVram(u8 windowId, u8 mode)
+{
+}
+
+void DeactivateAllTextPrinters(void)
+{
+}
+
+void AddTextPrinterParameterized3(u8 windowId, u8 fontId, u8 x, u8 y, const u8 * color, s8 speed, const u8 * str)
+{
+}
+
+void PlaySE(u16 songNum)
+{
+}
+
+void StopMapMusic(void)
+{
+}
+
+void m4aMPlayStop(struct MusicPlayerInfo *mplayInfo)
+{
+}
+
+// Wireless adapter
+void sub_80F86F4(void)
+{
+}
+
+void sub_80FB128(bool32 a0)
+{
+}
+
+void ResetLinkRfuGFLayer(void)
+{
+}
+
+bool32 LinkRfuMain1(void)
+{
+    return FALSE;
+}
+
+bool32 LinkRfuMain2(void)
+{
+    return FALSE;
+}
+
+u8 LinkRfu_GetMultiplayerId(void)
+{
+    return 0;
+}
+
+u8 GetRfuPlayerCount(void)
+{
+    return 0;
+}
+
+u32 GetRfuRecvQueueLength(void)
+{
+    return 0;
+}
+
+bool32 IsRfuRecvQueueEmpty(void)
+{
+    return TRUE;
+}
+
+bool8 IsLinkRfuTaskFinished(void)
+{
+    return TRUE;
+}
+
+bool32 IsSendingKeysToRfu(void)
+{
+    return FALSE;
+}
+
+void StartSendingKeysToRfu(void)
+{
+}
+
+bool8 LinkRfu_PrepareCmd0xA100(u8 blockRequestType)
+{
+    return FALSE;
+}
+
+void LinkRfu_SetRfuFuncToSend6600(void)
+{
+}
+
+void LinkRfu_Shutdown(void)
+{
+}
+
+void Rfu_BeginBuildAndSendCommand5F(void)
+{
+}
+
+u8 Rfu_GetBlockReceivedStatus(void)
+{
+    return 0;
+}
+
+bool32 Rfu_InitBlockSend(const u8 * src, size_t size)
+{
+    return FALSE;
+}
+
+bool8 Rfu_IsMaster(void)
+{
+    return FALSE;
+}
+
+void Rfu_ResetBlockReceivedFlag(u8 who)
+{
+}
+
+void Rfu_SetBlockReceivedFlag(u8 who)
+{
+}
+
+void Rfu_set_zero(void)
+{
+}
+
+u32 rfu_LMAN_REQBN_softReset_and_checkID(void)
+{
+    return 0;
+}
+
+void rfu_REQ_stopMode(void)
+{
+}
+
+u16 rfu_waitREQComplete(void)
+{
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <string.h>
+#include "global.h"
+#include "gba/m4a_internal.h"
+#include "m4a_mixer.h"
+
+// A C model of the last stage of SoundMainRAM in src/m4a_1.s: after every
+// channel has been mixed into hq_buffer_ptr, each sample is noise shaped
+// down to 8 bits, written to the Direct Sound buffer, and hq_buffer_ptr is
+// refilled with the reverb feedback for the next frame. It follows the
+// assembly step by step, including the saturation and the order in which
+// the old buffer contents are read and overwritten, so that the two loops
+// there can be compared and timed here.
+//
+// It is only a model. Nothing on the host runs the ARM code in m4a_1.s, so
+// a slip in writing either loop there is not caught by anything here.
+
+// adds rN, r12, r12 / eorvs r12, lr, rN, asr#31 / and rN, r12, #0x007F0000 /
+// and rM, r11, r12, lsr#15
+static u32 DownsampleSample(u32 acc, u32 *noiseShape)
+{
+    u32 doubled = acc + acc;
+
+    if ((s32)(acc ^ doubled) < 0)
+        acc = 0xC0000000 ^ (u32)((s32)doubled >> 31);
+    *noiseShape = acc & 0x007F0000;
+    return (acc >> 15) & 0xFF00;
+}
+
+static s32 LoadPcmPair(const s8 *pcm)
+{
+    s16 pair;
+
+    memcpy(&pair, pcm, sizeof(pair));
+    return pair;
+}
+
+static void StorePcmPair(s8 *pcm, u32 pair)
+{
+    u16 halfword = pair;
+
+    memcpy(pcm, &halfword, sizeof(halfword));
+}
+
+// The downsample_pair macro: two stereo samples of hqBuffer through the
+// noise shaping; the left pair is returned in *left and the right in *right.
+static void DownsamplePair(const u32 *hqBuffer, u32 *noiseLeft, u32 *noiseRight, u32 *left, u32 *right)
+{
+    u32 sample;
+
+    *left = DownsampleSample(*noiseLeft + hqBuffer[0], noiseLeft);
+    *right = DownsampleSample(*noiseRight + (hqBuffer[0] << 16), noiseRight);
+    sample = DownsampleSample(*noiseLeft + hqBuffer[1], noiseLeft);
+    *left = sample | (*left >> 8);
+    sample = DownsampleSample(*noiseRight + (hqBuffer[1] << 16), noiseRight);
+    *right = sample | (*right >> 8);
+}
+
+void HostSoundMainDownsample(struct SoundInfo *soundInfo, u32 *hqBuffer, s8 *bufferPos, s32 frameLength, u8 bufferPosIndexHint, bool8 dryPath)
+{
+    u32 noiseLeft = soundInfo->gap[1] << 16;
+    u32 noiseRight = soundInfo->gap[2] << 16;
+    u32 reverb = soundInfo->reverb >> 2;
+    s32 readOffset;
+    s32 remaining;
+    u32 left, right;
+
+    reverb |= reverb << 16;
+    if (bufferPosIndexHint != 2)
+        readOffset = frameLength;
+    else
+        readOffset = soundInfo->pcmBuffer - bufferPos;
+
+    // C_downsampler_dry_loop, chosen once before the loop.
+    if (dryPath && reverb == 0)
+    {
+        for (remaining = frameLength; remaining > 0; remaining -= 2)
+        {
+            DownsamplePair(hqBuffer, &noiseLeft, &noiseRight, &left, &right);
+            StorePcmPair(bufferPos + PCM_DMA_BUF_SIZE, left);
+            StorePcmPair(bufferPos, right);
+            hqBuffer[0] = 0;
+            hqBuffer[1] = 0;
+            bufferPos += 2;
+            hqBuffer += 2;
+        }
+    }
+    else
+    {
+        for (remaining = frameLength; remaining > 0; remaining -= 2)
+        {
+            s32 feedback0, feedback1, pair;
+
+            DownsamplePair(hqBuffer, &noiseLeft, &noiseRight, &left, &right);
+            pair = LoadPcmPair(bufferPos + readOffset);
+            feedback1 = pair >> 8;
+            feedback0 = (s8)pair;
+            pair = LoadPcmPair(bufferPos + readOffset + PCM_DMA_BUF_SIZE);
+            feedback1 += pair >> 8;
+            feedback0 += (s8)pair;
+            pair = LoadPcmPair(bufferPos + PCM_DMA_BUF_SIZE);
+            feedback1 += pair >> 8;
+            feedback0 += (s8)pair;
+            StorePcmPair(bufferPos + PCM_DMA_BUF_SIZE, left);
+            pair = LoadPcmPair(bufferPos);
+            StorePcmPair(bufferPos, right);
+            feedback1 += pair >> 8;
+            feedback0 += (s8)pair;
+            hqBuffer[0] = reverb * (u32)feedback0;
+            hqBuffer[1] = reverb * (u32)feedback1;
+            bufferPos += 2;
+            hqBuffer += 2;
+        }
+    }
+
+    soundInfo->gap[1] = noiseLeft >> 16;
+    soundInfo->gap[2] = noiseRight >> 16;
+}
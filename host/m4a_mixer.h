@@ -0,0 +1,10 @@
+#ifndef GUARD_HOST_M4A_MIXER_H
+#define GUARD_HOST_M4A_MIXER_H
+
+// Runs one frame of the SoundMainRAM downsampler over hqBuffer, writing to
+// bufferPos in soundInfo->pcmBuffer. bufferPosIndexHint is the
+// pcmDmaCounter SoundMain passes in; dryPath takes the no-reverb loop when
+// the reverb level allows it.
+void HostSoundMainDownsample(struct SoundInfo *soundInfo, u32 *hqBuffer, s8 *bufferPos, s32 frameLength, u8 bufferPosIndexHint, bool8 dryPath);
+
+#endif // GUARD_HOST_M4A_MIXER_H
@@ -0,0 +1,562 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "global.h"
+#include "main.h"
+#include "malloc.h"
+#include "bg.h"
+#include "new_menu_helpers.h"
+#include "palette.h"
+#include "quest_log.h"
+#include "script.h"
+#include "battle.h"
+#include "battle_anim.h"
+#include "battle_controllers.h"
+#include "battle_gfx_sfx_util.h"
+#include "battle_main.h"
+#include "battle_message.h"
+#include "battle_util.h"
+#include "data.h"
+#include "day_night.h"
+#include "event_data.h"
+#include "evolution_scene.h"
+#include "field_message_box.h"
+#include "field_specials.h"
+#include "item.h"
+#include "link.h"
+#include "m4a.h"
+#include "mevent.h"
+#include "overworld.h"
+#include "party_menu.h"
+#include "pokedex.h"
+#include "pokemon_storage_system.h"
+#include "rtc.h"
+#include "sound.h"
+#include "sprite.h"
+#include "strings.h"
+#include "text.h"
+#include "util.h"
+#include "constants/day_night.h"
+#include "constants/hold_effects.h"
+#include "constants/moves.h"
+
+// Everything the engine files built by host/Makefile reach outside
+// of themselves, reduced to the smallest thing that lets the pure logic run.
+// Flags and vars read as clear, no battler holds an item or has an ability
+// that triggers, it is always daytime, and anything to do with sprites,
+// sound or the link cable does nothing.
+
+static struct SaveBlock1 sSaveBlock1;
+static struct SaveBlock2 sSaveBlock2;
+static struct BoxPokemon sBoxMon;
+static struct ResourceFlags sResourceFlags;
+static struct BattleStruct sBattleStruct;
+static struct AI_ThinkingStruct sAIThinking;
+static struct BattleHistory sBattleHistory;
+static struct BattleScriptsStack sAIScriptsStack;
+static struct BattleResources sBattleResources =
+{
+    .flags = &sResourceFlags,
+    .ai = &sAIThinking,
+    .battleHistory = &sBattleHistory,
+    .AI_ScriptsStack = &sAIScriptsStack,
+};
+
+struct SaveBlock1 *gSaveBlock1Ptr = &sSaveBlock1;
+struct SaveBlock2 *gSaveBlock2Ptr = &sSaveBlock2;
+struct Main gMain;
+
+const u8 gGameVersion = GAME_VERSION;
+const u8 gGameLanguage = GAME_LANGUAGE;
+
+u16 gSpecialVar_0x8004;
+u16 gSpecialVar_0x8005;
+u16 gSpecialVar_0x8006;
+u16 gSpecialVar_MonBoxId;
+u16 gSpecialVar_MonBoxPos;
+
+struct LinkPlayer gLinkPlayers[MAX_RFU_PLAYERS];
+
+struct Sprite gSprites[MAX_SPRITES + 1];
+u16 gPlttBufferUnfaded[PLTT_BUFFER_SIZE];
+u16 gPlttBufferFaded[PLTT_BUFFER_SIZE];
+struct PaletteOverride *gPaletteOverrides[4];
+u8 gDecompressionBuffer[0x4000];
+
+const struct UCoords32 gDirectionToVectors[] =
+{
+    { 0,  0},
+    { 0,  1},
+    { 0, -1},
+    {-1,  0},
+    { 1,  0},
+    {-1,  1},
+    { 1,  1},
+    {-1, -1},
+    { 1, -1},
+};
+
+// Battle state
+u8 gAbsentBattlerFlags;
+u8 gActiveBattler;
+u8 gBattleMonForms[MAX_BATTLERS_COUNT];
+struct BattlePokemon gBattleMons[MAX_BATTLERS_COUNT];
+s32 gBattleMoveDamage;
+u16 gBattleMovePower;
+struct BattleResources *gBattleResources = &sBattleResources;
+struct BattleResults gBattleResults;
+struct BattleScripting gBattleScripting;
+struct BattleStruct *gBattleStruct = &sBattleStruct;
+u8 gBattleTextBuff1[TEXT_BUFF_ARRAY_COUNT];
+u8 gBattleTextBuff2[TEXT_BUFF_ARRAY_COUNT];
+u32 gBattleTypeFlags;
+u16 gBattleWeather;
+u8 gBattlerAttacker;
+u8 gBattlerInMenuId;
+u16 gBattlerPartyIndexes[MAX_BATTLERS_COUNT];
+u8 gBattlerTarget;
+u8 gBattlersCount;
+u8 gCritMultiplier = 1;
+u16 gCurrentMove;
+u16 gDynamicBasePower;
+u16 gLastMoves[MAX_BATTLERS_COUNT];
+u8 gMoveResultFlags;
+u16 gSideStatuses[2];
+u32 gStatuses3[MAX_BATTLERS_COUNT];
+struct DisableStruct gDisableStructs[MAX_BATTLERS_COUNT];
+u8 gDisplayedStringBattle[300];
+struct BattleEnigmaBerry gEnigmaBerries[MAX_BATTLERS_COUNT];
+u8 gLastUsedAbility;
+struct MonSpritesGfx *gMonSpritesGfxPtr;
+u16 gMoveToLearn;
+u8 gPotentialItemEffectBattler;
+struct SideTimer gSideTimers[2];
+u16 gTrainerBattleOpponent_A;
+
+// Data tables that live alongside graphics or text in the ROM build
+const u8 gSpeciesNames[NUM_SPECIES][POKEMON_NAME_LENGTH + 1] = {[0 ... NUM_SPECIES - 1] = {EOS}};
+const u8 gMoveNames[MOVES_COUNT][13] = {[0 ... MOVES_COUNT - 1] = {EOS}};
+const struct Trainer gTrainers[1];
+const struct CompressedSpriteSheet gMonFrontPicTable[NUM_SPECIES];
+const struct CompressedSpriteSheet gMonBackPicTable[NUM_SPECIES];
+const struct CompressedSpritePalette gMonPaletteTable[NUM_SPECIES];
+const struct CompressedSpritePalette gMonShinyPaletteTable[NUM_SPECIES];
+const struct OamData gDummyOamData;
+const union AnimCmd *const gDummySpriteAnimTable[1];
+const union AffineAnimCmd *const gDummySpriteAffineAnimTable[1];
+const union AnimCmd *const gSpriteAnimTable_82349BC[1];
+const union AffineAnimCmd *const gSpriteAffineAnimTable_BattlerPlayer[1];
+const union AffineAnimCmd *const gSpriteAffineAnimTable_BattlerOpponent[1];
+const union AnimCmd *const *const gTrainerFrontAnimsPtrTable[1];
+const union AnimCmd *const *const gTrainerBackAnimsPtrTable[1];
+const struct OamData gOamData_BattlerOpponent;
+const struct OamData gOamData_BattlerPlayer;
+const struct SpriteFrameImage gSpriteImages_BattlerPlayerLeft[1];
+const struct SpriteFrameImage gSpriteImages_BattlerOpponentLeft[1];
+const struct SpriteFrameImage gSpriteImages_BattlerPlayerRight[1];
+const struct SpriteFrameImage gSpriteImages_BattlerOpponentRight[1];
+const struct SpriteFrameImage gTrainerBackPicTable_Red[1];
+const struct SpriteFrameImage gTrainerBackPicTable_Leaf[1];
+const struct SpriteFrameImage gTrainerBackPicTable_Pokedude[1];
+const struct SpriteFrameImage gTrainerBackPicTable_OldMan[1];
+const struct SpriteFrameImage gTrainerBackPicTable_RSBrendan[1];
+const struct SpriteFrameImage gTrainerBackPicTable_RSMay[1];
+
+const u8 gText_EggNickname[] = {EOS};
+const u8 gText_Ghost[] = {EOS};
+const u8 gText_PkmnsStatChanged2[] = {EOS};
+const u8 gText_PkmnsXPreventsSwitching[] = {EOS};
+const u8 gBattleText_Rose[] = {EOS};
+const u8 gBattleText_GetPumped[] = {EOS};
+const u8 gBattleText_MistShroud[] = {EOS};
+const u8 *const gStatNamesTable[NUM_BATTLE_STATS];
+const u8 gText_ThreeQuestionMarks[] = {CHAR_QUESTION_MARK, CHAR_QUESTION_MARK, CHAR_QUESTION_MARK, EOS};
+const u8 gEasyChatGroupName_Pokemon[] = {EOS};
+const u8 gEasyChatGroupName_Trainer[] = {EOS};
+const u8 gEasyChatGroupName_Status[] = {EOS};
+const u8 gEasyChatGroupName_Battle[] = {EOS};
+const u8 gEasyChatGroupName_Greetings[] = {EOS};
+const u8 gEasyChatGroupName_People[] = {EOS};
+const u8 gEasyChatGroupName_Voices[] = {EOS};
+const u8 gEasyChatGroupName_Speech[] = {EOS};
+const u8 gEasyChatGroupName_Endings[] = {EOS};
+const u8 gEasyChatGroupName_Feelings[] = {EOS};
+const u8 gEasyChatGroupName_Conditions[] = {EOS};
+const u8 gEasyChatGroupName_Actions[] = {EOS};
+const u8 gEasyChatGroupName_Lifestyle[] = {EOS};
+const u8 gEasyChatGroupName_Hobbies[] = {EOS};
+const u8 gEasyChatGroupName_Time[] = {EOS};
+const u8 gEasyChatGroupName_Misc[] = {EOS};
+const u8 gEasyChatGroupName_Adjectives[] = {EOS};
+const u8 gEasyChatGroupName_Events[] = {EOS};
+const u8 gEasyChatGroupName_Move1[] = {EOS};
+const u8 gEasyChatGroupName_Move2[] = {EOS};
+const u8 gEasyChatGroupName_TrendySaying[] = {EOS};
+const u8 gEasyChatGroupName_Pokemon2[] = {EOS};
+
+const u8 gExpandedPlaceholder_Empty[] = {EOS};
+const u8 gExpandedPlaceholder_Kun[] = {EOS};
+const u8 gExpandedPlaceholder_Chan[] = {EOS};
+const u8 gExpandedPlaceholder_Sapphire[] = {EOS};
+const u8 gExpandedPlaceholder_Ruby[] = {EOS};
+const u8 gExpandedPlaceholder_Aqua[] = {EOS};
+const u8 gExpandedPlaceholder_Magma[] = {EOS};
+const u8 gExpandedPlaceholder_Archie[] = {EOS};
+const u8 gExpandedPlaceholder_Maxie[] = {EOS};
+const u8 gExpandedPlaceholder_Kyogre[] = {EOS};
+const u8 gExpandedPlaceholder_Groudon[] = {EOS};
+const u8 gExpandedPlaceholder_Red[] = {EOS};
+const u8 gExpandedPlaceholder_Green[] = {EOS};
+
+// Checks that expect assertions to fail set gHostCountAsserts, so that they
+// are counted in gHostAssertCount instead of stopping the program.
+bool8 gHostCountAsserts;
+u32 gHostAssertCount;
+
+void AGBAssert(const char *pFile, int nLine, const char *pExpression, int nStopProgram)
+{
+    gHostAssertCount++;
+    if (gHostCountAsserts)
+        return;
+    fprintf(stderr, "%s:%d: assertion failed: %s\n", pFile, nLine, pExpression);
+    if (nStopProgram)
+        abort();
+}
+
+// malloc.h maps these onto the game's heap functions; here they are the
+// other way round.
+#undef malloc
+#undef calloc
+#undef free
+
+void *Alloc(u32 size)
+{
+    return malloc(size);
+}
+
+void *AllocZeroed(u32 size)
+{
+    return calloc(1, size);
+}
+
+void Free(void *pointer)
+{
+    free(pointer);
+}
+
+bool8 FlagGet(u16 id)
+{
+    return FALSE;
+}
+
+u8 FlagClear(u16 id)
+{
+    return 0;
+}
+
+u16 VarGet(u16 id)
+{
+    return 0;
+}
+
+bool8 VarSet(u16 id, u16 value)
+{
+    return FALSE;
+}
+
+bool32 IsNationalPokedexEnabled(void)
+{
+    return TRUE;
+}
+
+s8 GetSetPokedexFlag(u16 nationalNum, u8 caseId)
+{
+    return 0;
+}
+
+u16 GetNationalPokedexCount(u8 caseId)
+{
+    return 0;
+}
+
+u16 *GetMEventProfileECWordsMaybe(void)
+{
+    static u16 words[4];
+
+    return words;
+}
+
+bool8 ShowFieldAutoScrollMessage(const u8 *message)
+{
+    return FALSE;
+}
+
+void RtcCalcLocalTime(void)
+{
+}
+
+u8 GetCurrentTimeOfDay(void)
+{
+    return TIME_DAY;
+}
+
+u8 GetCurrentRegionMapSectionId(void)
+{
+    return 0;
+}
+
+u8 ItemId_GetHoldEffect(u16 itemId)
+{
+    return HOLD_EFFECT_NONE;
+}
+
+u8 ItemId_GetHoldEffectParam(u16 itemId)
+{
+    return 0;
+}
+
+u8 GetBattlerSide(u8 battlerId)
+{
+    return battlerId & BIT_SIDE;
+}
+
+u8 GetBattlerPosition(u8 battlerId)
+{
+    return battlerId;
+}
+
+u8 GetBattlerAtPosition(u8 position)
+{
+    return position;
+}
+
+// Battle engine functions the AI scripts call. They stand in for the real
+// ones with something that depends on the same state and nothing else.
+void AI_CalcDmg(u8 attacker, u8 defender)
+{
+    gBattleMoveDamage = CalculateBaseDamage(&gBattleMons[attacker], &gBattleMons[defender], gCurrentMove,
+                                            gSideStatuses[GET_BATTLER_SIDE(defender)], gDynamicBasePower,
+                                            gBattleStruct->dynamicMoveType, attacker, defender);
+    gDynamicBasePower = 0;
+    gBattleMoveDamage = gBattleMoveDamage * gCritMultiplier * gBattleScripting.dmgMultiplier;
+}
+
+// Effectiveness made up from the move's type and the defender's, in place of
+// gTypeEffectiveness.
+u8 TypeCalc(u16 move, u8 attacker, u8 defender)
+{
+    static const u8 multipliers[] = {TYPE_MUL_NO_EFFECT, TYPE_MUL_NOT_EFFECTIVE, TYPE_MUL_NORMAL, TYPE_MUL_SUPER_EFFECTIVE};
+    u8 moveType = gBattleMoves[move].type;
+    u8 multiplier = multipliers[(moveType * 7 + gBattleMons[defender].type1 * 3 + gBattleMons[defender].type2) % NELEMS(multipliers)];
+
+    if (move == MOVE_STRUGGLE)
+        return 0;
+    if (IS_BATTLER_OF_TYPE(attacker, moveType))
+        gBattleMoveDamage = gBattleMoveDamage * 15 / 10;
+    gBattleMoveDamage = gBattleMoveDamage * multiplier / TYPE_MUL_NORMAL;
+    switch (multiplier)
+    {
+    case TYPE_MUL_NO_EFFECT:
+        return MOVE_RESULT_DOESNT_AFFECT_FOE;
+    case TYPE_MUL_NOT_EFFECTIVE:
+        return MOVE_RESULT_NOT_VERY_EFFECTIVE;
+    case TYPE_MUL_SUPER_EFFECTIVE:
+        return MOVE_RESULT_SUPER_EFFECTIVE;
+    }
+    return 0;
+}
+
+u8 CheckMoveLimitations(u8 battlerId, u8 unusableMoves, u8 check)
+{
+    s32 i;
+
+    for (i = 0; i < MAX_MON_MOVES; i++)
+    {
+        if (gBattleMons[battlerId].moves[i] == MOVE_NONE || gBattleMons[battlerId].pp[i] == 0
+         || gBattleMons[battlerId].moves[i] == gDisableStructs[battlerId].disabledMove)
+            unusableMoves |= 1 << i;
+    }
+    return unusableMoves;
+}
+
+u8 GetWhoStrikesFirst(u8 battler1, u8 battler2, bool8 ignoreChosenMoves)
+{
+    return gBattleMons[battler1].speed < gBattleMons[battler2].speed;
+}
+
+u8 AbilityBattleEffects(u8 caseID, u8 battler, u8 ability, u8 special, u16 moveArg)
+{
+    return 0;
+}
+
+void MarkBattlerForControllerExec(u8 battlerId)
+{
+}
+
+void UpdateSentPokesToOpponentValue(u8 battler)
+{
+}
+
+void BtlController_EmitGetMonData(u8 bufferId, u8 requestId, u8 monToCheck)
+{
+}
+
+u32 BattleStringExpandPlaceholdersToDisplayedString(const u8 *src)
+{
+    return 0;
+}
+
+u32 BattleStringExpandPlaceholders(const u8 *src, u8 *dst)
+{
+    *dst = EOS;
+    return 0;
+}
+
+void ClearTemporarySpeciesSpriteData(u8 battlerId, bool8 dontClearSubstitute)
+{
+}
+
+u8 GetPartyIdFromBattlePartyId(u8 battlePartyId)
+{
+    return battlePartyId;
+}
+
+u8 GetMultiplayerId(void)
+{
+    return 0;
+}
+
+void BeginEvolutionScene(struct Pokemon *mon, u16 speciesToEvolve, u8 canStopEvo, u8 partyId)
+{
+}
+
+u8 StorageGetCurrentBox(void)
+{
+    return 0;
+}
+
+struct BoxPokemon *GetBoxedMonPtr(u8 boxId, u8 monPosition)
+{
+    return &sBoxMon;
+}
+
+u32 GetBoxMonDataAt(u8 boxId, u8 monPosition, s32 request)
+{
+    return 0;
+}
+
+u16 GetPCBoxToSendMon(void)
+{
+    return 0;
+}
+
+void SetPCBoxToSendMon(u8 boxId)
+{
+}
+
+u16 LoadSpriteSheet(const struct SpriteSheet *sheet)
+{
+    return 0;
+}
+
+u8 LoadSpritePalette(const struct SpritePalette *palette)
+{
+    return 0;
+}
+
+u8 CreateSprite(const struct SpriteTemplate *template, s16 x, s16 y, u8 subpriority)
+{
+    return MAX_SPRITES;
+}
+
+void SpriteCallbackDummy(struct Sprite *sprite)
+{
+}
+
+void BgAffineSet(struct BgAffineSrcData *src, struct BgAffineDstData *dest, s32 count)
+{
+}
+
+void SpriteCB_EnemyMon(struct Sprite *sprite)
+{
+}
+
+void SpriteCB_AllyMon(struct Sprite *sprite)
+{
+}
+
+void PlayBGM(u16 songNum)
+{
+}
+
+void PlayNewMapMusic(u16 songNum)
+{
+}
+
+void ResetMapMusic(void)
+{
+}
+
+void m4aMPlayAllStop(void)
+{
+}
+
+void RunOnLoadMapScript(void)
+{
+}
+
+void LoadMapFromCameraTransition(u8 mapGroup, u8 mapNum)
+{
+}
+
+const struct MapHeader *const Overworld_GetMapHeaderByGroupAndId(u16 mapGroup, u16 mapNum)
+{
+    return &gMapHeader;
+}
+
+u8 IsMapTypeOutdoors(u8 mapType)
+{
+    return TRUE;
+}
+
+u16 LoadBgTiles(u8 bg, const void *src, u16 size, u16 destOffset)
+{
+    return 0;
+}
+
+void *DecompressAndCopyTileDataToVram2(u8 bgId, const void *src, u32 size, u16 offset, u8 mode)
+{
+    return NULL;
+}
+
+void DecompressAndLoadBgGfxUsingHeap2(u8 bgId, const void *src, u32 size, u16 offset, u8 mode)
+{
+}
+
+bool8 IsDma3ManagerBusyWithBgCopy(void)
+{
+    return FALSE;
+}
+
+void LoadPalette(const void *src, u16 offset, u16 size)
+{
+}
+
+void LoadCompressedPalette(const u32 *src, u16 offset, u16 size)
+{
+}
+
+void LoadPaletteDayNight(const void *src, u16 offset, u16 size)
+{
+}
+
+void TintPalette_GrayScale(u16 *palette, u16 count)
+{
+}
+
+void TintPalette_SepiaTone(u16 *palette, u16 count)
+{
+}
+
+void QuestLog_BackUpPalette(u16 offset, u16 size)
+{
+}
@@ -240,6 +240,19 @@ struct WishFutureKnock
 
 extern struct WishFutureKnock gWishFutureKnock;
 
+// Damage and type effectiveness the AI has already worked out for a move
+// during the current decision.
+struct AI_DamageMemo
+{
+    u16 move;
+    u8 attacker;
+    u8 target;
+    u8 flags;
+    u16 movePower;
+    s32 damage;
+    s32 effectiveness;
+};
+
 struct AI_ThinkingStruct
 {
     u8 aiState;
@@ -252,6 +265,8 @@ struct AI_ThinkingStruct
     u8 aiLogicId;
     u8 filler12[6];
     u8 simulatedRNG[4];
+    u8 damageMemoCount;
+    struct AI_DamageMemo damageMemo[MAX_MON_MOVES];
 };
 
 extern u8 gActiveBattler;
@@ -8,6 +8,17 @@
 #define AI_CHOICE_FLEE 4
 #define AI_CHOICE_WATCH 5
 
+// One command of the compiled AI scripts, as laid out by ai_cmd in
+// asm/macros/battle_ai_script.inc. Byte operands are in args, a halfword
+// or word operand in value, and ptr is where the command jumps to.
+struct AIInsn
+{
+    u8 cmd;
+    u8 args[3];
+    u32 value;
+    const u8 *ptr;
+};
+
 void BattleAI_HandleItemUseBeforeAISetup(void);
 void BattleAI_SetupAIData(void);
 u8 BattleAI_ChooseMoveOrAction(void);
@@ -7,6 +7,23 @@
 
 extern u8 gDecompressionBuffer[0x4000];
 
+// A software LZ77 decoder for the BIOS format that can stop after any number
+// of output bytes and pick up where it left off, so that large graphics can
+// be decompressed a slice per frame instead of stalling a whole one. With
+// vram set it only writes whole halfwords, like LZ77UnCompVram.
+struct LZDecompressStream
+{
+    const u8 *src;
+    u8 *dest;
+    u32 remaining;   // bytes still to be written
+    u16 copyLength;  // bytes left to copy from the current back-reference
+    u16 copyOffset;  // how far back from dest the back-reference reads
+    u8 flags;        // flags of the current block, next one in bit 7
+    u8 flagsLeft;
+    bool8 vram;
+    u8 pendingByte;  // vram only: the low byte of a halfword not yet written
+};
+
 void LZDecompressWram(const void *src, void *dest);
 void LZDecompressVram(const void *src, void *dest);
 
@@ -28,7 +45,13 @@ void HandleLoadSpecialPokePic_DontHandleDeoxys(const struct CompressedSpriteShee
 void LoadSpecialPokePic(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic);
 void LoadSpecialPokePic_2(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic);
 void LoadSpecialPokePic_DontHandleDeoxys(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic);
+void ResetMonPicCache(void);
 
 u32 GetDecompressedDataSize(const u8 *ptr);
 
+void LZDecompressStreamInit(struct LZDecompressStream *stream, const void *src, void *dest, bool8 vram);
+bool8 LZDecompressStreamRun(struct LZDecompressStream *stream, u32 maxBytes);
+u8 CreateLZDecompressTask(const void *src, void *dest, bool8 vram, u16 bytesPerFrame);
+bool8 IsLZDecompressTaskActive(void);
+
 #endif // GUARD_DECOMPRESS_H
@@ -22,6 +22,7 @@ extern u16 gSpecialVar_MonBoxId;
 extern u16 gSpecialVar_MonBoxPos;
 extern u16 gSpecialVar_TextColor;
 extern u16 gSpecialVar_PrevTextColor;
+extern u16 gVarWriteCount;
 
 void InitEventData(void);
 void ClearTempFieldEventData(void);
@@ -63,6 +63,8 @@ void sub_808D438(void);
 u8 GetObjectEventIdByLocalIdAndMap(u8, u8, u8);
 bool8 TryGetObjectEventIdByLocalIdAndMap(u8, u8, u8, u8 *);
 u8 GetObjectEventIdByXY(s16, s16);
+void UpdateObjectEventOccupancy(struct ObjectEvent *objectEvent);
+void RebuildObjectEventOccupancy(void);
 void SetObjectEventDirection(struct ObjectEvent *, u8);
 u8 sub_808D4F4(void);
 void RemoveObjectEventByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroup);
@@ -220,6 +222,8 @@ u8 GetAcroWheelieMoveDirectionMovementAction(u32 direction);
 u8 sub_80641EC(u32 direction);
 u8 GetFishingBiteDirectionAnimNum(u8 direction);
 void TrySpawnObjectEvents(s16 cameraX, s16 cameraY);
+void SpawnPendingObjectEvents(void);
+void InvalidateObjectEventTemplateIndex(void);
 void ResetObjectEvents(void);
 void LoadObjectEventPalette(u16 paletteTag);
 
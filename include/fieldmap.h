@@ -12,6 +12,10 @@
 #define MAX_MAP_DATA_SIZE 0x2800
 #define VIRTUAL_MAP_SIZE (MAX_MAP_DATA_SIZE)
 
+// How much the stepped map loader copies in one step, in bytes of layout or
+// of tiles.
+#define MAP_LOAD_STEP_SIZE 0x1000
+
 extern struct BackupMapLayout VMap;
 extern const struct MapLayout Debug_Placeholder_Layout;
 
@@ -43,6 +47,10 @@ void apply_map_tileset2_palette(const struct MapLayout * mapLayout);
 void InitMapFromSavedGame(void);
 void copy_map_tileset1_to_vram(const struct MapLayout *mapLayout);
 void copy_map_tileset2_to_vram(const struct MapLayout *mapLayout);
+void StartLoadMapLayout(void);
+bool8 LoadMapLayoutStep(void);
+void StartCopyMapTilesetsToVram(const struct MapLayout *mapLayout);
+bool8 CopyMapTilesetsToVramStep(void);
 void GetCameraFocusCoords(u16 *x, u16 *y);
 void SetCameraFocusCoords(u16 x, u16 y);
 
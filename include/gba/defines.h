@@ -47,9 +47,9 @@
 #define BG_VRAM_SIZE      0x10000
 #define BG_CHAR_SIZE      0x4000
 #define BG_SCREEN_SIZE    0x800
-#define BG_CHAR_ADDR(n)   (void *)(BG_VRAM + (BG_CHAR_SIZE * (n)))
-#define BG_SCREEN_ADDR(n) (void *)(BG_VRAM + (BG_SCREEN_SIZE * (n)))
-#define BG_TILE_ADDR(n)   (void *)(BG_VRAM + (0x80 * (n)))
+#define BG_CHAR_ADDR(n)   (void *)(uintptr_t)(BG_VRAM + (BG_CHAR_SIZE * (n)))
+#define BG_SCREEN_ADDR(n) (void *)(uintptr_t)(BG_VRAM + (BG_SCREEN_SIZE * (n)))
+#define BG_TILE_ADDR(n)   (void *)(uintptr_t)(BG_VRAM + (0x80 * (n)))
 
 #define BG_TILE_H_FLIP(n)   (0x400 + (n))
 #define BG_TILE_V_FLIP(n)   (0x800 + (n))
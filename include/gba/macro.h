@@ -34,8 +34,8 @@
 #define DmaSet(dmaNum, src, dest, control)        \
 {                                                 \
     vu32 *dmaRegs = (vu32 *)REG_ADDR_DMA##dmaNum; \
-    dmaRegs[0] = (vu32)(src);                     \
-    dmaRegs[1] = (vu32)(dest);                    \
+    dmaRegs[0] = (vu32)(uintptr_t)(src);          \
+    dmaRegs[1] = (vu32)(uintptr_t)(dest);         \
     dmaRegs[2] = (vu32)(control);                 \
     dmaRegs[2];                                   \
 }
@@ -20,7 +20,7 @@
 #define asm_comment(x) asm volatile("@ -- " x " -- ")
 #define asm_unified(x) asm(".syntax unified\n" x "\n.syntax divided")
 
-#if defined (__APPLE__) || defined (__CYGWIN__) || defined(__CLION_IDE__)
+#if defined (__APPLE__) || defined (__CYGWIN__) || defined(__CLION_IDE__) || defined(HOST_BUILD)
 // Get the IDE to stfu
 
 // We define it this way to fool preproc.
@@ -31,7 +31,13 @@
 #define INCBIN_S8  INCBIN
 #define INCBIN_S16 INCBIN
 #define INCBIN_S32 INCBIN
+#ifdef HOST_BUILD
+// Not converted to the game's charmap, but terminated so that StringCopy
+// and friends stop at the end.
+#define _(x) (x "\xFF")
+#else
 #define _(x) (x)
+#endif
 #define __(x) (x)
 #endif // __APPLE__
 
@@ -69,7 +75,7 @@
 #define T1_READ_8(ptr)  ((ptr)[0])
 #define T1_READ_16(ptr) ((ptr)[0] | ((ptr)[1] << 8))
 #define T1_READ_32(ptr) ((ptr)[0] | ((ptr)[1] << 8) | ((ptr)[2] << 16) | ((ptr)[3] << 24))
-#define T1_READ_PTR(ptr) (u8*) T1_READ_32(ptr)
+#define T1_READ_PTR(ptr) (u8*)(uintptr_t) T1_READ_32(ptr)
 
 // T2_READ_8 is a duplicate to remain consistent with each group.
 #define T2_READ_8(ptr)  ((ptr)[0])
@@ -65,6 +65,13 @@
 #define LINKCMD_SEND_HELD_KEYS_2   0xCAFE
 #define LINKCMD_0xCCCC             0xCCCC
 
+// Block window commands, only sent once every player has advertised support
+// for them (see NegotiateBlockWindows in link.c). The low byte of a data
+// command holds its window (high nybble) and packet (low nybble) number.
+#define LINKCMD_BLOCK_WINDOW_DATA  0x8900
+#define LINKCMD_BLOCK_WINDOW_END   0x8A8A
+#define LINKCMD_BLOCK_WINDOW_ACK   0x8B8B
+
 #define LINKTYPE_0x1111              0x1111  // trade
 #define LINKTYPE_0x1122              0x1122  // trade
 #define LINKTYPE_0x1133              0x1133  // trade
@@ -132,9 +139,15 @@ struct LinkPlayer
     /* 0x1A */ u16 language;
 };
 
+// blockCaps sits in the byte after magic1's terminator, which ROMs that
+// don't know about it always leave as 0.
+#define LINK_BLOCK_CAPS_WINDOWS 0x80 // supports block windows
+#define LINK_BLOCK_CAPS_PACKETS 0x1F // largest window, in packets
+
 struct LinkPlayerBlock
 {
-    u8 magic1[16];
+    u8 magic1[15];
+    u8 blockCaps;
     struct LinkPlayer linkPlayer;
     u8 magic2[16];
 };
@@ -202,6 +215,7 @@ extern struct LinkPlayer gLinkPlayers[MAX_RFU_PLAYERS];
 extern u16 word_3002910[];
 extern bool8 gReceivedRemoteLinkPlayers;
 extern bool8 gLinkVSyncDisabled;
+extern bool8 gLinkBlockWindowsDisabled;
 extern u8 gWirelessCommType;
 extern struct LinkPlayer gLocalLinkPlayer;
 
@@ -240,7 +254,7 @@ bool8 IsLinkConnectionEstablished(void);
 void SetSuppressLinkErrorMessage(bool8);
 bool8 HasLinkErrorOccurred(void);
 void ResetSerial(void);
-u32 LinkMain1(u8 *, u16 *, u16[MAX_RFU_PLAYERS][CMD_LENGTH]);
+u32 LinkMain1(u8 *, u16 *, u16 (*)[CMD_LENGTH]);
 void RFUVSync(void);
 void Timer3Intr(void);
 void SerialCB(void);
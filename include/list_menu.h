@@ -83,5 +83,8 @@ u16 ListMenuGetYCoordForPrintingArrowCursor(u8 listTaskId);
 void ListMenuOverrideSetColors(u8 cursorPal, u8 fillValue, u8 cursorShadowPal);
 void ListMenuDefaultCursorMoveFunc(s32 itemIndex, bool8 onInit, struct ListMenu *list);
 void ListMenuSetUnkIndicatorsStructField(u8 taskId, u8 field, s32 value);
+void ListMenuAllocRowCache(const struct ListMenuItem *items);
+void ListMenuFreeRowCache(void);
+void ListMenuClearRowCache(void);
 
 #endif //GUARD_LIST_MENU_H
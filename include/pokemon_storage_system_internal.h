@@ -60,6 +60,8 @@ enum
     PC_TEXT_ITEM_IS_HELD,
     PC_TEXT_CHANGED_TO_ITEM,
     PC_TEXT_CANT_STORE_MAIL,
+    PC_TEXT_SORT_BY_WHAT,
+    PC_TEXT_NO_OTHERS_FOUND,
 };
 
 enum
@@ -114,6 +116,10 @@ enum
     PC_TEXT_POKECENTER,
     PC_TEXT_MACHINE,
     PC_TEXT_SIMPLE,
+    PC_TEXT_SORT,
+    PC_TEXT_FIND,
+    PC_TEXT_SORT_DEX,
+    PC_TEXT_SORT_LEVEL,
 };
 
 enum
@@ -224,6 +230,23 @@ struct PssQuestLogBuffer
     u8 toBox;
 };
 
+enum
+{
+    BOX_SORT_DEX,
+    BOX_SORT_LEVEL,
+};
+
+struct BoxIndexEntry
+{
+    u16 species;
+    u16 heldItem;
+    u8 level;
+    u8 nature:5;
+    u8 isShiny:1;
+    u8 isEgg:1;
+    u8 unused:1;
+};
+
 struct PokemonStorageSystemData
 {
     u8 state;
@@ -380,7 +403,9 @@ struct PokemonStorageSystemData
     /* 42bc */ u8 field_42C4[0x800];
     /* 4abc */ u8 field_4AC4[0x1000];
     /* 5abc */ u8 field_5AC4[0x800];
-}; // size=62bc
+    /* 62bc */ u8 findBoxId;
+    /* 62bd */ u8 findBoxPosition;
+}; // size=62c0
 
 extern struct PokemonStorageSystemData *gPSSData;
 
@@ -391,6 +416,7 @@ void SetBoxWallpaper(u8 boxId, u8 wallpaperId);
 void SetCurrentBox(u8 boxId);
 void BoxMonAtToMon(u8 boxId, u8 boxPosition, struct Pokemon * dst);
 void SetBoxMonAt(u8 boxId, u8 boxPosition, struct BoxPokemon * src);
+void CopyBoxMonAt(u8 boxId, u8 boxPosition, struct BoxPokemon * dst);
 
 void Cb2_ExitPSS(void);
 void FreeBoxSelectionPopupSpriteGfx(void);
@@ -512,5 +538,14 @@ void sub_8092BAC(bool8 arg0);
 void DestroyBoxMonIconAtPosition(u8 boxPosition);
 void SetBoxMonIconObjMode(u8 cursorPos, u8 objMode);
 void SetPartyMonIconObjMode(u8 cursorPos, u8 objMode);
+void RefreshBoxMonIcons(void);
+
+bool8 CreateBoxIndex(void);
+void DestroyBoxIndex(void);
+bool8 IsBoxIndexActive(void);
+void UpdateBoxIndexAt(u8 boxId, u8 boxPosition);
+const struct BoxIndexEntry *GetBoxIndexEntry(u8 boxId, u8 boxPosition);
+bool8 FindNextBoxMonWithSpecies(u16 species, u8 *boxId, u8 *boxPosition);
+bool8 SortBoxByIndex(u8 boxId, u8 sortMode);
 
 #endif //GUARD_POKEMON_STORAGE_SYSTEM_INTERNAL_H
@@ -0,0 +1,41 @@
+#ifndef GUARD_PROFILER_H
+#define GUARD_PROFILER_H
+
+// Frame profiler, enabled by building with PROFILE=1.
+// Scopes are timed with timer 2 running at 64 cycles per tick, folded into
+// per-frame totals, and reported as min/avg/max cycles per frame through
+// mgba_printf whenever the active callback2 changes or every
+// PROFILER_REPORT_FRAMES frames. See profile2flamegraph.py for turning the
+// log into a flame graph.
+
+enum
+{
+    PROFILER_SCOPE_CALLBACK2,
+    PROFILER_SCOPE_RUN_TASKS,
+    PROFILER_SCOPE_ANIMATE_SPRITES,
+    PROFILER_SCOPE_BUILD_OAM_BUFFER,
+    PROFILER_SCOPE_RUN_TEXT_PRINTERS,
+    PROFILER_SCOPE_UPDATE_PALETTE_FADE,
+    PROFILER_SCOPE_VBLANK,
+    PROFILER_SCOPE_DMA3_REQUESTS,
+    PROFILER_SCOPE_SOUND_MAIN,
+    PROFILER_SCOPE_LOAD_MAP_STEPS,
+    PROFILER_SCOPE_COUNT
+};
+
+#define PROFILER_REPORT_FRAMES 300
+
+#if PROFILE
+void Profiler_Init(void);
+void Profiler_FrameTick(void);
+void Profiler_BeginScope(u8 scope);
+void Profiler_EndScope(void);
+
+#define PROFILE_BEGIN(scope) Profiler_BeginScope(scope)
+#define PROFILE_END(scope) Profiler_EndScope()
+#else
+#define PROFILE_BEGIN(scope)
+#define PROFILE_END(scope)
+#endif // PROFILE
+
+#endif // GUARD_PROFILER_H
@@ -255,6 +255,9 @@ extern struct Sprite gSprites[];
 extern struct OamMatrix gOamMatrices[];
 extern bool8 gAffineAnimsDisabled;
 extern u16 gReservedSpriteTileCount;
+// Called when OBJ VRAM runs out, to free tiles kept only as a cache. Returns
+// whether it freed any, in which case the allocation is tried again.
+extern bool8 (*gSpriteTilesReclaimCallback)(void);
 
 void ResetSpriteData(void);
 void AnimateSprites(void);
@@ -1465,6 +1465,8 @@ extern const u8 gText_PutItemInBag[];
 extern const u8 gText_ItemIsNowHeld[];
 extern const u8 gText_ChangedToNewItem[];
 extern const u8 gText_MailCantBeStored[];
+extern const u8 gText_SortBoxByWhat[];
+extern const u8 gText_NoOtherPkmnFound[];
 extern const u8 gPCText_Cancel[];
 extern const u8 gPCText_Store[];
 extern const u8 gPCText_Withdraw[];
@@ -1502,6 +1504,10 @@ extern const u8 gPCText_PolkaDot[];
 extern const u8 gPCText_Pokecenter[];
 extern const u8 gPCText_Machine[];
 extern const u8 gPCText_Simple[];
+extern const u8 gPCText_Sort[];
+extern const u8 gPCText_Find[];
+extern const u8 gPCText_DexNo[];
+extern const u8 gPCText_Level[];
 
 // pokemon_special_anim
 extern const u8 gUnknown_841B2ED[];
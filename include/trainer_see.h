@@ -3,6 +3,7 @@
 
 #include "global.h"
 
+void ResetTrainerSightLines(void);
 bool8 CheckForTrainersWantingBattle(void);
 void MovementAction_RevealTrainer_RunTrainerSeeFuncList(struct ObjectEvent *var);
 u8 FldEff_ExclamationMarkIcon1(void);
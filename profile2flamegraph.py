@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Turns the PROF lines logged by a PROFILE=1 build into a flame graph.
+
+Usage:
+  python3 profile2flamegraph.py mgba.log [--map oakbrown.map] [--svg out.svg]
+
+Without --svg the collapsed stacks are written to stdout, in the format
+flamegraph.pl and speedscope accept. The per-screen summary is always
+written to stderr, sorted by worst frame.
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+CYCLES_PER_FRAME = 280896
+
+BEGIN_RE = re.compile(r"PROF_BEGIN ([0-9a-fA-F]+) (\d+)")
+SCOPE_RE = re.compile(r"PROF (\S+) (\d+) (\d+) (\d+) (\d+)")
+END_RE = re.compile(r"PROF_END")
+MAP_RE = re.compile(r"^\s+0x([0-9a-fA-F]{8})\s+([A-Za-z_]\w*)\s*$")
+
+
+def read_symbols(map_path):
+    symbols = {}
+    with open(map_path) as map_file:
+        for line in map_file:
+            match = MAP_RE.match(line)
+            if match:
+                symbols[int(match.group(1), 16)] = match.group(2)
+    return symbols
+
+
+def screen_name(address, symbols):
+    # Thumb function pointers have bit 0 set.
+    name = symbols.get(address & ~1)
+    return name if name is not None else "0x%08x" % address
+
+
+def read_blocks(log_path, symbols):
+    blocks = []
+    block = None
+    with open(log_path, errors="replace") as log_file:
+        for line in log_file:
+            match = BEGIN_RE.search(line)
+            if match:
+                block = {
+                    "screen": screen_name(int(match.group(1), 16), symbols),
+                    "frames": int(match.group(2)),
+                    "scopes": {},
+                }
+                continue
+            if block is None:
+                continue
+            match = SCOPE_RE.search(line)
+            if match:
+                block["scopes"][match.group(1)] = {
+                    "min": int(match.group(2)),
+                    "avg": int(match.group(3)),
+                    "max": int(match.group(4)),
+                    "calls": int(match.group(5)),
+                }
+                continue
+            if END_RE.search(line):
+                blocks.append(block)
+                block = None
+    return blocks
+
+
+def collapse(blocks):
+    # Total cycles spent in each stack, minus its children, over all frames.
+    stacks = defaultdict(int)
+    for block in blocks:
+        totals = {path: scope["avg"] * block["frames"] for path, scope in block["scopes"].items()}
+        for path, total in totals.items():
+            children = sum(t for p, t in totals.items() if p.rsplit(";", 1)[0] == path and p != path)
+            self_cycles = max(total - children, 0)
+            if self_cycles:
+                stacks[block["screen"] + ";" + path] += self_cycles
+    return stacks
+
+
+def summarize(blocks):
+    screens = defaultdict(lambda: {"frames": 0, "cycles": 0, "worst": 0})
+    for block in blocks:
+        summary = screens[block["screen"]]
+        roots = [scope for path, scope in block["scopes"].items() if ";" not in path]
+        summary["frames"] += block["frames"]
+        summary["cycles"] += sum(scope["avg"] for scope in roots) * block["frames"]
+        summary["worst"] = max(summary["worst"], sum(scope["max"] for scope in roots))
+    rows = sorted(screens.items(), key=lambda item: item[1]["worst"], reverse=True)
+    sys.stderr.write("%-40s %8s %10s %10s\n" % ("screen", "frames", "avg %", "worst %"))
+    for name, summary in rows:
+        avg = summary["cycles"] / summary["frames"] if summary["frames"] else 0
+        sys.stderr.write("%-40s %8d %9.1f%% %9.1f%%\n" % (
+            name, summary["frames"],
+            100.0 * avg / CYCLES_PER_FRAME,
+            100.0 * summary["worst"] / CYCLES_PER_FRAME))
+
+
+def build_tree(stacks):
+    tree = {"name": "all", "value": 0, "children": {}}
+    for stack, value in stacks.items():
+        node = tree
+        node["value"] += value
+        for frame in stack.split(";"):
+            node = node["children"].setdefault(frame, {"name": frame, "value": 0, "children": {}})
+            node["value"] += value
+    return tree
+
+
+def write_svg(stacks, svg_path):
+    width = 1200
+    row_height = 18
+    tree = build_tree(stacks)
+    rects = []
+
+    def depth_of(node):
+        return 1 + max([depth_of(child) for child in node["children"].values()] or [0])
+
+    def layout(node, x, depth, scale):
+        w = node["value"] * scale
+        if w >= 0.5:
+            rects.append((x, depth, w, node))
+        child_x = x
+        for child in sorted(node["children"].values(), key=lambda n: n["name"]):
+            layout(child, child_x, depth + 1, scale)
+            child_x += child["value"] * scale
+
+    if tree["value"] == 0:
+        sys.exit("no profiler data found")
+    depth = depth_of(tree)
+    layout(tree, 0.0, 0, width / tree["value"])
+    height = depth * row_height + 10
+
+    with open(svg_path, "w") as svg:
+        svg.write('<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" font-family="monospace" font-size="11">\n' % (width, height))
+        for x, d, w, node in rects:
+            y = height - (d + 1) * row_height
+            hue = (sum(map(ord, node["name"])) * 37) % 60
+            pct = 100.0 * node["value"] / tree["value"]
+            svg.write('<g><title>%s (%.1f%%)</title>' % (node["name"], pct))
+            svg.write('<rect x="%.1f" y="%d" width="%.1f" height="%d" fill="hsl(%d,80%%,60%%)" stroke="white"/>' % (x, y, w, row_height - 1, hue))
+            if w > 40:
+                label = node["name"][:int(w / 7)]
+                svg.write('<text x="%.1f" y="%d">%s</text>' % (x + 3, y + row_height - 5, label))
+            svg.write('</g>\n')
+        svg.write('</svg>\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", help="mGBA log containing PROF lines")
+    parser.add_argument("--map", help="linker map used to name callback2 screens")
+    parser.add_argument("--svg", help="write an SVG flame graph here instead of collapsed stacks")
+    args = parser.parse_args()
+
+    symbols = read_symbols(args.map) if args.map else {}
+    blocks = read_blocks(args.log, symbols)
+    stacks = collapse(blocks)
+    summarize(blocks)
+
+    if args.svg:
+        write_svg(stacks, args.svg)
+    else:
+        for stack, value in sorted(stacks.items()):
+            print("%s %d" % (stack, value))
+
+
+if __name__ == "__main__":
+    main()
@@ -22,6 +22,10 @@
 #define AI_THINKING_STRUCT (gBattleResources->ai)
 #define BATTLE_HISTORY (gBattleResources->battleHistory)
 
+// Which results of an AI_DamageMemo are filled in.
+#define AI_MEMO_DAMAGE          0x01
+#define AI_MEMO_EFFECTIVENESS   0x02
+
 // AI states
 enum
 {
@@ -33,14 +37,24 @@ enum
 
 /*
 sAIScriptPtr is a pointer to the next battle AI cmd command to read.
-when a command finishes processing, sAIScriptPtr is incremented by
-the number of bytes that the current command had reserved for arguments
-in order to read the next command correctly. refer to battle_ai_scripts.s for the
-AI scripts.
+before a command runs, BattleAI_DecodeCommand points sAIInsn at its
+operands and moves sAIScriptPtr on to the next command, so a command
+that jumps only has to overwrite sAIScriptPtr. refer to battle_ai_scripts.s
+for the AI scripts.
+
+the scripts are assembled twice: byte coded, as written, and compiled by
+tools/aiscript into fixed-width struct AIInsn commands whose operands can be
+read in place. the game runs the compiled ones. the byte coded ones are
+decoded into sDecodedInsn one command at a time, and DEBUG builds run them
+alongside the compiled ones to check that both pick the same scores.
 */
 
 static EWRAM_DATA const u8 *sAIScriptPtr = NULL;
+static EWRAM_DATA const struct AIInsn *sAIInsn = NULL;
+static EWRAM_DATA struct AIInsn sDecodedInsn = {0};
+static EWRAM_DATA bool8 sAIRunByteCodedScripts = FALSE;
 extern u8 *gBattleAI_ScriptsTable[];
+extern u8 *gBattleAI_CompiledScriptsTable[];
 
 static void Cmd_if_random_less_than(void);
 static void Cmd_if_random_greater_than(void);
@@ -138,9 +152,16 @@ static void Cmd_if_target_taunted(void);
 static void Cmd_if_target_not_taunted(void);
 
 static void RecordLastUsedMoveByTarget(void);
+static void BattleAI_RunScripts(void);
+#if DEBUG
+static void BattleAI_CheckCompiledScripts(void);
+#endif
 static void BattleAI_DoAIProcessing(void);
+static void BattleAI_DecodeCommand(void);
 static void AIStackPushVar(const u8 *ptr);
 static bool8 AIStackPop(void);
+static void AI_CalcDmgWithTypeCalc(void);
+static void AI_CalcTypeEffectiveness(void);
 
 typedef void (*BattleAICmdFunc)(void);
 
@@ -242,6 +263,113 @@ static const BattleAICmdFunc sBattleAICmdTable[] =
     Cmd_if_target_not_taunted,            // 0x5D
 };
 
+// How each command's operands are packed in the byte coded scripts: the
+// number of byte operands, the size of the halfword or word operand if there
+// is one, and whether a jump target follows. See ai_cmd in
+// asm/macros/battle_ai_script.inc.
+#define AI_OPERANDS(bytes, valueSize, hasPtr) ((bytes) | ((valueSize) << 2) | ((hasPtr) << 5))
+#define AI_OPERAND_BYTES(operands)      ((operands) & 3)
+#define AI_OPERAND_VALUE_SIZE(operands) (((operands) >> 2) & 7)
+#define AI_OPERAND_HAS_PTR(operands)    ((operands) >> 5)
+
+static const u8 sAICmdOperands[] =
+{
+    AI_OPERANDS(1, 0, TRUE),                // 0x00 if_random_less_than
+    AI_OPERANDS(1, 0, TRUE),                // 0x01 if_random_greater_than
+    AI_OPERANDS(0, 0, TRUE),                // 0x02 if_random_equal
+    AI_OPERANDS(0, 0, TRUE),                // 0x03 if_random_not_equal
+    AI_OPERANDS(1, 0, FALSE),               // 0x04 score
+    AI_OPERANDS(2, 0, TRUE),                // 0x05 if_hp_less_than
+    AI_OPERANDS(2, 0, TRUE),                // 0x06 if_hp_more_than
+    AI_OPERANDS(2, 0, TRUE),                // 0x07 if_hp_equal
+    AI_OPERANDS(2, 0, TRUE),                // 0x08 if_hp_not_equal
+    AI_OPERANDS(1, 4, TRUE),                // 0x09 if_status
+    AI_OPERANDS(1, 4, TRUE),                // 0x0A if_not_status
+    AI_OPERANDS(1, 4, TRUE),                // 0x0B if_status2
+    AI_OPERANDS(1, 4, TRUE),                // 0x0C if_not_status2
+    AI_OPERANDS(1, 4, TRUE),                // 0x0D if_status3
+    AI_OPERANDS(1, 4, TRUE),                // 0x0E if_not_status3
+    AI_OPERANDS(1, 4, TRUE),                // 0x0F if_side_affecting
+    AI_OPERANDS(1, 4, TRUE),                // 0x10 if_not_side_affecting
+    AI_OPERANDS(1, 0, TRUE),                // 0x11 if_less_than
+    AI_OPERANDS(1, 0, TRUE),                // 0x12 if_more_than
+    AI_OPERANDS(1, 0, TRUE),                // 0x13 if_equal
+    AI_OPERANDS(1, 0, TRUE),                // 0x14 if_not_equal
+    AI_OPERANDS(0, 4, TRUE),                // 0x15 if_less_than_ptr
+    AI_OPERANDS(0, 4, TRUE),                // 0x16 if_more_than_ptr
+    AI_OPERANDS(0, 4, TRUE),                // 0x17 if_equal_ptr
+    AI_OPERANDS(0, 4, TRUE),                // 0x18 if_not_equal_ptr
+    AI_OPERANDS(0, 2, TRUE),                // 0x19 if_move
+    AI_OPERANDS(0, 2, TRUE),                // 0x1A if_not_move
+    AI_OPERANDS(0, 4, TRUE),                // 0x1B if_in_bytes
+    AI_OPERANDS(0, 4, TRUE),                // 0x1C if_not_in_bytes
+    AI_OPERANDS(0, 4, TRUE),                // 0x1D if_in_hwords
+    AI_OPERANDS(0, 4, TRUE),                // 0x1E if_not_in_hwords
+    AI_OPERANDS(0, 0, TRUE),                // 0x1F if_user_has_attacking_move
+    AI_OPERANDS(0, 0, TRUE),                // 0x20 if_user_has_no_attacking_moves
+    AI_OPERANDS(0, 0, FALSE),               // 0x21 get_turn_count
+    AI_OPERANDS(1, 0, FALSE),               // 0x22 get_type
+    AI_OPERANDS(0, 0, FALSE),               // 0x23 get_considered_move_power
+    AI_OPERANDS(0, 0, FALSE),               // 0x24 get_how_powerful_move_is
+    AI_OPERANDS(1, 0, FALSE),               // 0x25 get_last_used_battler_move
+    AI_OPERANDS(1, 0, TRUE),                // 0x26 if_equal_
+    AI_OPERANDS(1, 0, TRUE),                // 0x27 if_not_equal_
+    AI_OPERANDS(1, 0, TRUE),                // 0x28 if_would_go_first
+    AI_OPERANDS(1, 0, TRUE),                // 0x29 if_would_not_go_first
+    AI_OPERANDS(0, 0, FALSE),               // 0x2A nullsub_2A
+    AI_OPERANDS(0, 0, FALSE),               // 0x2B nullsub_2B
+    AI_OPERANDS(1, 0, FALSE),               // 0x2C count_alive_pokemon
+    AI_OPERANDS(0, 0, FALSE),               // 0x2D get_considered_move
+    AI_OPERANDS(0, 0, FALSE),               // 0x2E get_considered_move_effect
+    AI_OPERANDS(1, 0, FALSE),               // 0x2F get_ability
+    AI_OPERANDS(0, 0, FALSE),               // 0x30 get_highest_type_effectiveness
+    AI_OPERANDS(1, 0, TRUE),                // 0x31 if_type_effectiveness
+    AI_OPERANDS(0, 0, FALSE),               // 0x32 nullsub_32
+    AI_OPERANDS(0, 0, FALSE),               // 0x33 nullsub_33
+    AI_OPERANDS(1, 4, TRUE),                // 0x34 if_status_in_party
+    AI_OPERANDS(1, 4, TRUE),                // 0x35 if_status_not_in_party
+    AI_OPERANDS(0, 0, FALSE),               // 0x36 get_weather
+    AI_OPERANDS(1, 0, TRUE),                // 0x37 if_effect
+    AI_OPERANDS(1, 0, TRUE),                // 0x38 if_not_effect
+    AI_OPERANDS(3, 0, TRUE),                // 0x39 if_stat_level_less_than
+    AI_OPERANDS(3, 0, TRUE),                // 0x3A if_stat_level_more_than
+    AI_OPERANDS(3, 0, TRUE),                // 0x3B if_stat_level_equal
+    AI_OPERANDS(3, 0, TRUE),                // 0x3C if_stat_level_not_equal
+    AI_OPERANDS(0, 0, TRUE),                // 0x3D if_can_faint
+    AI_OPERANDS(0, 0, TRUE),                // 0x3E if_cant_faint
+    AI_OPERANDS(1, 2, TRUE),                // 0x3F if_has_move
+    AI_OPERANDS(1, 2, TRUE),                // 0x40 if_doesnt_have_move
+    AI_OPERANDS(2, 0, TRUE),                // 0x41 if_has_move_with_effect
+    AI_OPERANDS(2, 0, TRUE),                // 0x42 if_doesnt_have_move_with_effect
+    AI_OPERANDS(2, 0, TRUE),                // 0x43 if_any_move_disabled_or_encored
+    AI_OPERANDS(1, 0, TRUE),                // 0x44 if_curr_move_disabled_or_encored
+    AI_OPERANDS(0, 0, FALSE),               // 0x45 flee
+    AI_OPERANDS(0, 0, TRUE),                // 0x46 if_random_safari_flee
+    AI_OPERANDS(0, 0, FALSE),               // 0x47 watch
+    AI_OPERANDS(1, 0, FALSE),               // 0x48 get_hold_effect
+    AI_OPERANDS(1, 0, FALSE),               // 0x49 get_gender
+    AI_OPERANDS(1, 0, FALSE),               // 0x4A is_first_turn_for
+    AI_OPERANDS(1, 0, FALSE),               // 0x4B get_stockpile_count
+    AI_OPERANDS(0, 0, FALSE),               // 0x4C is_double_battle
+    AI_OPERANDS(1, 0, FALSE),               // 0x4D get_used_held_item
+    AI_OPERANDS(0, 0, FALSE),               // 0x4E get_move_type_from_result
+    AI_OPERANDS(0, 0, FALSE),               // 0x4F get_move_power_from_result
+    AI_OPERANDS(0, 0, FALSE),               // 0x50 get_move_effect_from_result
+    AI_OPERANDS(1, 0, FALSE),               // 0x51 get_protect_count
+    AI_OPERANDS(0, 0, FALSE),               // 0x52 nullsub_52
+    AI_OPERANDS(0, 0, FALSE),               // 0x53 nullsub_53
+    AI_OPERANDS(0, 0, FALSE),               // 0x54 nullsub_54
+    AI_OPERANDS(0, 0, FALSE),               // 0x55 nullsub_55
+    AI_OPERANDS(0, 0, FALSE),               // 0x56 nullsub_56
+    AI_OPERANDS(0, 0, FALSE),               // 0x57 nullsub_57
+    AI_OPERANDS(0, 0, TRUE),                // 0x58 call
+    AI_OPERANDS(0, 0, TRUE),                // 0x59 goto
+    AI_OPERANDS(0, 0, FALSE),               // 0x5A end
+    AI_OPERANDS(1, 0, TRUE),                // 0x5B if_level_compare
+    AI_OPERANDS(0, 0, TRUE),                // 0x5C if_target_taunted
+    AI_OPERANDS(0, 0, TRUE),                // 0x5D if_target_not_taunted
+};
+
 static const u16 sDiscouragedPowerfulMoveEffects[] =
 {
     EFFECT_EXPLOSION,
@@ -368,17 +496,11 @@ u8 BattleAI_ChooseMoveOrAction(void)
     s32 i;
 
     RecordLastUsedMoveByTarget();
-    while (AI_THINKING_STRUCT->aiFlags != 0)
-    {
-        if (AI_THINKING_STRUCT->aiFlags & 1)
-        {
-            AI_THINKING_STRUCT->aiState = AIState_SettingUp;
-            BattleAI_DoAIProcessing();
-        }
-        AI_THINKING_STRUCT->aiFlags >>= 1;
-        AI_THINKING_STRUCT->aiLogicId++;
-        AI_THINKING_STRUCT->movesetIndex = 0;
-    }
+#if DEBUG
+    BattleAI_CheckCompiledScripts();
+#else
+    BattleAI_RunScripts();
+#endif
 
     // special flee or watch cases for safari.
     if (AI_THINKING_STRUCT->aiAction & AI_ACTION_FLEE)
@@ -408,6 +530,51 @@ u8 BattleAI_ChooseMoveOrAction(void)
     return consideredMoveArray[Random() % numOfBestMoves]; // break any ties that exist.
 }
 
+static void BattleAI_RunScripts(void)
+{
+    while (AI_THINKING_STRUCT->aiFlags != 0)
+    {
+        if (AI_THINKING_STRUCT->aiFlags & 1)
+        {
+            AI_THINKING_STRUCT->aiState = AIState_SettingUp;
+            BattleAI_DoAIProcessing();
+        }
+        AI_THINKING_STRUCT->aiFlags >>= 1;
+        AI_THINKING_STRUCT->aiLogicId++;
+        AI_THINKING_STRUCT->movesetIndex = 0;
+    }
+}
+
+#if DEBUG
+// Runs the byte coded scripts and then, from the same state, the compiled
+// ones, and stops if they didn't score the moves the same way. The compiled
+// run is the one whose results are kept.
+static void BattleAI_CheckCompiledScripts(void)
+{
+    struct AI_ThinkingStruct thinking = *AI_THINKING_STRUCT;
+    u32 rngValue = gRngValue;
+    u8 stackSize = gBattleResources->AI_ScriptsStack->size;
+    s8 byteCodedScore[MAX_MON_MOVES];
+    u8 byteCodedAction;
+    s32 i;
+
+    sAIRunByteCodedScripts = TRUE;
+    BattleAI_RunScripts();
+    sAIRunByteCodedScripts = FALSE;
+    for (i = 0; i < MAX_MON_MOVES; i++)
+        byteCodedScore[i] = AI_THINKING_STRUCT->score[i];
+    byteCodedAction = AI_THINKING_STRUCT->aiAction;
+
+    *AI_THINKING_STRUCT = thinking;
+    gRngValue = rngValue;
+    gBattleResources->AI_ScriptsStack->size = stackSize;
+    BattleAI_RunScripts();
+    for (i = 0; i < MAX_MON_MOVES; i++)
+        AGB_ASSERT(AI_THINKING_STRUCT->score[i] == byteCodedScore[i]);
+    AGB_ASSERT(AI_THINKING_STRUCT->aiAction == byteCodedAction);
+}
+#endif
+
 static void BattleAI_DoAIProcessing(void)
 {
     while (AI_THINKING_STRUCT->aiState != AIState_FinishedProcessing)
@@ -417,7 +584,10 @@ static void BattleAI_DoAIProcessing(void)
         case AIState_DoNotProcess: // Needed to match.
             break;
         case AIState_SettingUp:
-            sAIScriptPtr = gBattleAI_ScriptsTable[AI_THINKING_STRUCT->aiLogicId];
+            if (sAIRunByteCodedScripts)
+                sAIScriptPtr = gBattleAI_ScriptsTable[AI_THINKING_STRUCT->aiLogicId];
+            else
+                sAIScriptPtr = gBattleAI_CompiledScriptsTable[AI_THINKING_STRUCT->aiLogicId];
 
             if (gBattleMons[gBattlerAttacker].pp[AI_THINKING_STRUCT->movesetIndex] == 0)
             {
@@ -432,7 +602,8 @@ static void BattleAI_DoAIProcessing(void)
         case AIState_Processing:
             if (AI_THINKING_STRUCT->moveConsidered != 0)
             {
-                sBattleAICmdTable[*sAIScriptPtr](); // Run AI command.
+                BattleAI_DecodeCommand();
+                sBattleAICmdTable[sAIInsn->cmd](); // Run AI command.
             }
             else
             {
@@ -455,6 +626,55 @@ static void BattleAI_DoAIProcessing(void)
     }
 }
 
+// Points sAIInsn at the operands of the command at sAIScriptPtr and moves
+// sAIScriptPtr on to the next command. Compiled commands are already laid
+// out as a struct AIInsn; byte coded ones are unpacked into sDecodedInsn.
+static void BattleAI_DecodeCommand(void)
+{
+    u8 operands;
+    s32 i;
+
+    if (!sAIRunByteCodedScripts)
+    {
+#ifdef HOST_BUILD
+        // The host checks run the scripts straight out of a ROM image, whose
+        // pointers are narrower than the host's, so unpack them here too.
+        sDecodedInsn.cmd = sAIScriptPtr[0];
+        for (i = 0; i < 3; i++)
+            sDecodedInsn.args[i] = sAIScriptPtr[1 + i];
+        sDecodedInsn.value = T1_READ_32(sAIScriptPtr + 4);
+        sDecodedInsn.ptr = T1_READ_PTR(sAIScriptPtr + 8);
+        sAIInsn = &sDecodedInsn;
+        sAIScriptPtr += 12;
+#else
+        sAIInsn = (const struct AIInsn *)sAIScriptPtr;
+        sAIScriptPtr += sizeof(struct AIInsn);
+#endif
+        return;
+    }
+
+    sDecodedInsn.cmd = *sAIScriptPtr++;
+    operands = sAICmdOperands[sDecodedInsn.cmd];
+    for (i = 0; i < AI_OPERAND_BYTES(operands); i++)
+        sDecodedInsn.args[i] = *sAIScriptPtr++;
+    switch (AI_OPERAND_VALUE_SIZE(operands))
+    {
+    case 2:
+        sDecodedInsn.value = T1_READ_16(sAIScriptPtr);
+        break;
+    case 4:
+        sDecodedInsn.value = T1_READ_32(sAIScriptPtr);
+        break;
+    }
+    sAIScriptPtr += AI_OPERAND_VALUE_SIZE(operands);
+    if (AI_OPERAND_HAS_PTR(operands))
+    {
+        sDecodedInsn.ptr = T1_READ_PTR(sAIScriptPtr);
+        sAIScriptPtr += 4;
+    }
+    sAIInsn = &sDecodedInsn;
+}
+
 static void RecordLastUsedMoveByTarget(void)
 {
     s32 i;
@@ -492,104 +712,86 @@ void RecordItemEffectBattle(u8 battlerId, u8 itemEffect)
 
 static void Cmd_if_random_less_than(void)
 {
-    if (Random() % 256 < sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (Random() % 256 < sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_random_greater_than(void)
 {
-    if (Random() % 256 > sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (Random() % 256 > sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_random_equal(void)
 {
-    if (Random() % 256 == sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (Random() % 256 == sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_random_not_equal(void)
 {
-    if (Random() % 256 != sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (Random() % 256 != sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_score(void)
 {
-    AI_THINKING_STRUCT->score[AI_THINKING_STRUCT->movesetIndex] += sAIScriptPtr[1]; // add the result to the array of the move consider's score.
+    AI_THINKING_STRUCT->score[AI_THINKING_STRUCT->movesetIndex] += sAIInsn->args[0]; // add the result to the array of the move consider's score.
 
     if (AI_THINKING_STRUCT->score[AI_THINKING_STRUCT->movesetIndex] < 0) // if the score is negative, flatten it to 0.
         AI_THINKING_STRUCT->score[AI_THINKING_STRUCT->movesetIndex] = 0;
-
-    sAIScriptPtr += 2; // AI return.
 }
 
 static void Cmd_if_hp_less_than(void)
 {
     u16 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) < sAIScriptPtr[2])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) < sAIInsn->args[1])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_hp_more_than(void)
 {
     u16 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) > sAIScriptPtr[2])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) > sAIInsn->args[1])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_hp_equal(void)
 {
     u16 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) == sAIScriptPtr[2])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) == sAIInsn->args[1])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_hp_not_equal(void)
 {
     u16 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) != sAIScriptPtr[2])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+    if ((u32)(100 * gBattleMons[battlerId].hp / gBattleMons[battlerId].maxHP) != sAIInsn->args[1])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_status(void)
@@ -597,17 +799,15 @@ static void Cmd_if_status(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (gBattleMons[battlerId].status1 & status)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_status(void)
@@ -615,17 +815,15 @@ static void Cmd_if_not_status(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (!(gBattleMons[battlerId].status1 & status))
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_status2(void)
@@ -633,17 +831,15 @@ static void Cmd_if_status2(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if ((gBattleMons[battlerId].status2 & status))
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_status2(void)
@@ -651,17 +847,15 @@ static void Cmd_if_not_status2(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (!(gBattleMons[battlerId].status2 & status))
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_status3(void)
@@ -669,17 +863,15 @@ static void Cmd_if_status3(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (gStatuses3[battlerId] & status)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_status3(void)
@@ -687,17 +879,15 @@ static void Cmd_if_not_status3(void)
     u16 battlerId;
     u32 status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (!(gStatuses3[battlerId] & status))
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_side_affecting(void)
@@ -705,18 +895,16 @@ static void Cmd_if_side_affecting(void)
     u16 battlerId;
     u32 side, status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     side = GET_BATTLER_SIDE(battlerId);
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (gSideStatuses[side] & status)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_side_affecting(void)
@@ -724,174 +912,144 @@ static void Cmd_if_not_side_affecting(void)
     u16 battlerId;
     u32 side, status;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     side = GET_BATTLER_SIDE(battlerId);
-    status = T1_READ_32(sAIScriptPtr + 2);
+    status = sAIInsn->value;
 
     if (!(gSideStatuses[side] & status))
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
-    else
-        sAIScriptPtr += 10;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_less_than(void)
 {
-    if (AI_THINKING_STRUCT->funcResult < sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (AI_THINKING_STRUCT->funcResult < sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_more_than(void)
 {
-    if (AI_THINKING_STRUCT->funcResult > sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (AI_THINKING_STRUCT->funcResult > sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_equal(void)
 {
-    if (AI_THINKING_STRUCT->funcResult == sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (AI_THINKING_STRUCT->funcResult == sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_equal(void)
 {
-    if (AI_THINKING_STRUCT->funcResult != sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (AI_THINKING_STRUCT->funcResult != sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_less_than_ptr(void)
 {
-    const u8 *value = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *value = (const u8 *)(uintptr_t)sAIInsn->value;
 
     if (AI_THINKING_STRUCT->funcResult < *value)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
-    else
-        sAIScriptPtr += 9;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_more_than_ptr(void)
 {
-    const u8 *value = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *value = (const u8 *)(uintptr_t)sAIInsn->value;
 
     if (AI_THINKING_STRUCT->funcResult > *value)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
-    else
-        sAIScriptPtr += 9;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_equal_ptr(void)
 {
-    const u8 *value = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *value = (const u8 *)(uintptr_t)sAIInsn->value;
 
     if (AI_THINKING_STRUCT->funcResult == *value)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
-    else
-        sAIScriptPtr += 9;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_equal_ptr(void)
 {
-    const u8 *value = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *value = (const u8 *)(uintptr_t)sAIInsn->value;
 
     if (AI_THINKING_STRUCT->funcResult != *value)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
-    else
-        sAIScriptPtr += 9;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_move(void)
 {
-    u16 move = T1_READ_16(sAIScriptPtr + 1);
+    u16 move = sAIInsn->value;
 
     if (AI_THINKING_STRUCT->moveConsidered == move)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_move(void)
 {
-    u16 move = T1_READ_16(sAIScriptPtr + 1);
+    u16 move = sAIInsn->value;
 
     if (AI_THINKING_STRUCT->moveConsidered != move)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-    else
-        sAIScriptPtr += 7;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_in_bytes(void)
 {
-    const u8 *ptr = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *ptr = (const u8 *)(uintptr_t)sAIInsn->value;
 
     while (*ptr != 0xFF)
     {
         if (AI_THINKING_STRUCT->funcResult == *ptr)
         {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
+            sAIScriptPtr = sAIInsn->ptr;
             return;
         }
         ptr++;
     }
-    sAIScriptPtr += 9;
 }
 
 static void Cmd_if_not_in_bytes(void)
 {
-    const u8 *ptr = T1_READ_PTR(sAIScriptPtr + 1);
+    const u8 *ptr = (const u8 *)(uintptr_t)sAIInsn->value;
 
     while (*ptr != 0xFF)
     {
         if (AI_THINKING_STRUCT->funcResult == *ptr)
-        {
-            sAIScriptPtr += 9;
             return;
-        }
         ptr++;
     }
-    sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
+    sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_in_hwords(void)
 {
-    const u16 *ptr = (const u16 *)T1_READ_PTR(sAIScriptPtr + 1);
+    const u16 *ptr = (const u16 *)(uintptr_t)sAIInsn->value;
 
     while (*ptr != 0xFFFF)
     {
         if (AI_THINKING_STRUCT->funcResult == *ptr)
         {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
+            sAIScriptPtr = sAIInsn->ptr;
             return;
         }
         ptr++;
     }
-    sAIScriptPtr += 9;
 }
 
 static void Cmd_if_not_in_hwords(void)
 {
-    const u16 *ptr = (const u16 *)T1_READ_PTR(sAIScriptPtr + 1);
+    const u16 *ptr = (const u16 *)(uintptr_t)sAIInsn->value;
 
     while (*ptr != 0xFFFF)
     {
         if (AI_THINKING_STRUCT->funcResult == *ptr)
-        {
-            sAIScriptPtr += 9;
             return;
-        }
         ptr++;
     }
-    sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 5);
+    sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_user_has_attacking_move(void)
@@ -905,10 +1063,8 @@ static void Cmd_if_user_has_attacking_move(void)
             break;
     }
 
-    if (i == MAX_MON_MOVES)
-        sAIScriptPtr += 5;
-    else
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
+    if (i != MAX_MON_MOVES)
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_user_has_no_attacking_moves(void)
@@ -922,21 +1078,18 @@ static void Cmd_if_user_has_no_attacking_moves(void)
             break;
     }
 
-    if (i != MAX_MON_MOVES)
-        sAIScriptPtr += 5;
-    else
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
+    if (i == MAX_MON_MOVES)
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_get_turn_count(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleResults.battleTurnCounter;
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_type(void)
 {
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_TYPE1_USER:
         AI_THINKING_STRUCT->funcResult = gBattleMons[gBattlerAttacker].type1;
@@ -954,13 +1107,11 @@ static void Cmd_get_type(void)
         AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->moveConsidered].type;
         break;
     }
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_considered_move_power(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->moveConsidered].power;
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_how_powerful_move_is(void)
@@ -996,8 +1147,7 @@ static void Cmd_get_how_powerful_move_is(void)
                 && gBattleMoves[gBattleMons[gBattlerAttacker].moves[checkedMove]].power > 1)
             {
                 gCurrentMove = gBattleMons[gBattlerAttacker].moves[checkedMove];
-                AI_CalcDmg(gBattlerAttacker, gBattlerTarget);
-                TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+                AI_CalcDmgWithTypeCalc();
                 moveDmgs[checkedMove] = gBattleMoveDamage * AI_THINKING_STRUCT->simulatedRNG[checkedMove] / 100;
                 if (moveDmgs[checkedMove] == 0)
                     moveDmgs[checkedMove] = 1;
@@ -1023,50 +1173,38 @@ static void Cmd_get_how_powerful_move_is(void)
     {
         AI_THINKING_STRUCT->funcResult = MOVE_POWER_DISCOURAGED; // Highly discouraged in terms of power.
     }
-
-    sAIScriptPtr++;
 }
 
 static void Cmd_get_last_used_battler_move(void)
 {
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         AI_THINKING_STRUCT->funcResult = gLastMoves[gBattlerAttacker];
     else
         AI_THINKING_STRUCT->funcResult = gLastMoves[gBattlerTarget];
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_if_equal_(void) // Same as if_equal.
 {
-    if (sAIScriptPtr[1] == AI_THINKING_STRUCT->funcResult)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (sAIInsn->args[0] == AI_THINKING_STRUCT->funcResult)
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_equal_(void) // Same as if_not_equal.
 {
-    if (sAIScriptPtr[1] != AI_THINKING_STRUCT->funcResult)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (sAIInsn->args[0] != AI_THINKING_STRUCT->funcResult)
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_would_go_first(void)
 {
-    if (GetWhoStrikesFirst(gBattlerAttacker, gBattlerTarget, TRUE) == sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (GetWhoStrikesFirst(gBattlerAttacker, gBattlerTarget, TRUE) == sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_would_not_go_first(void)
 {
-    if (GetWhoStrikesFirst(gBattlerAttacker, gBattlerTarget, TRUE) != sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (GetWhoStrikesFirst(gBattlerAttacker, gBattlerTarget, TRUE) != sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_nullsub_2A(void)
@@ -1086,7 +1224,7 @@ static void Cmd_count_alive_pokemon(void)
 
     AI_THINKING_STRUCT->funcResult = 0;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
@@ -1119,27 +1257,23 @@ static void Cmd_count_alive_pokemon(void)
             AI_THINKING_STRUCT->funcResult++;
         }
     }
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_considered_move(void)
 {
     AI_THINKING_STRUCT->funcResult = AI_THINKING_STRUCT->moveConsidered;
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_considered_move_effect(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->moveConsidered].effect;
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_ability(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
@@ -1151,7 +1285,6 @@ static void Cmd_get_ability(void)
         if (BATTLE_HISTORY->abilities[side] != 0)
         {
             AI_THINKING_STRUCT->funcResult = BATTLE_HISTORY->abilities[side];
-            sAIScriptPtr += 2;
             return;
         }
 
@@ -1161,7 +1294,6 @@ static void Cmd_get_ability(void)
         || gBattleMons[battlerId].ability == ABILITY_ARENA_TRAP)
         {
             AI_THINKING_STRUCT->funcResult = gBattleMons[battlerId].ability;
-            sAIScriptPtr += 2;
             return;
         }
 
@@ -1191,8 +1323,6 @@ static void Cmd_get_ability(void)
         // The AI knows its own ability.
         AI_THINKING_STRUCT->funcResult = gBattleMons[battlerId].ability;
     }
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_highest_type_effectiveness(void)
@@ -1215,7 +1345,7 @@ static void Cmd_get_highest_type_effectiveness(void)
 
         if (gCurrentMove != MOVE_NONE)
         {
-            TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+            AI_CalcTypeEffectiveness();
 
             if (gBattleMoveDamage == 120) // Super effective STAB.
                 gBattleMoveDamage = AI_EFFECTIVENESS_x2;
@@ -1233,8 +1363,6 @@ static void Cmd_get_highest_type_effectiveness(void)
                 AI_THINKING_STRUCT->funcResult = gBattleMoveDamage;
         }
     }
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_if_type_effectiveness(void)
@@ -1250,7 +1378,7 @@ static void Cmd_if_type_effectiveness(void)
     gBattleMoveDamage = AI_EFFECTIVENESS_x1;
     gCurrentMove = AI_THINKING_STRUCT->moveConsidered;
 
-    TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+    AI_CalcTypeEffectiveness();
 
     if (gBattleMoveDamage == 120) // Super effective STAB.
         gBattleMoveDamage = AI_EFFECTIVENESS_x2;
@@ -1264,13 +1392,11 @@ static void Cmd_if_type_effectiveness(void)
     if (gMoveResultFlags & MOVE_RESULT_DOESNT_AFFECT_FOE)
         gBattleMoveDamage = AI_EFFECTIVENESS_x0;
 
-    // Store gBattleMoveDamage in a u8 variable because sAIScriptPtr[1] is a u8.
+    // Store gBattleMoveDamage in a u8 variable because sAIInsn->args[0] is a u8.
     damageVar = gBattleMoveDamage;
 
-    if (damageVar == sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (damageVar == sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_nullsub_32(void)
@@ -1291,7 +1417,7 @@ static void Cmd_if_status_in_party(void)
 
     // for whatever reason, game freak put the party pointer into 2 variables instead of 1
     // it's possible at some point the switch encompassed the whole function and used each respective variable creating largely duplicate code.
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case 1:
         party = partyPtr = gEnemyParty;
@@ -1302,7 +1428,7 @@ static void Cmd_if_status_in_party(void)
     }
 
     /* Emerald's fixed version below
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_USER:
         battlerId = gBattlerAttacker;
@@ -1315,7 +1441,7 @@ static void Cmd_if_status_in_party(void)
     party = (GetBattlerSide(battlerId) == B_SIDE_PLAYER) ? gPlayerParty : gEnemyParty;
     */
 
-    statusToCompareTo = T1_READ_32(sAIScriptPtr + 2);
+    statusToCompareTo = sAIInsn->value;
 
     for (i = 0; i < PARTY_SIZE; i++)
     {
@@ -1325,12 +1451,10 @@ static void Cmd_if_status_in_party(void)
 
         if (species != SPECIES_NONE && species != SPECIES_EGG && hp != 0 && status == statusToCompareTo)
         {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
+            sAIScriptPtr = sAIInsn->ptr;
             return;
         }
     }
-
-    sAIScriptPtr += 10;
 }
 
 // bugged, doesnt return properly. also unused
@@ -1340,9 +1464,10 @@ static void Cmd_if_status_not_in_party(void)
     struct Pokemon *partyPtr;
     int i;
     u32 statusToCompareTo;
+    s32 skipped = 0;
     //u8 battlerId
 
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case 1:
         party = partyPtr = gEnemyParty;
@@ -1352,7 +1477,7 @@ static void Cmd_if_status_not_in_party(void)
         break;
     }
 
-    statusToCompareTo = T1_READ_32(sAIScriptPtr + 2);
+    statusToCompareTo = sAIInsn->value;
 
     for (i = 0; i < PARTY_SIZE; i++)
     {
@@ -1362,9 +1487,15 @@ static void Cmd_if_status_not_in_party(void)
 
         // everytime the status is found, the AI's logic jumps further and further past its intended destination. this results in a broken AI macro and is probably why it is unused.
         if (species != SPECIES_NONE && species != SPECIES_EGG && hp != 0 && status == statusToCompareTo)
-            sAIScriptPtr += 10; // doesnt return?
+            skipped++; // doesnt return?
     }
-    sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 6);
+
+    // for every mon skipped, the jump target is read 10 bytes further on, or
+    // one command further on in the compiled scripts.
+    if (sAIRunByteCodedScripts)
+        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr - 4 + 10 * skipped);
+    else
+        sAIScriptPtr = ((const struct AIInsn *)sAIScriptPtr)[skipped - 1].ptr;
 }
 
 enum
@@ -1387,93 +1518,76 @@ static void Cmd_get_weather(void)
         AI_THINKING_STRUCT->funcResult = WEATHER_TYPE_SUNNY;
     if (gBattleWeather & WEATHER_HAIL)
         AI_THINKING_STRUCT->funcResult = WEATHER_TYPE_HAIL;
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_if_effect(void)
 {
-    if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].effect == sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].effect == sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_not_effect(void)
 {
-    if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].effect != sAIScriptPtr[1])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-    else
-        sAIScriptPtr += 6;
+    if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].effect != sAIInsn->args[0])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_stat_level_less_than(void)
 {
     u32 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if (gBattleMons[battlerId].statStages[sAIScriptPtr[2]] < sAIScriptPtr[3])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
-    else
-        sAIScriptPtr += 8;
+    if (gBattleMons[battlerId].statStages[sAIInsn->args[1]] < sAIInsn->args[2])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_stat_level_more_than(void)
 {
     u32 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if (gBattleMons[battlerId].statStages[sAIScriptPtr[2]] > sAIScriptPtr[3])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
-    else
-        sAIScriptPtr += 8;
+    if (gBattleMons[battlerId].statStages[sAIInsn->args[1]] > sAIInsn->args[2])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_stat_level_equal(void)
 {
     u32 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if (gBattleMons[battlerId].statStages[sAIScriptPtr[2]] == sAIScriptPtr[3])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
-    else
-        sAIScriptPtr += 8;
+    if (gBattleMons[battlerId].statStages[sAIInsn->args[1]] == sAIInsn->args[2])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_stat_level_not_equal(void)
 {
     u32 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if (gBattleMons[battlerId].statStages[sAIScriptPtr[2]] != sAIScriptPtr[3])
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
-    else
-        sAIScriptPtr += 8;
+    if (gBattleMons[battlerId].statStages[sAIInsn->args[1]] != sAIInsn->args[2])
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_can_faint(void)
 {
     if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].power < 2)
-    {
-        sAIScriptPtr += 5;
         return;
-    }
 
     gDynamicBasePower = 0;
     gBattleStruct->dynamicMoveType = 0;
@@ -1481,8 +1595,7 @@ static void Cmd_if_can_faint(void)
     gMoveResultFlags = 0;
     gCritMultiplier = 1;
     gCurrentMove = AI_THINKING_STRUCT->moveConsidered;
-    AI_CalcDmg(gBattlerAttacker, gBattlerTarget);
-    TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+    AI_CalcDmgWithTypeCalc();
 
     gBattleMoveDamage = gBattleMoveDamage * AI_THINKING_STRUCT->simulatedRNG[AI_THINKING_STRUCT->movesetIndex] / 100;
 
@@ -1491,18 +1604,13 @@ static void Cmd_if_can_faint(void)
         gBattleMoveDamage = 1;
 
     if (gBattleMons[gBattlerTarget].hp <= gBattleMoveDamage)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
-    else
-        sAIScriptPtr += 5;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_cant_faint(void)
 {
     if (gBattleMoves[AI_THINKING_STRUCT->moveConsidered].power < 2)
-    {
-        sAIScriptPtr += 5;
         return;
-    }
 
     gDynamicBasePower = 0;
     gBattleStruct->dynamicMoveType = 0;
@@ -1510,49 +1618,42 @@ static void Cmd_if_cant_faint(void)
     gMoveResultFlags = 0;
     gCritMultiplier = 1;
     gCurrentMove = AI_THINKING_STRUCT->moveConsidered;
-    AI_CalcDmg(gBattlerAttacker, gBattlerTarget);
-    TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+    AI_CalcDmgWithTypeCalc();
 
     gBattleMoveDamage = gBattleMoveDamage * AI_THINKING_STRUCT->simulatedRNG[AI_THINKING_STRUCT->movesetIndex] / 100;
 
     // This macro is missing the damage 0 = 1 assumption.
 
     if (gBattleMons[gBattlerTarget].hp > gBattleMoveDamage)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
-    else
-        sAIScriptPtr += 5;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_has_move(void)
 {
     int i;
-    const u16 *movePtr = (u16 *)(sAIScriptPtr + 2);
+    u16 move = sAIInsn->value;
 
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_USER:
     case AI_USER_PARTNER:
         for (i = 0; i < MAX_MON_MOVES; i++)
         {
-            if (gBattleMons[gBattlerAttacker].moves[i] == *movePtr)
+            if (gBattleMons[gBattlerAttacker].moves[i] == move)
                 break;
         }
-        if (i == MAX_MON_MOVES)
-            sAIScriptPtr += 8;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
+        if (i != MAX_MON_MOVES)
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     case AI_TARGET:
     case AI_TARGET_PARTNER:
         for (i = 0; i < 8; i++)
         {
-            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] == *movePtr)
+            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] == move)
                 break;
         }
-        if (i == 8)
-            sAIScriptPtr += 8;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
+        if (i != 8)
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     }
 }
@@ -1560,33 +1661,29 @@ static void Cmd_if_has_move(void)
 static void Cmd_if_doesnt_have_move(void)
 {
     int i;
-    const u16 *movePtr = (u16 *)(sAIScriptPtr + 2);
+    u16 move = sAIInsn->value;
 
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_USER:
     case AI_USER_PARTNER:
         for (i = 0; i < MAX_MON_MOVES; i++)
         {
-            if (gBattleMons[gBattlerAttacker].moves[i] == *movePtr)
+            if (gBattleMons[gBattlerAttacker].moves[i] == move)
                 break;
         }
-        if (i != MAX_MON_MOVES)
-            sAIScriptPtr += 8;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
+        if (i == MAX_MON_MOVES)
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     case AI_TARGET:
     case AI_TARGET_PARTNER:
         for (i = 0; i < 8; i++)
         {
-            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] == *movePtr)
+            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] == move)
                 break;
         }
-        if (i != 8)
-            sAIScriptPtr += 8;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 4);
+        if (i == 8)
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     }
 }
@@ -1595,28 +1692,26 @@ static void Cmd_if_has_move_with_effect(void)
 {
     int i;
 
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_USER:
     case AI_USER_PARTNER:
         for (i = 0; i < MAX_MON_MOVES; i++)
         {
-            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[gBattleMons[gBattlerAttacker].moves[i]].effect == sAIScriptPtr[2])
+            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[gBattleMons[gBattlerAttacker].moves[i]].effect == sAIInsn->args[1])
                 break;
         }
         if (i != MAX_MON_MOVES)
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-        else
-            sAIScriptPtr += 7;
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     case AI_TARGET:
     case AI_TARGET_PARTNER:
         for (i = 0; i < 8; i++)
         {
-            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i]].effect == sAIScriptPtr[2])
+            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i]].effect == sAIInsn->args[1])
                 break;
         }
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
+        sAIScriptPtr = sAIInsn->ptr;
     }
 }
 
@@ -1624,28 +1719,25 @@ static void Cmd_if_doesnt_have_move_with_effect(void)
 {
     int i;
 
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case AI_USER:
     case AI_USER_PARTNER:
         for (i = 0; i < MAX_MON_MOVES; i++)
         {
-            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[gBattleMons[gBattlerAttacker].moves[i]].effect == sAIScriptPtr[2])
+            if (gBattleMons[gBattlerAttacker].moves[i] != 0 && gBattleMoves[gBattleMons[gBattlerAttacker].moves[i]].effect == sAIInsn->args[1])
                 break;
         }
-        if (i != MAX_MON_MOVES)
-            sAIScriptPtr += 7;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
+        if (i == MAX_MON_MOVES)
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     case AI_TARGET:
     case AI_TARGET_PARTNER:
         for (i = 0; i < 8; i++)
         {
-            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] != 0 && gBattleMoves[BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i]].effect == sAIScriptPtr[2])
+            if (BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i] != 0 && gBattleMoves[BATTLE_HISTORY->usedMoves[gBattlerTarget >> 1][i]].effect == sAIInsn->args[1])
                 break;
         }
-        sAIScriptPtr += 7;
     }
 }
 
@@ -1653,49 +1745,36 @@ static void Cmd_if_any_move_disabled_or_encored(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
-    if (sAIScriptPtr[2] == 0)
+    if (sAIInsn->args[1] == 0)
     {
-        if (gDisableStructs[battlerId].disabledMove == MOVE_NONE)
-            sAIScriptPtr += 7;
-        else
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
+        if (gDisableStructs[battlerId].disabledMove != MOVE_NONE)
+            sAIScriptPtr = sAIInsn->ptr;
     }
-    else if (sAIScriptPtr[2] != 1)
-    {
-        sAIScriptPtr += 7;
-    }
-    else
+    else if (sAIInsn->args[1] == 1)
     {
         if (gDisableStructs[battlerId].encoredMove != MOVE_NONE)
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 3);
-        else
-            sAIScriptPtr += 7;
+            sAIScriptPtr = sAIInsn->ptr;
     }
 }
 
 static void Cmd_if_curr_move_disabled_or_encored(void)
 {
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case 0:
         if (gDisableStructs[gActiveBattler].disabledMove == AI_THINKING_STRUCT->moveConsidered)
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-        else
-            sAIScriptPtr += 6;
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     case 1:
         if (gDisableStructs[gActiveBattler].encoredMove == AI_THINKING_STRUCT->moveConsidered)
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-        else
-            sAIScriptPtr += 6;
+            sAIScriptPtr = sAIInsn->ptr;
         break;
     default:
-        sAIScriptPtr += 6;
         break;
     }
 }
@@ -1725,9 +1804,7 @@ static void Cmd_if_random_safari_flee(void)
         safariFleeRate = gBattleStruct->safariEscapeFactor;
     safariFleeRate *= 5;
     if ((u8)(Random() % 100) < safariFleeRate)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
-    else
-        sAIScriptPtr += 5;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_watch(void)
@@ -1740,7 +1817,7 @@ static void Cmd_get_hold_effect(void)
     u8 battlerId;
     u16 side;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
@@ -1752,105 +1829,86 @@ static void Cmd_get_hold_effect(void)
     }
     else
         AI_THINKING_STRUCT->funcResult = ItemId_GetHoldEffect(gBattleMons[battlerId].item);
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_gender(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     AI_THINKING_STRUCT->funcResult = GetGenderFromSpeciesAndPersonality(gBattleMons[battlerId].species, gBattleMons[battlerId].personality);
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_is_first_turn_for(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     AI_THINKING_STRUCT->funcResult = gDisableStructs[battlerId].isFirstTurn;
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_stockpile_count(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     AI_THINKING_STRUCT->funcResult = gDisableStructs[battlerId].stockpileCounter;
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_is_double_battle(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleTypeFlags & BATTLE_TYPE_DOUBLE;
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_used_held_item(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     AI_THINKING_STRUCT->funcResult = ((u8 *)gBattleStruct->usedHeldItems)[battlerId * 2];
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_get_move_type_from_result(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->funcResult].type;
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_move_power_from_result(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->funcResult].power;
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_move_effect_from_result(void)
 {
     AI_THINKING_STRUCT->funcResult = gBattleMoves[AI_THINKING_STRUCT->funcResult].effect;
-
-    sAIScriptPtr += 1;
 }
 
 static void Cmd_get_protect_count(void)
 {
     u8 battlerId;
 
-    if (sAIScriptPtr[1] == AI_USER)
+    if (sAIInsn->args[0] == AI_USER)
         battlerId = gBattlerAttacker;
     else
         battlerId = gBattlerTarget;
 
     AI_THINKING_STRUCT->funcResult = gDisableStructs[battlerId].protectUses;
-
-    sAIScriptPtr += 2;
 }
 
 static void Cmd_nullsub_52(void)
@@ -1879,13 +1937,13 @@ static void Cmd_nullsub_57(void)
 
 static void Cmd_call(void)
 {
-    AIStackPushVar(sAIScriptPtr + 5);
-    sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
+    AIStackPushVar(sAIScriptPtr);
+    sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_goto(void)
 {
-    sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
+    sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_end(void)
@@ -1896,49 +1954,33 @@ static void Cmd_end(void)
 
 static void Cmd_if_level_compare(void)
 {
-    switch (sAIScriptPtr[1])
+    switch (sAIInsn->args[0])
     {
     case 0: // greater than
         if (gBattleMons[gBattlerAttacker].level > gBattleMons[gBattlerTarget].level)
-        {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-            return;
-        }
-        sAIScriptPtr += 6;
-        return;
+            sAIScriptPtr = sAIInsn->ptr;
+        break;
     case 1: // less than
         if (gBattleMons[gBattlerAttacker].level < gBattleMons[gBattlerTarget].level)
-        {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-            return;
-        }
-        sAIScriptPtr += 6;
-        return;
+            sAIScriptPtr = sAIInsn->ptr;
+        break;
     case 2: // equal
         if (gBattleMons[gBattlerAttacker].level == gBattleMons[gBattlerTarget].level)
-        {
-            sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 2);
-            return;
-        }
-        sAIScriptPtr += 6;
-        return;
+            sAIScriptPtr = sAIInsn->ptr;
+        break;
     }
 }
 
 static void Cmd_if_target_taunted(void)
 {
     if (gDisableStructs[gBattlerTarget].tauntTimer != 0)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
-    else
-        sAIScriptPtr += 5;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void Cmd_if_target_not_taunted(void)
 {
     if (gDisableStructs[gBattlerTarget].tauntTimer == 0)
-        sAIScriptPtr = T1_READ_PTR(sAIScriptPtr + 1);
-    else
-        sAIScriptPtr += 5;
+        sAIScriptPtr = sAIInsn->ptr;
 }
 
 static void AIStackPushVar(const u8 *var)
@@ -1963,3 +2005,79 @@ static bool8 AIStackPop(void)
     else
         return FALSE;
 }
+
+// Finds the memo for move between gBattlerAttacker and gBattlerTarget, making
+// a new empty one if there is none yet. The memo is cleared along with the
+// rest of AI_THINKING_STRUCT in BattleAI_SetupAIData, so nothing in it
+// outlives the battle state it was worked out from.
+static struct AI_DamageMemo *AI_GetDamageMemo(u16 move)
+{
+    s32 i;
+    struct AI_DamageMemo *memo;
+
+    for (i = 0; i < AI_THINKING_STRUCT->damageMemoCount; i++)
+    {
+        memo = &AI_THINKING_STRUCT->damageMemo[i];
+        if (memo->move == move && memo->attacker == gBattlerAttacker && memo->target == gBattlerTarget)
+            return memo;
+    }
+
+    if (i == MAX_MON_MOVES)
+        return NULL;
+
+    memo = &AI_THINKING_STRUCT->damageMemo[i];
+    memo->move = move;
+    memo->attacker = gBattlerAttacker;
+    memo->target = gBattlerTarget;
+    memo->flags = 0;
+    AI_THINKING_STRUCT->damageMemoCount++;
+    return memo;
+}
+
+// AI_CalcDmg followed by TypeCalc for gCurrentMove. The callers reset the
+// damage modifiers beforehand, so the result only depends on the move and
+// the two battlers, and gBattleMoveDamage and gBattleMovePower are replayed
+// from the memo after the first time.
+static void AI_CalcDmgWithTypeCalc(void)
+{
+    struct AI_DamageMemo *memo = AI_GetDamageMemo(gCurrentMove);
+
+    if (memo != NULL && (memo->flags & AI_MEMO_DAMAGE))
+    {
+        gDynamicBasePower = 0;
+        gBattleMovePower = memo->movePower;
+        gBattleMoveDamage = memo->damage;
+        return;
+    }
+
+    AI_CalcDmg(gBattlerAttacker, gBattlerTarget);
+    TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+
+    if (memo != NULL)
+    {
+        memo->movePower = gBattleMovePower;
+        memo->damage = gBattleMoveDamage;
+        memo->flags |= AI_MEMO_DAMAGE;
+    }
+}
+
+// TypeCalc for gCurrentMove on a gBattleMoveDamage of AI_EFFECTIVENESS_x1.
+static void AI_CalcTypeEffectiveness(void)
+{
+    struct AI_DamageMemo *memo = AI_GetDamageMemo(gCurrentMove);
+
+    if (memo != NULL && (memo->flags & AI_MEMO_EFFECTIVENESS))
+    {
+        gBattleMoveDamage = memo->effectiveness;
+        return;
+    }
+
+    gBattleMoveDamage = AI_EFFECTIVENESS_x1;
+    TypeCalc(gCurrentMove, gBattlerAttacker, gBattlerTarget);
+
+    if (memo != NULL)
+    {
+        memo->effectiveness = gBattleMoveDamage;
+        memo->flags |= AI_MEMO_EFFECTIVENESS;
+    }
+}
@@ -10,9 +10,25 @@
 #include "m4a.h"
 #include "task.h"
 #include "constants/battle_anim.h"
+#include "constants/moves.h"
 
 #define ANIM_SPRITE_INDEX_COUNT 8
 
+// Sheets loaded by loadspritegfx stay in VRAM after their last user unloads
+// them, so repeated moves and multi-hit moves don't decompress them again.
+// Idle sheets are evicted least recently used first once they hold more
+// than ANIM_GFX_IDLE_TILES tiles, or all at once when any sprite tile
+// allocation in the battle runs out of room.
+#define ANIM_GFX_SLOT_COUNT 16
+#define ANIM_GFX_IDLE_TILES 128
+
+struct AnimGfxSlot
+{
+    u16 index;
+    u8 refCount;
+    u8 lastUsed;
+};
+
 // RAM
 EWRAM_DATA static const u8 *sBattleAnimScriptPtr = NULL;
 EWRAM_DATA static const u8 *sBattleAnimScriptRetAddr = NULL;
@@ -37,10 +53,15 @@ EWRAM_DATA u8 gBattleAnimAttacker = 0;
 EWRAM_DATA u8 gBattleAnimTarget = 0;
 EWRAM_DATA u16 gAnimBattlerSpecies[MAX_BATTLERS_COUNT] = {0};
 EWRAM_DATA u8 gUnknown_2037F24 = 0;
+EWRAM_DATA static struct AnimGfxSlot sAnimGfxSlots[ANIM_GFX_SLOT_COUNT] = {0};
+EWRAM_DATA static u8 sAnimGfxClock = 0;
 
 // Function Declarations
 static void AddSpriteIndex(u16 index);
 static void ClearSpriteIndex(u16 index);
+static void AcquireAnimGfx(u16 index);
+static void ReleaseAnimGfx(u16 index);
+static bool8 ReclaimIdleAnimGfx(void);
 static void WaitAnimFrameCount(void);
 static void RunAnimScriptCommand(void);
 static void sub_8073558(u8 taskId);
@@ -1804,6 +1825,14 @@ void ClearBattleAnimationVars(void)
     for (i = 0; i < ANIM_SPRITE_INDEX_COUNT; i++)
         sAnimSpriteIndexArray[i] |= 0xFFFF;
 
+    // Sprite data is reset with the battle, taking any resident sheets with it.
+    for (i = 0; i < ANIM_GFX_SLOT_COUNT; i++)
+    {
+        sAnimGfxSlots[i].index = 0xFFFF;
+        sAnimGfxSlots[i].refCount = 0;
+    }
+    gSpriteTilesReclaimCallback = ReclaimIdleAnimGfx;
+
     // Clear anim args.
     for (i = 0; i < ANIM_ARGS_COUNT; i++)
         gBattleAnimArgs[i] = 0;
@@ -1922,6 +1951,174 @@ static void ClearSpriteIndex(u16 index)
     }
 }
 
+static struct AnimGfxSlot *FindAnimGfxSlot(u16 index)
+{
+    s32 i;
+
+    for (i = 0; i < ANIM_GFX_SLOT_COUNT; i++)
+    {
+        if (sAnimGfxSlots[i].index == index)
+        {
+            // Something else freed the sheet, e.g. a task done with its tag.
+            if (GetSpriteTileStartByTag(gBattleAnimPicTable[index].tag) == 0xFFFF)
+            {
+                sAnimGfxSlots[i].index = 0xFFFF;
+                sAnimGfxSlots[i].refCount = 0;
+                return NULL;
+            }
+            return &sAnimGfxSlots[i];
+        }
+    }
+    return NULL;
+}
+
+static u16 GetIdleAnimGfxTileCount(void)
+{
+    s32 i;
+    u16 count = 0;
+
+    for (i = 0; i < ANIM_GFX_SLOT_COUNT; i++)
+    {
+        if (sAnimGfxSlots[i].index != 0xFFFF && sAnimGfxSlots[i].refCount == 0)
+            count += gBattleAnimPicTable[sAnimGfxSlots[i].index].size / TILE_SIZE_4BPP;
+    }
+    return count;
+}
+
+// Whether a sprite is still drawing from the sheet, e.g. the shiny sparkles,
+// which load their sheet without going through the table.
+static bool8 IsAnimGfxInUse(u16 tag)
+{
+    s32 i;
+
+    for (i = 0; i < MAX_SPRITES; i++)
+    {
+        if (gSprites[i].inUse && gSprites[i].template->tileTag == tag)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// Frees idle sheets no sprite is using, oldest first, until no more than
+// maxTiles are left. Returns whether it freed any.
+static bool8 EvictIdleAnimGfx(u16 maxTiles)
+{
+    s32 i;
+    struct AnimGfxSlot *oldest;
+    u16 tiles = GetIdleAnimGfxTileCount();
+    bool8 freed = FALSE;
+
+    while (tiles > maxTiles)
+    {
+        oldest = NULL;
+        for (i = 0; i < ANIM_GFX_SLOT_COUNT; i++)
+        {
+            if (sAnimGfxSlots[i].index != 0xFFFF && sAnimGfxSlots[i].refCount == 0
+             && !IsAnimGfxInUse(gBattleAnimPicTable[sAnimGfxSlots[i].index].tag)
+             && (oldest == NULL || (u8)(sAnimGfxClock - sAnimGfxSlots[i].lastUsed) > (u8)(sAnimGfxClock - oldest->lastUsed)))
+                oldest = &sAnimGfxSlots[i];
+        }
+        if (oldest == NULL)
+            break;
+        tiles -= gBattleAnimPicTable[oldest->index].size / TILE_SIZE_4BPP;
+        FreeSpriteTilesByTag(gBattleAnimPicTable[oldest->index].tag);
+        oldest->index = 0xFFFF;
+        freed = TRUE;
+    }
+    return freed;
+}
+
+// Installed as gSpriteTilesReclaimCallback for the length of the battle, so
+// that any sprite tile allocation that runs out of room drops the idle sheets
+// and tries again.
+static bool8 ReclaimIdleAnimGfx(void)
+{
+    return EvictIdleAnimGfx(0);
+}
+
+// Returns the slot holding the sheet, loading it first if it isn't resident.
+// NULL means it's loaded but untracked, or couldn't be loaded at all.
+static struct AnimGfxSlot *LoadAnimGfx(u16 index)
+{
+    s32 i;
+    struct AnimGfxSlot *slot = FindAnimGfxSlot(index);
+
+    if (slot != NULL)
+        return slot;
+
+    LoadCompressedSpriteSheetUsingHeap(&gBattleAnimPicTable[index]);
+    if (GetSpriteTileStartByTag(gBattleAnimPicTable[index].tag) == 0xFFFF)
+        return NULL;
+
+    for (i = 0; i < ANIM_GFX_SLOT_COUNT; i++)
+    {
+        if (sAnimGfxSlots[i].index == 0xFFFF)
+        {
+            sAnimGfxSlots[i].index = index;
+            sAnimGfxSlots[i].refCount = 0;
+            sAnimGfxSlots[i].lastUsed = sAnimGfxClock;
+            return &sAnimGfxSlots[i];
+        }
+    }
+    return NULL;
+}
+
+static void AcquireAnimGfx(u16 index)
+{
+    struct AnimGfxSlot *slot = LoadAnimGfx(index);
+
+    if (slot != NULL)
+        slot->refCount++;
+    LoadCompressedSpritePaletteUsingHeap(&gBattleAnimPaletteTable[index]);
+}
+
+static void ReleaseAnimGfx(u16 index)
+{
+    struct AnimGfxSlot *slot = FindAnimGfxSlot(index);
+
+    if (slot == NULL)
+    {
+        FreeSpriteTilesByTag(gBattleAnimPicTable[index].tag);
+        FreeSpritePaletteByTag(gBattleAnimPicTable[index].tag);
+    }
+    else if (slot->refCount != 0 && --slot->refCount == 0)
+    {
+        // Palettes are small and slots are few, so only the tiles are kept.
+        FreeSpritePaletteByTag(gBattleAnimPicTable[index].tag);
+        slot->lastUsed = ++sAnimGfxClock;
+        EvictIdleAnimGfx(ANIM_GFX_IDLE_TILES);
+    }
+}
+
+// Loads the sheets the battler's moves start their animations with, while
+// they fit in the idle budget, so their first use doesn't decompress them.
+void PrefetchBattleAnimGfx(u8 battlerId)
+{
+    s32 i;
+    u16 move, index, tiles;
+    const u8 *script;
+
+    tiles = GetIdleAnimGfxTileCount();
+    for (i = 0; i < MAX_MON_MOVES; i++)
+    {
+        move = gBattleMons[battlerId].moves[i];
+        if (move == MOVE_NONE)
+            continue;
+        // Each leading loadspritegfx is its command byte and a 16-bit tag.
+        for (script = gBattleAnims_Moves[move]; script[0] == 0; script += 3)
+        {
+            index = GET_TRUE_SPRITE_INDEX(T1_READ_16(script + 1));
+            if (FindAnimGfxSlot(index) != NULL)
+                continue;
+            tiles += gBattleAnimPicTable[index].size / TILE_SIZE_4BPP;
+            if (tiles > ANIM_GFX_IDLE_TILES)
+                return;
+            if (LoadAnimGfx(index) == NULL)
+                return;
+        }
+    }
+}
+
 static void WaitAnimFrameCount(void)
 {
     if (sAnimFramesToWait <= 0)
@@ -1949,8 +2146,7 @@ static void ScriptCmd_loadspritegfx(void)
 
     sBattleAnimScriptPtr++;
     index = T1_READ_16(sBattleAnimScriptPtr);
-    LoadCompressedSpriteSheetUsingHeap(&gBattleAnimPicTable[GET_TRUE_SPRITE_INDEX(index)]);
-    LoadCompressedSpritePaletteUsingHeap(&gBattleAnimPaletteTable[GET_TRUE_SPRITE_INDEX(index)]);
+    AcquireAnimGfx(GET_TRUE_SPRITE_INDEX(index));
     sBattleAnimScriptPtr += 2;
     AddSpriteIndex(GET_TRUE_SPRITE_INDEX(index));
     sAnimFramesToWait = 1;
@@ -1963,8 +2159,7 @@ static void ScriptCmd_unloadspritegfx(void)
 
     sBattleAnimScriptPtr++;
     index = T1_READ_16(sBattleAnimScriptPtr);
-    FreeSpriteTilesByTag(gBattleAnimPicTable[GET_TRUE_SPRITE_INDEX(index)].tag);
-    FreeSpritePaletteByTag(gBattleAnimPicTable[GET_TRUE_SPRITE_INDEX(index)].tag);
+    ReleaseAnimGfx(GET_TRUE_SPRITE_INDEX(index));
     sBattleAnimScriptPtr += 2;
     ClearSpriteIndex(GET_TRUE_SPRITE_INDEX(index));
 }
@@ -2125,8 +2320,7 @@ static void ScriptCmd_end(void)
     {
         if (sAnimSpriteIndexArray[i] != 0xFFFF)
         {
-            FreeSpriteTilesByTag(gBattleAnimPicTable[sAnimSpriteIndexArray[i]].tag);
-            FreeSpritePaletteByTag(gBattleAnimPicTable[sAnimSpriteIndexArray[i]].tag);
+            ReleaseAnimGfx(sAnimSpriteIndexArray[i]);
             sAnimSpriteIndexArray[i] = 0xFFFF; // set terminator.
         }
     }
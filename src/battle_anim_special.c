@@ -2066,11 +2066,12 @@ void TryShinyAnimation(u8 battler, struct Pokemon *mon)
 
         if (isShiny)
         {
+            // The sheet may still be resident from a move animation whose
+            // palette has been freed, so each is loaded if missing.
             if (GetSpriteTileStartByTag(ANIM_TAG_GOLD_STARS) == 0xFFFF)
-            {
                 LoadCompressedSpriteSheetUsingHeap(&gBattleAnimPicTable[ANIM_TAG_GOLD_STARS - ANIM_SPRITES_START]);
+            if (IndexOfSpritePaletteTag(ANIM_TAG_GOLD_STARS) == 0xFF)
                 LoadCompressedSpritePaletteUsingHeap(&gBattleAnimPaletteTable[ANIM_TAG_GOLD_STARS - ANIM_SPRITES_START]);
-            }
 
             taskId1 = CreateTask(AnimTask_ShinySparkles, 10);
             taskId2 = CreateTask(AnimTask_ShinySparkles, 10);
@@ -2911,6 +2911,8 @@ static void TryDoEventsBeforeFirstTurn(void)
                 for (j = i + 1; j < gBattlersCount; ++j)
                     if (GetWhoStrikesFirst(gBattlerByTurnOrder[i], gBattlerByTurnOrder[j], TRUE) != 0)
                         SwapTurnOrder(i, j);
+            for (i = 0; i < gBattlersCount; ++i)
+                PrefetchBattleAnimGfx(gBattlerByTurnOrder[i]);
         }
         if (!gBattleStruct->overworldWeatherDone
             && AbilityBattleEffects(0, 0, 0, ABILITYEFFECT_SWITCH_IN_WEATHER, 0) != 0)
@@ -37,6 +37,8 @@ void AllocateBattleResources(void)
 
 void FreeBattleResources(void)
 {
+    // The battle's idle animation sheets go with it.
+    gSpriteTilesReclaimCallback = NULL;
     if (gBattleTypeFlags & BATTLE_TYPE_TRAINER_TOWER)
         FreeTrainerTowerBattleStruct();
     if (gBattleTypeFlags & BATTLE_TYPE_POKEDUDE)
@@ -2,11 +2,43 @@
 #include "gflib.h"
 #include "decompress.h"
 #include "pokemon.h"
+#include "task.h"
 
 extern const struct CompressedSpriteSheet gMonFrontPicTable[];
 extern const struct CompressedSpriteSheet gMonBackPicTable[];
 
+struct LZDecompressTask
+{
+    struct LZDecompressStream stream;
+    u16 bytesPerFrame;
+};
+
+// Mon pics are decompressed into a small LRU cache as well as their
+// destination, since switch-ins, the summary screen and the like load the
+// same few over and over. Pics only ever come from ROM, so an entry never
+// goes stale; Spinda's front pic is cached per personality, spots and all.
+#define MON_PIC_CACHE_SLOTS 4
+#define MON_PIC_CACHE_SLOT_SIZE 0x800
+
+#define MON_PIC_CACHE_DEOXYS (1 << 0) // DuplicateDeoxysTiles has been applied
+#define MON_PIC_CACHE_SPOTS  (1 << 1) // DrawSpindaSpots has been applied
+
+struct MonPicCacheEntry
+{
+    const u32 *src; // NULL if the slot is free
+    u32 personality;
+    u16 size;
+    u8 flags;
+    u16 lastUsed;
+};
+
+EWRAM_DATA static struct MonPicCacheEntry sMonPicCache[MON_PIC_CACHE_SLOTS] = {0};
+EWRAM_DATA static u32 sMonPicCacheData[MON_PIC_CACHE_SLOTS][MON_PIC_CACHE_SLOT_SIZE / 4] = {0};
+EWRAM_DATA static u16 sMonPicCacheClock = 0;
+
 static void DuplicateDeoxysTiles(void *pointer, s32 species);
+static void LoadMonPic(const u32 *src, void *dest, s32 species, u32 personality, bool8 isFrontPic, bool8 handleDeoxys);
+static void Task_LZDecompress(u8 taskId);
 
 void LZDecompressWram(const void *src, void *dest)
 {
@@ -80,7 +112,7 @@ void HandleLoadSpecialPokePic(const struct CompressedSpriteSheet *src, void *des
     LoadSpecialPokePic(src, dest, species, personality, isFrontPic);
 }
 
-void LoadSpecialPokePic(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic)
+static const u32 *GetSpecialPokePicData(const struct CompressedSpriteSheet *src, s32 species, u32 personality, bool8 isFrontPic)
 {
     if (species == SPECIES_UNOWN)
     {
@@ -92,17 +124,94 @@ void LoadSpecialPokePic(const struct CompressedSpriteSheet *src, void *dest, s32
         else
             i += SPECIES_UNOWN_B - 1;
         if (!isFrontPic)
-            LZ77UnCompWram(gMonBackPicTable[i].data, dest);
+            return gMonBackPicTable[i].data;
         else
-            LZ77UnCompWram(gMonFrontPicTable[i].data, dest);
+            return gMonFrontPicTable[i].data;
     }
     else if (species > NUM_SPECIES) // is species unknown? draw the ? icon
-        LZ77UnCompWram(gMonFrontPicTable[0].data, dest);
+        return gMonFrontPicTable[0].data;
     else
-        LZ77UnCompWram(src->data, dest);
+        return src->data;
+}
 
-    DuplicateDeoxysTiles(dest, species);
+void LoadSpecialPokePic(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic)
+{
+    LoadMonPic(GetSpecialPokePicData(src, species, personality, isFrontPic), dest, species, personality, isFrontPic, TRUE);
+}
+
+static struct MonPicCacheEntry *FindMonPicCacheEntry(const u32 *src, u32 personality, u8 flags)
+{
+    u8 i;
+
+    for (i = 0; i < MON_PIC_CACHE_SLOTS; i++)
+    {
+        if (sMonPicCache[i].src == src && sMonPicCache[i].flags == flags && sMonPicCache[i].personality == personality)
+            return &sMonPicCache[i];
+    }
+    return NULL;
+}
+
+static struct MonPicCacheEntry *GetOldestMonPicCacheEntry(void)
+{
+    struct MonPicCacheEntry *oldest;
+    u8 i;
+
+    oldest = &sMonPicCache[0];
+    for (i = 0; i < MON_PIC_CACHE_SLOTS; i++)
+    {
+        if (sMonPicCache[i].src == NULL)
+            return &sMonPicCache[i];
+        if ((u16)(sMonPicCacheClock - sMonPicCache[i].lastUsed) > (u16)(sMonPicCacheClock - oldest->lastUsed))
+            oldest = &sMonPicCache[i];
+    }
+    return oldest;
+}
+
+static void LoadMonPic(const u32 *src, void *dest, s32 species, u32 personality, bool8 isFrontPic, bool8 handleDeoxys)
+{
+    struct MonPicCacheEntry *entry;
+    u32 size;
+    u8 flags;
+
+    flags = 0;
+    if (handleDeoxys && species == SPECIES_DEOXYS)
+        flags |= MON_PIC_CACHE_DEOXYS;
+    if (species == SPECIES_SPINDA && isFrontPic)
+        flags |= MON_PIC_CACHE_SPOTS;
+    else
+        personality = 0;
+
+    sMonPicCacheClock++;
+    entry = FindMonPicCacheEntry(src, personality, flags);
+    if (entry != NULL)
+    {
+        entry->lastUsed = sMonPicCacheClock;
+        CpuFastCopy(sMonPicCacheData[entry - sMonPicCache], dest, entry->size);
+        return;
+    }
+
+    LZ77UnCompWram(src, dest);
+    if (handleDeoxys)
+        DuplicateDeoxysTiles(dest, species);
     DrawSpindaSpots(species, personality, dest, isFrontPic);
+
+    // Anything that doesn't fit a slot (Deoxys' two forms) is left out.
+    size = GetDecompressedDataSize((const u8 *)src);
+    if (size <= MON_PIC_CACHE_SLOT_SIZE && size % 32 == 0)
+    {
+        entry = GetOldestMonPicCacheEntry();
+        entry->src = src;
+        entry->personality = personality;
+        entry->size = size;
+        entry->flags = flags;
+        entry->lastUsed = sMonPicCacheClock;
+        CpuFastCopy(dest, sMonPicCacheData[entry - sMonPicCache], size);
+    }
+}
+
+void ResetMonPicCache(void)
+{
+    CpuFill32(0, sMonPicCache, sizeof(sMonPicCache));
 }
 
 static void DuplicateDeoxysTiles(void *pointer, s32 species)
@@ -326,27 +435,137 @@ void HandleLoadSpecialPokePic_DontHandleDeoxys(const struct CompressedSpriteShee
 
 void LoadSpecialPokePic_DontHandleDeoxys(const struct CompressedSpriteSheet *src, void *dest, s32 species, u32 personality, bool8 isFrontPic)
 {
-    if (species == SPECIES_UNOWN)
+    LoadMonPic(GetSpecialPokePicData(src, species, personality, isFrontPic), dest, species, personality, isFrontPic, FALSE);
+}
+
+void LZDecompressStreamInit(struct LZDecompressStream *stream, const void *src, void *dest, bool8 vram)
+{
+    stream->src = (const u8 *)src + 4;
+    stream->dest = dest;
+    stream->remaining = GetDecompressedDataSize(src);
+    stream->copyLength = 0;
+    stream->copyOffset = 0;
+    stream->flags = 0;
+    stream->flagsLeft = 0;
+    stream->vram = vram;
+    stream->pendingByte = 0;
+}
+
+// Bytes at even addresses are held back until the byte after them arrives,
+// then both are written as one halfword.
+static u8 *StreamWriteVram(struct LZDecompressStream *stream, u8 *dest, u8 value)
+{
+    if (((uintptr_t)dest & 1) == 0)
+        stream->pendingByte = value;
+    else
+        *(vu16 *)(dest - 1) = stream->pendingByte | (value << 8);
+    return dest + 1;
+}
+
+// Decompresses up to maxBytes more bytes. Returns TRUE once all of them
+// have been written.
+bool8 LZDecompressStreamRun(struct LZDecompressStream *stream, u32 maxBytes)
+{
+    const u8 *src = stream->src;
+    u8 *dest = stream->dest;
+    u32 count = stream->remaining;
+    u32 length;
+
+    if (count > maxBytes)
+        count = maxBytes;
+    stream->remaining -= count;
+
+    while (count != 0)
     {
-        u16 i = (((personality & 0x3000000) >> 18) | ((personality & 0x30000) >> 12) | ((personality & 0x300) >> 6) | (personality & 3)) % 0x1C;
+        if (stream->copyLength == 0)
+        {
+            if (stream->flagsLeft == 0)
+            {
+                stream->flags = *src++;
+                stream->flagsLeft = 8;
+            }
+            stream->flagsLeft--;
+            if (!(stream->flags & 0x80))
+            {
+                stream->flags <<= 1;
+                if (stream->vram)
+                    dest = StreamWriteVram(stream, dest, *src++);
+                else
+                    *dest++ = *src++;
+                count--;
+                continue;
+            }
+            stream->flags <<= 1;
+            stream->copyLength = (src[0] >> 4) + 3;
+            stream->copyOffset = (((src[0] & 0xF) << 8) | src[1]) + 1;
+            src += 2;
+        }
 
-        // The other Unowns are separate from Unown A.
-        if (i == 0)
-            i = SPECIES_UNOWN;
-        else
-            i += SPECIES_UNOWN_B - 1;
-        if (!isFrontPic)
-            LZ77UnCompWram(gMonBackPicTable[i].data, dest);
+        // A back-reference may be longer than what is left of this call's
+        // budget, or of the data.
+        length = stream->copyLength;
+        if (length > count)
+            length = count;
+        stream->copyLength -= length;
+        count -= length;
+        if (!stream->vram)
+        {
+            const u8 *from = dest - stream->copyOffset;
+
+            while (length-- != 0)
+                *dest++ = *from++;
+        }
         else
-            LZ77UnCompWram(gMonFrontPicTable[i].data, dest);
-    }
-    else if (species > NUM_SPECIES) // is species unknown? draw the ? icon
-    {
-        LZ77UnCompWram(gMonFrontPicTable[0].data, dest);
+        {
+            while (length-- != 0)
+            {
+                // The byte just before an odd address hasn't reached VRAM yet.
+                if (stream->copyOffset == 1 && ((uintptr_t)dest & 1))
+                    dest = StreamWriteVram(stream, dest, stream->pendingByte);
+                else
+                    dest = StreamWriteVram(stream, dest, *(dest - stream->copyOffset));
+            }
+        }
     }
-    else
+
+    stream->src = src;
+    stream->dest = dest;
+    if (stream->remaining != 0)
+        return FALSE;
+
+    // The last byte of odd-sized data is still pending; the byte after it
+    // isn't ours to overwrite.
+    if (stream->vram && ((uintptr_t)dest & 1))
     {
-        LZ77UnCompWram(src->data, dest);
+        vu16 *last = (vu16 *)(dest - 1);
+
+        *last = (*last & 0xFF00) | stream->pendingByte;
     }
-    DrawSpindaSpots(species, personality, dest, isFrontPic);
+    return TRUE;
+}
+
+// Decompresses src into dest bytesPerFrame bytes at a time, from a task, so
+// that a loading screen can keep fading or animating in the meantime. Wait
+// for IsLZDecompressTaskActive to return FALSE before using dest.
+u8 CreateLZDecompressTask(const void *src, void *dest, bool8 vram, u16 bytesPerFrame)
+{
+    u8 taskId = CreateTask(Task_LZDecompress, 0);
+    struct LZDecompressTask *task = (struct LZDecompressTask *)gTasks[taskId].data;
+
+    LZDecompressStreamInit(&task->stream, src, dest, vram);
+    task->bytesPerFrame = bytesPerFrame;
+    return taskId;
+}
+
+static void Task_LZDecompress(u8 taskId)
+{
+    struct LZDecompressTask *task = (struct LZDecompressTask *)gTasks[taskId].data;
+
+    if (LZDecompressStreamRun(&task->stream, task->bytesPerFrame))
+        DestroyTask(taskId);
+}
+
+bool8 IsLZDecompressTaskActive(void)
+{
+    return FuncIsActiveTask(Task_LZDecompress);
 }
@@ -21,7 +21,8 @@ struct Unk203A120
     u8 filler3958[0x2C];
     u16 allWords[270];
     u16 totalWords;
-}; /*size = 0x3BA4*/
+    u32 selectableGroups; // groups as a bitmask of group ids
+};
 
 static EWRAM_DATA struct Unk203A120 * sEasyChatSelectionData = NULL;
 
@@ -37,6 +38,7 @@ static bool8 IsWordUnlocked(u16 word);
 
 #include "data/easy_chat/easy_chat_groups.h"
 #include "data/easy_chat/easy_chat_words_by_letter.h"
+#include "data/easy_chat/easy_chat_value_list_bitmaps.h"
 
 static const u8 *const sEasyChatGroupNamePointers[] = {
     [EC_GROUP_POKEMON] = gEasyChatGroupName_Pokemon,
@@ -113,11 +115,9 @@ static u16 EasyChat_GetNumWordsInGroup(u8 groupId)
 
 static bool8 IsECWordInvalid(u16 easyChatWord)
 {
-    u16 i;
     u8 groupId;
     u32 index;
     u16 numWords;
-    const u16 *list;
     if (easyChatWord == EC_WORD_UNDEFINED)
         return FALSE;
 
@@ -133,13 +133,9 @@ static bool8 IsECWordInvalid(u16 easyChatWord)
     case EC_GROUP_POKEMON_2:
     case EC_GROUP_MOVE_1:
     case EC_GROUP_MOVE_2:
-        list = sEasyChatGroups[groupId].wordData.valueList;
-        for (i = 0; i < numWords; i++)
-        {
-            if (index == list[i])
-                return FALSE;
-        }
-        return TRUE;
+        // Whether index is in the group's valueList, precomputed by
+        // easy_chat_tables.py.
+        return !((sEasyChatValueListBitmaps[groupId][index / 32] >> (index % 32)) & 1);
     default:
         if (index >= numWords)
             return TRUE;
@@ -508,6 +504,10 @@ static void PopulateECGroups(void)
 
     if (IsNationalPokedexEnabled())
         sEasyChatSelectionData->groups[sEasyChatSelectionData->numGroups++] = EC_GROUP_POKEMON_2;
+
+    sEasyChatSelectionData->selectableGroups = 0;
+    for (i = 0; i < sEasyChatSelectionData->numGroups; i++)
+        sEasyChatSelectionData->selectableGroups |= 1 << sEasyChatSelectionData->groups[i];
 }
 
 u8 GetNumDisplayableGroups(void)
@@ -669,14 +669,10 @@ static u16 GetUnlockedWordsInAlphabeticalGroup(u16 alphabeticalGroup)
 
 static bool8 IsGroupSelectable(u8 groupIdx)
 {
-    int i;
-    for (i = 0; i < sEasyChatSelectionData->numGroups; i++)
-    {
-        if (sEasyChatSelectionData->groups[i] == groupIdx)
-            return TRUE;
-    }
+    if (groupIdx >= EC_NUM_GROUPS)
+        return FALSE;
 
-    return FALSE;
+    return (sEasyChatSelectionData->selectableGroups >> groupIdx) & 1;
 }
 
 static bool8 UnlockedECMonOrMove(u16 wordIndex, u8 groupId)
@@ -32,6 +32,13 @@ EWRAM_DATA u8 sSpecialFlags[SPECIAL_FLAGS_COUNT] = {};
 
 u16 gLastQuestLogStoredFlagOrVarIdx;
 
+// Bumped whenever a var may have been written: by VarSet, by handing out a
+// writable pointer through GetVarPointer and by the bulk clears below.
+// Readers that only care whether anything changed compare it against a
+// copy, as the on-frame map script check does. Special vars are written
+// directly all over the place and are not covered.
+u16 gVarWriteCount;
+
 extern u16 *const gSpecialVars[];
 
 void InitEventData(void)
@@ -39,12 +46,14 @@ void InitEventData(void)
     memset(gSaveBlock1Ptr->flags, 0, NUM_FLAG_BYTES);
     memset(gSaveBlock1Ptr->vars, 0, VARS_COUNT * 2);
     memset(sSpecialFlags, 0, SPECIAL_FLAGS_COUNT);
+    gVarWriteCount++;
 }
 
 void ClearTempFieldEventData(void)
 {
     memset(gSaveBlock1Ptr->flags, 0, 4);
     memset(gSaveBlock1Ptr->vars, 0, 16 * 2);
+    gVarWriteCount++;
     FlagClear(FLAG_SYS_WHITE_FLUTE_ACTIVE);
     FlagClear(FLAG_SYS_BLACK_FLUTE_ACTIVE);
     FlagClear(FLAG_SYS_USE_STRENGTH);
@@ -183,7 +192,7 @@ bool32 CanResetRTC(void)
     return TRUE;
 }
 
-u16 *GetVarPointer(u16 idx)
+static u16 *GetVarPointerInternal(u16 idx)
 {
     u16 *ptr;
     if (idx < VARS_START)
@@ -213,6 +222,12 @@ u16 *GetVarPointer(u16 idx)
     return gSpecialVars[idx - SPECIAL_VARS_START];
 }
 
+u16 *GetVarPointer(u16 idx)
+{
+    gVarWriteCount++;
+    return GetVarPointerInternal(idx);
+}
+
 static bool8 IsFlagOrVarStoredInQuestLog(u16 idx, bool8 isVar)
 {
     if (!isVar)
@@ -234,7 +249,7 @@ static bool8 IsFlagOrVarStoredInQuestLog(u16 idx, bool8 isVar)
 
 u16 VarGet(u16 idx)
 {
-    u16 *ptr = GetVarPointer(idx);
+    u16 *ptr = GetVarPointerInternal(idx);
     if (ptr == NULL)
         return idx;
     return *ptr;
@@ -242,10 +257,11 @@ u16 VarGet(u16 idx)
 
 bool8 VarSet(u16 idx, u16 val)
 {
-    u16 *ptr = GetVarPointer(idx);
+    u16 *ptr = GetVarPointerInternal(idx);
     if (ptr == NULL)
         return FALSE;
     *ptr = val;
+    gVarWriteCount++;
     return TRUE;
 }
 
@@ -70,6 +70,7 @@ static u16 GetObjectEventFlagIdByObjectEventId(u8);
 static void UpdateObjectEventVisibility(struct ObjectEvent *, struct Sprite *);
 static void MakeObjectTemplateFromObjectEventTemplate(struct ObjectEventTemplate *, struct SpriteTemplate *, const struct SubspriteTable **);
 static void GetObjectEventMovingCameraOffset(s16 *, s16 *);
+static void ClearPendingObjectEventSpawns(void);
 static struct ObjectEventTemplate *GetObjectEventTemplateByLocalIdAndMap(u8, u8, u8);
 static void RemoveObjectEventIfOutsideView(struct ObjectEvent *);
 static void sub_805EE3C(u8, s16, s16);
@@ -1150,6 +1151,45 @@ const u8 gUnknown_83A65A9[][4] = {
 
 #include "data/object_events/movement_action_func_tables.h"
 
+// Active objects by the tiles they hold, both current and previous, hashed
+// into a few buckets of object id bits. An object is always in the buckets
+// for both of its tiles; a bucket may still hold objects that have moved on
+// or been removed, so lookups check the object itself as before and only
+// skip the slots that can't match.
+#define OCCUPANCY_BUCKET_COUNT 32
+#define OCCUPANCY_BUCKET(x, y) (((u16)(x) + (u16)(y) * 8) % OCCUPANCY_BUCKET_COUNT)
+
+static EWRAM_DATA u16 sObjectEventOccupancy[OCCUPANCY_BUCKET_COUNT] = {0};
+static EWRAM_DATA u8 sObjectEventOccupiedBuckets[OBJECT_EVENTS_COUNT][2] = {0};
+
+void UpdateObjectEventOccupancy(struct ObjectEvent *objectEvent)
+{
+    u8 objectEventId = objectEvent - gObjectEvents;
+    u8 *buckets = sObjectEventOccupiedBuckets[objectEventId];
+    u16 bit = 1 << objectEventId;
+
+    sObjectEventOccupancy[buckets[0]] &= ~bit;
+    sObjectEventOccupancy[buckets[1]] &= ~bit;
+    if (objectEvent->active)
+    {
+        buckets[0] = OCCUPANCY_BUCKET(objectEvent->currentCoords.x, objectEvent->currentCoords.y);
+        buckets[1] = OCCUPANCY_BUCKET(objectEvent->previousCoords.x, objectEvent->previousCoords.y);
+        sObjectEventOccupancy[buckets[0]] |= bit;
+        sObjectEventOccupancy[buckets[1]] |= bit;
+    }
+}
+
+// For when gObjectEvents has been written wholesale.
+void RebuildObjectEventOccupancy(void)
+{
+    u8 i;
+
+    for (i = 0; i < OCCUPANCY_BUCKET_COUNT; i++)
+        sObjectEventOccupancy[i] = 0;
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+        UpdateObjectEventOccupancy(&gObjectEvents[i]);
+}
+
 static void ClearObjectEvent(struct ObjectEvent *objectEvent)
 {
     *objectEvent = (struct ObjectEvent){};
@@ -1165,6 +1205,9 @@ static void ClearAllObjectEvents(void)
 
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
         ClearObjectEvent(&gObjectEvents[i]);
+    RebuildObjectEventOccupancy();
+    InvalidateObjectEventTemplateIndex();
+    ClearPendingObjectEventSpawns();
 }
 
 void ResetObjectEvents(void)
@@ -1172,6 +1215,7 @@ void ResetObjectEvents(void)
     ClearLinkPlayerObjectEvents();
     ClearAllObjectEvents();
     ClearPlayerAvatarInfo();
+    ResetTrainerSightLines();
     CreateReflectionEffectSprites();
 }
 
@@ -1223,13 +1267,15 @@ bool8 TryGetObjectEventIdByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroupId, u
 u8 GetObjectEventIdByXY(s16 x, s16 y)
 {
     u8 i;
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    u16 candidates = sObjectEventOccupancy[OCCUPANCY_BUCKET(x, y)];
+
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
-        if (gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
-            break;
+        if ((candidates & 1) && gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
+            return i;
     }
 
-    return i;
+    return OBJECT_EVENTS_COUNT;
 }
 
 static u8 GetObjectEventIdByLocalIdAndMapInternal(u8 localId, u8 mapNum, u8 mapGroupId)
@@ -1320,6 +1366,7 @@ static u8 InitObjectEventStateFromTemplate(struct ObjectEventTemplate *template,
     objectEvent->previousCoords.y = y;
     objectEvent->currentElevation = template->elevation;
     objectEvent->previousElevation = template->elevation;
+    UpdateObjectEventOccupancy(objectEvent);
     objectEvent->rangeX = template->movementRangeX;
     objectEvent->rangeY = template->movementRangeY;
     objectEvent->trainerType = template->trainerType;
@@ -1490,6 +1537,7 @@ static bool8 GetAvailableObjectEventId(u16 localId, u8 mapNum, u8 mapGroup, u8 *
 static void RemoveObjectEvent(struct ObjectEvent *objectEvent)
 {
     objectEvent->active = FALSE;
+    UpdateObjectEventOccupancy(objectEvent);
     RemoveObjectEventInternal(objectEvent);
 }
 
@@ -1765,33 +1813,147 @@ u8 sub_805EB44(u8 graphicsId, u8 a1, s16 x, s16 y)
     return spriteId;
 }
 
+// The map's object templates sorted by y, so a camera step only looks at
+// the rows in view. Rebuilt on first use after the objects are reset, a
+// template is moved or the templates are reloaded.
+static EWRAM_DATA u8 sObjectEventTemplatesByY[OBJECT_EVENT_TEMPLATES_COUNT] = {0};
+static EWRAM_DATA u8 sObjectEventTemplateIndexCount = 0;
+static EWRAM_DATA bool8 sObjectEventTemplateIndexValid = FALSE;
+
+// Templates in view after a camera step, spawned from the next frame on a
+// few at a time so that one step doesn't create every sprite and load
+// every palette at once. Objects spawn at least two tiles outside the
+// visible area, which leaves several frames before they can be seen.
+#define OBJECT_EVENT_SPAWNS_PER_FRAME 1
+
+static EWRAM_DATA u8 sPendingObjectEventSpawns[OBJECT_EVENT_TEMPLATES_COUNT / 8] = {0};
+
+static void BuildObjectEventTemplateIndex(void)
+{
+    u8 i, j, count;
+    s16 y;
+
+    count = gMapHeader.events != NULL ? gMapHeader.events->objectEventCount : 0;
+    if (count > OBJECT_EVENT_TEMPLATES_COUNT)
+        count = OBJECT_EVENT_TEMPLATES_COUNT;
+
+    // Stable, so templates on the same row keep their map order.
+    for (i = 0; i < count; i++)
+    {
+        y = gSaveBlock1Ptr->objectEventTemplates[i].y;
+        for (j = i; j > 0 && gSaveBlock1Ptr->objectEventTemplates[sObjectEventTemplatesByY[j - 1]].y > y; j--)
+            sObjectEventTemplatesByY[j] = sObjectEventTemplatesByY[j - 1];
+        sObjectEventTemplatesByY[j] = i;
+    }
+    sObjectEventTemplateIndexCount = count;
+    sObjectEventTemplateIndexValid = TRUE;
+}
+
+void InvalidateObjectEventTemplateIndex(void)
+{
+    sObjectEventTemplateIndexValid = FALSE;
+}
+
+static void ClearPendingObjectEventSpawns(void)
+{
+    u8 i;
+
+    for (i = 0; i < NELEMS(sPendingObjectEventSpawns); i++)
+        sPendingObjectEventSpawns[i] = 0;
+}
+
+static bool8 IsObjectEventTemplateInSpawnView(struct ObjectEventTemplate *template)
+{
+    s16 npcX = template->x + 7;
+    s16 npcY = template->y + 7;
+
+    return gSaveBlock1Ptr->pos.y <= npcY && gSaveBlock1Ptr->pos.y + 16 >= npcY
+        && gSaveBlock1Ptr->pos.x - 2 <= npcX && gSaveBlock1Ptr->pos.x + 17 >= npcX
+        && !FlagGet(template->flagId);
+}
+
+static void QueueObjectEventSpawnsInView(void)
+{
+    u8 lo, hi, mid, templateId;
+    s16 top = gSaveBlock1Ptr->pos.y - 7;
+    s16 bottom = gSaveBlock1Ptr->pos.y + 16 - 7;
+    struct ObjectEventTemplate *templates = gSaveBlock1Ptr->objectEventTemplates;
+
+    if (!sObjectEventTemplateIndexValid)
+        BuildObjectEventTemplateIndex();
+
+    lo = 0;
+    hi = sObjectEventTemplateIndexCount;
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if (templates[sObjectEventTemplatesByY[mid]].y < top)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo < sObjectEventTemplateIndexCount && templates[sObjectEventTemplatesByY[lo]].y <= bottom; lo++)
+    {
+        templateId = sObjectEventTemplatesByY[lo];
+        if (IsObjectEventTemplateInSpawnView(&templates[templateId]))
+            sPendingObjectEventSpawns[templateId / 8] |= 1 << (templateId % 8);
+    }
+}
+
+// Spawns everything in view at once, for loading a map.
 void TrySpawnObjectEvents(s16 cameraX, s16 cameraY)
 {
     u8 i;
     u8 objectCount;
 
+    ClearPendingObjectEventSpawns();
     if (gMapHeader.events != NULL)
     {
-        s16 left = gSaveBlock1Ptr->pos.x - 2;
-        s16 right = gSaveBlock1Ptr->pos.x + 17;
-        s16 top = gSaveBlock1Ptr->pos.y;
-        s16 bottom = gSaveBlock1Ptr->pos.y + 16;
-
         objectCount = gMapHeader.events->objectEventCount;
 
         for (i = 0; i < objectCount; i++)
         {
             struct ObjectEventTemplate *template = &gSaveBlock1Ptr->objectEventTemplates[i];
-            s16 npcX = template->x + 7;
-            s16 npcY = template->y + 7;
 
-            if (top <= npcY && bottom >= npcY && left <= npcX && right >= npcX
-                && !FlagGet(template->flagId))
+            if (IsObjectEventTemplateInSpawnView(template))
                 TrySpawnObjectEventTemplate(template, gSaveBlock1Ptr->location.mapNum, gSaveBlock1Ptr->location.mapGroup, cameraX, cameraY);
         }
     }
 }
 
+// Called every overworld frame ahead of the camera update, where the camera
+// offsets are the ones scripts spawn objects with. Queued templates are
+// spawned in map order, as a full pass would; those already spawned, out of
+// view again or hidden by their flag since don't count against the budget.
+void SpawnPendingObjectEvents(void)
+{
+    u8 templateId;
+    u8 spawned = 0;
+    s16 cameraX, cameraY;
+    struct ObjectEventTemplate *template;
+
+    if (gMapHeader.events == NULL)
+        return;
+
+    for (templateId = 0; templateId < gMapHeader.events->objectEventCount && spawned < OBJECT_EVENT_SPAWNS_PER_FRAME; templateId++)
+    {
+        if (sPendingObjectEventSpawns[templateId / 8] == 0)
+        {
+            templateId |= 7;
+            continue;
+        }
+        if (!(sPendingObjectEventSpawns[templateId / 8] & (1 << (templateId % 8))))
+            continue;
+        sPendingObjectEventSpawns[templateId / 8] &= ~(1 << (templateId % 8));
+        template = &gSaveBlock1Ptr->objectEventTemplates[templateId];
+        if (!IsObjectEventTemplateInSpawnView(template))
+            continue;
+        GetObjectEventMovingCameraOffset(&cameraX, &cameraY);
+        if (TrySpawnObjectEventTemplate(template, gSaveBlock1Ptr->location.mapNum, gSaveBlock1Ptr->location.mapGroup, cameraX, cameraY) != OBJECT_EVENTS_COUNT)
+            spawned++;
+    }
+}
+
 void RemoveObjectEventsOutsideView(void)
 {
     u8 i, j;
@@ -2177,6 +2339,7 @@ void unref_sub_805F6E0(struct ObjectEvent *objectEvent, s16 x, s16 y)
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x += x;
     objectEvent->currentCoords.y += y;
+    UpdateObjectEventOccupancy(objectEvent);
 }
 
 void ShiftObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2185,6 +2348,7 @@ void ShiftObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    UpdateObjectEventOccupancy(objectEvent);
 }
 
 static void SetObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2193,6 +2357,7 @@ static void SetObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
     objectEvent->previousCoords.y = y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    UpdateObjectEventOccupancy(objectEvent);
 }
 
 void MoveObjectEventToMapCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2251,16 +2416,18 @@ void UpdateObjectEventCoordsForCameraUpdate(void)
                 gObjectEvents[i].previousCoords.y -= dy;
             }
         }
+        RebuildObjectEventOccupancy();
     }
 }
 
 u8 GetObjectEventIdByXYZ(u16 x, u16 y, u8 z)
 {
     u8 i;
+    u16 candidates = sObjectEventOccupancy[OCCUPANCY_BUCKET(x, y)];
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
-        if (gObjectEvents[i].active)
+        if ((candidates & 1) && gObjectEvents[i].active)
         {
             if (gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y && ObjectEventDoesZCoordMatch(&gObjectEvents[i], z))
             {
@@ -2283,7 +2450,8 @@ static bool8 ObjectEventDoesZCoordMatch(struct ObjectEvent *objectEvent, u8 z)
 void UpdateObjectEventsForCameraUpdate(s16 x, s16 y)
 {
     UpdateObjectEventCoordsForCameraUpdate();
-    TrySpawnObjectEvents(x, y);
+    if (gMapHeader.events != NULL)
+        QueueObjectEventSpawnsInView();
     RemoveObjectEventsOutsideView();
 }
 
@@ -4797,11 +4965,12 @@ static bool8 DoesObjectCollideWithObjectAt(struct ObjectEvent *objectEvent, s16
 {
     u8 i;
     struct ObjectEvent *curObject;
+    u16 candidates = sObjectEventOccupancy[OCCUPANCY_BUCKET(x, y)];
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
         curObject = &gObjectEvents[i];
-        if (curObject->active && curObject != objectEvent)
+        if ((candidates & 1) && curObject->active && curObject != objectEvent)
         {
             if ((curObject->currentCoords.x == x && curObject->currentCoords.y == y) || (curObject->previousCoords.x == x && curObject->previousCoords.y == y))
             {
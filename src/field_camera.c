@@ -28,6 +28,9 @@ static s32 MapPosToBgTilemapOffset(struct FieldCameraOffset *a, s32 x, s32 y);
 static void DrawWholeMapViewInternal(int x, int y, const struct MapLayout *mapLayout);
 static void DrawMetatileAt(const struct MapLayout *mapLayout, u16, int, int);
 static void DrawMetatile(s32 a, const u16 *b, u16 c);
+static void DrawMapSlice(const struct MapLayout *mapLayout, u8 startTile, u32 bgOffset, bool8 isColumn, int x, int y);
+static void CopyTilemapRowsToVram(u8 tileY);
+static void ScheduleFieldTilemapCopies(void);
 static void CameraPanningCB_PanAhead(void);
 
 // IWRAM bss vars
@@ -131,75 +134,116 @@ static void RedrawMapSlicesForCameraUpdate(struct FieldCameraOffset *cameraOffse
         RedrawMapSliceNorth(cameraOffset, mapLayout);
     if (y < 0)
         RedrawMapSliceSouth(cameraOffset, mapLayout);
+
+    // A new column touches every row of the tilemaps, so it needs them copied
+    // whole. A new row is only 2 tile rows, which can be copied on their own.
+    if (x != 0)
+        ScheduleFieldTilemapCopies();
+    else if (y > 0)
+        CopyTilemapRowsToVram((cameraOffset->yTileOffset + 28) % 32);
+    else if (y < 0)
+        CopyTilemapRowsToVram(cameraOffset->yTileOffset);
     cameraOffset->copyBGToVRAM = TRUE;
 }
 
 static void RedrawMapSliceNorth(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
     u8 temp;
-    u32 r7;
 
     temp = cameraOffset->yTileOffset + 28;
     if (temp >= 32)
         temp -= 32;
-    r7 = temp * 32;
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->xTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, r7 + temp, gSaveBlock1Ptr->pos.x + i / 2, gSaveBlock1Ptr->pos.y + 14);
-    }
+    DrawMapSlice(mapLayout, cameraOffset->xTileOffset, temp * 32, FALSE, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y + 14);
 }
 
 static void RedrawMapSliceSouth(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u32 r7 = cameraOffset->yTileOffset * 32;
-
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->xTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, r7 + temp, gSaveBlock1Ptr->pos.x + i / 2, gSaveBlock1Ptr->pos.y);
-    }
+    DrawMapSlice(mapLayout, cameraOffset->xTileOffset, cameraOffset->yTileOffset * 32, FALSE, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y);
 }
 
 static void RedrawMapSliceEast(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u32 r6 = cameraOffset->xTileOffset;
-
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->yTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, temp * 32 + r6, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y + i / 2);
-    }
+    DrawMapSlice(mapLayout, cameraOffset->yTileOffset, cameraOffset->xTileOffset, TRUE, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y);
 }
 
 static void RedrawMapSliceWest(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
     u8 r5 = cameraOffset->xTileOffset + 28;
 
     if (r5 >= 32)
         r5 -= 32;
-    for (i = 0; i < 32; i += 2)
+    DrawMapSlice(mapLayout, cameraOffset->yTileOffset, r5, TRUE, gSaveBlock1Ptr->pos.x + 14, gSaveBlock1Ptr->pos.y);
+}
+
+// Draws the 16 metatiles of a row (or column) of the view starting at map
+// position (x, y). startTile is the first tile's x (or y) in the wrapping 32x32
+// tilemaps, and bgOffset the tilemap offset of the row (or column) itself.
+// Same output as calling DrawMetatileAt on each metatile, but the tilesets are
+// only looked up once and the tilemap copies are left to the caller.
+static void DrawMapSlice(const struct MapLayout *mapLayout, u8 startTile, u32 bgOffset, bool8 isColumn, int x, int y)
+{
+    const u16 *primaryMetatiles = mapLayout->primaryTileset->metatiles;
+    const u16 *secondaryMetatiles = mapLayout->secondaryTileset->metatiles;
+    const u32 *primaryAttributes = mapLayout->primaryTileset->metatileAttributes;
+    const u32 *secondaryAttributes = mapLayout->secondaryTileset->metatileAttributes;
+    u16 numPrimary = mapLayout->primaryTileset->numMetatiles;
+    u16 numSecondary = mapLayout->secondaryTileset->numMetatiles;
+    u8 i;
+    u8 tile;
+    u32 metatileId;
+    u32 attributes;
+    const u16 *metatiles;
+
+    for (i = 0; i < 16; i++)
     {
-        temp = cameraOffset->yTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, temp * 32 + r5, gSaveBlock1Ptr->pos.x + 14, gSaveBlock1Ptr->pos.y + i / 2);
+        tile = (startTile + i * 2) % 32;
+        metatileId = MapGridGetMetatileIdAt(x, y);
+        if (metatileId > NUM_METATILES_TOTAL)
+            metatileId = 0;
+        if (metatileId < NUM_METATILES_IN_PRIMARY)
+        {
+            metatiles = primaryMetatiles + metatileId * 8;
+            attributes = metatileId < numPrimary ? primaryAttributes[metatileId] : 0;
+        }
+        else
+        {
+            metatileId -= NUM_METATILES_IN_PRIMARY;
+            metatiles = secondaryMetatiles + metatileId * 8;
+            attributes = metatileId < numSecondary ? secondaryAttributes[metatileId] : 0;
+        }
+
+        DrawMetatile(GetMetatileAttributeFromRawMetatileBehavior(attributes, METATILE_ATTRIBUTE_LAYER_TYPE),
+                     metatiles,
+                     isColumn ? tile * 32 + bgOffset : bgOffset + tile);
+
+        if (isColumn)
+            y++;
+        else
+            x++;
     }
 }
 
+// Queues just the 2 tile rows starting at tileY of each field BG, rather than
+// the whole 2KB tilemap. Falls back to the whole tilemaps if the DMA queue has
+// no room.
+static void CopyTilemapRowsToVram(u8 tileY)
+{
+    u16 offset = tileY * 32 * sizeof(u16);
+    u16 size = 2 * 32 * sizeof(u16);
+
+    if (LoadBgVram(1, gBGTilemapBuffers2 + tileY * 32, size, offset, 2) == 0xFF
+     || LoadBgVram(2, gBGTilemapBuffers1 + tileY * 32, size, offset, 2) == 0xFF
+     || LoadBgVram(3, gBGTilemapBuffers3 + tileY * 32, size, offset, 2) == 0xFF)
+        ScheduleFieldTilemapCopies();
+}
+
+static void ScheduleFieldTilemapCopies(void)
+{
+    ScheduleBgCopyTilemapToVram(1);
+    ScheduleBgCopyTilemapToVram(2);
+    ScheduleBgCopyTilemapToVram(3);
+}
+
 void CurrentMapDrawMetatileAt(int x, int y)
 {
     int offset = MapPosToBgTilemapOffset(&sFieldCameraOffset, x, y);
@@ -218,6 +262,7 @@ void DrawDoorMetatileAt(int x, int y, const u16 *arr)
     if (offset >= 0)
     {
         DrawMetatile(1, arr, offset);
+        ScheduleFieldTilemapCopies();
        // sFieldCameraOffset.copyBGToVRAM = TRUE;
     }
 }
@@ -237,6 +282,7 @@ static void DrawMetatileAt(const struct MapLayout *mapLayout, u16 offset, int x,
         metatileId -= NUM_METATILES_IN_PRIMARY;
     }
     DrawMetatile(MapGridGetMetatileLayerTypeAt(x, y), metatiles + metatileId * 8, offset);
+    ScheduleFieldTilemapCopies();
 }
 
 static void DrawMetatile(s32 metatileLayerType, const u16 *metatiles, u16 offset)
@@ -301,9 +347,6 @@ static void DrawMetatile(s32 metatileLayerType, const u16 *metatiles, u16 offset
         gBGTilemapBuffers2[offset + 0x21] = metatiles[7];
         break;
     }
-    ScheduleBgCopyTilemapToVram(1);
-    ScheduleBgCopyTilemapToVram(2);
-    ScheduleBgCopyTilemapToVram(3);
 }
 
 static s32 MapPosToBgTilemapOffset(struct FieldCameraOffset *cameraOffset, s32 x, s32 y)
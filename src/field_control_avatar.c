@@ -72,6 +72,27 @@ static bool8 TryDoorWarp(struct MapPosition * position, u16 metatileBehavior, u8
 static s8 GetWarpEventAtPosition(struct MapHeader * mapHeader, u16 x, u16 y, u8 z);
 static const u8 *GetCoordEventScriptAtPosition(struct MapHeader * mapHeader, u16 x, u16 y, u8 z);
 
+enum
+{
+    MAP_EVENT_WARP,
+    MAP_EVENT_COORD,
+    MAP_EVENT_BG,
+    MAP_EVENT_TYPE_COUNT,
+};
+
+#define EVENT_TILE_KEY(x, y) (((u32)(u16)(y) << 16) | (u16)(x))
+
+// The warp, coord and bg events of the current map, as indices sorted by
+// tile. Events on the same tile keep their order in the map's list, so the
+// first one whose elevation matches is the one a linear scan would find.
+struct MapEventIndex
+{
+    const struct MapEvents *events;
+    u8 sorted[MAP_EVENT_TYPE_COUNT][0x100];
+};
+
+static EWRAM_DATA struct MapEventIndex sMapEventIndex = {0};
+
 struct FieldInput gInputToStoreInQuestLogMaybe;
 
 void FieldClearPlayerInput(struct FieldInput *input)
@@ -1018,20 +1039,96 @@ static bool8 TryDoorWarp(struct MapPosition *position, u16 metatileBehavior, u8
     return FALSE;
 }
 
-static s8 GetWarpEventAtPosition(struct MapHeader *mapHeader, u16 x, u16 y, u8 elevation)
+static u8 GetMapEventCount(const struct MapEvents *events, u8 type)
 {
-    s32 i;
-    struct WarpEvent *warpEvent = mapHeader->events->warps;
-    u8 warpCount = mapHeader->events->warpCount;
+    switch (type)
+    {
+    case MAP_EVENT_WARP:
+        return events->warpCount;
+    case MAP_EVENT_COORD:
+        return events->coordEventCount;
+    default:
+        return events->bgEventCount;
+    }
+}
 
-    for (i = 0; i < warpCount; i++, warpEvent++)
+static u32 GetMapEventTileKey(const struct MapEvents *events, u8 type, u8 i)
+{
+    switch (type)
     {
-        if ((u16)warpEvent->x == x && (u16)warpEvent->y == y)
+    case MAP_EVENT_WARP:
+        return EVENT_TILE_KEY(events->warps[i].x, events->warps[i].y);
+    case MAP_EVENT_COORD:
+        return EVENT_TILE_KEY(events->coordEvents[i].x, events->coordEvents[i].y);
+    default:
+        return EVENT_TILE_KEY(events->bgEvents[i].x, events->bgEvents[i].y);
+    }
+}
+
+static void BuildMapEventIndex(const struct MapEvents *events)
+{
+    u8 type;
+    s32 i, j;
+
+    sMapEventIndex.events = events;
+    for (type = 0; type < MAP_EVENT_TYPE_COUNT; type++)
+    {
+        u8 *sorted = sMapEventIndex.sorted[type];
+        u8 count = GetMapEventCount(events, type);
+
+        // Insertion sort, which is stable and fine for the few dozen
+        // events a map has.
+        for (i = 0; i < count; i++)
         {
-            if (warpEvent->elevation == elevation || warpEvent->elevation == 0)
-                return i;
+            u32 key = GetMapEventTileKey(events, type, i);
+
+            for (j = i; j > 0 && GetMapEventTileKey(events, type, sorted[j - 1]) > key; j--)
+                sorted[j] = sorted[j - 1];
+            sorted[j] = i;
         }
     }
+}
+
+// Returns where the events on tile (x, y) start in the sorted list for
+// type, or the list's length if there are none.
+static s32 FindFirstMapEventAtTile(const struct MapEvents *events, u8 type, u16 x, u16 y)
+{
+    const u8 *sorted;
+    u32 key = EVENT_TILE_KEY(x, y);
+    s32 lo = 0;
+    s32 hi = GetMapEventCount(events, type);
+
+    if (sMapEventIndex.events != events)
+        BuildMapEventIndex(events);
+    sorted = sMapEventIndex.sorted[type];
+    while (lo < hi)
+    {
+        s32 mid = (lo + hi) / 2;
+
+        if (GetMapEventTileKey(events, type, sorted[mid]) < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static s8 GetWarpEventAtPosition(struct MapHeader *mapHeader, u16 x, u16 y, u8 elevation)
+{
+    const struct MapEvents *events = mapHeader->events;
+    const u8 *sorted = sMapEventIndex.sorted[MAP_EVENT_WARP];
+    u8 warpCount = events->warpCount;
+    s32 i = FindFirstMapEventAtTile(events, MAP_EVENT_WARP, x, y);
+
+    for (; i < warpCount; i++)
+    {
+        struct WarpEvent *warpEvent = &events->warps[sorted[i]];
+
+        if ((u16)warpEvent->x != x || (u16)warpEvent->y != y)
+            break;
+        if (warpEvent->elevation == elevation || warpEvent->elevation == 0)
+            return sorted[i];
+    }
     return -1;
 }
 
@@ -1057,20 +1154,22 @@ static const u8 *TryRunCoordEventScript(struct CoordEvent *coordEvent)
 
 static const u8 *GetCoordEventScriptAtPosition(struct MapHeader *mapHeader, u16 x, u16 y, u8 elevation)
 {
-    s32 i;
-    struct CoordEvent *coordEvents = mapHeader->events->coordEvents;
-    u8 coordEventCount = mapHeader->events->coordEventCount;
+    const struct MapEvents *events = mapHeader->events;
+    const u8 *sorted = sMapEventIndex.sorted[MAP_EVENT_COORD];
+    u8 coordEventCount = events->coordEventCount;
+    s32 i = FindFirstMapEventAtTile(events, MAP_EVENT_COORD, x, y);
 
-    for (i = 0; i < coordEventCount; i++)
+    for (; i < coordEventCount; i++)
     {
-        if ((u16)coordEvents[i].x == x && (u16)coordEvents[i].y == y)
+        struct CoordEvent *coordEvent = &events->coordEvents[sorted[i]];
+
+        if ((u16)coordEvent->x != x || (u16)coordEvent->y != y)
+            break;
+        if (coordEvent->elevation == elevation || coordEvent->elevation == 0)
         {
-            if (coordEvents[i].elevation == elevation || coordEvents[i].elevation == 0)
-            {
-                const u8 *script = TryRunCoordEventScript(&coordEvents[i]);
-                if (script != NULL)
-                    return script;
-            }
+            const u8 *script = TryRunCoordEventScript(coordEvent);
+            if (script != NULL)
+                return script;
         }
     }
     return NULL;
@@ -1113,17 +1212,19 @@ const u8 *GetCoordEventScriptAtMapPosition(struct MapPosition *position)
 
 static const struct BgEvent *GetBackgroundEventAtPosition(struct MapHeader *mapHeader, u16 x, u16 y, u8 elevation)
 {
-    u8 i;
-    struct BgEvent *bgEvents = mapHeader->events->bgEvents;
-    u8 bgEventCount = mapHeader->events->bgEventCount;
+    const struct MapEvents *events = mapHeader->events;
+    const u8 *sorted = sMapEventIndex.sorted[MAP_EVENT_BG];
+    u8 bgEventCount = events->bgEventCount;
+    s32 i = FindFirstMapEventAtTile(events, MAP_EVENT_BG, x, y);
 
-    for (i = 0; i < bgEventCount; i++)
+    for (; i < bgEventCount; i++)
     {
-        if ((u16)bgEvents[i].x == x && (u16)bgEvents[i].y == y)
-        {
-            if (bgEvents[i].elevation == elevation || bgEvents[i].elevation == 0)
-                return &bgEvents[i];
-        }
+        struct BgEvent *bgEvent = &events->bgEvents[sorted[i]];
+
+        if (bgEvent->x != x || bgEvent->y != y)
+            break;
+        if (bgEvent->elevation == elevation || bgEvent->elevation == 0)
+            return bgEvent;
     }
     return NULL;
 }
@@ -1,6 +1,7 @@
 #include "global.h"
 #include "gflib.h"
 #include "day_night.h"
+#include "decompress.h"
 #include "overworld.h"
 #include "script.h"
 #include "new_menu_helpers.h"
@@ -15,14 +16,15 @@ struct ConnectionFlags
     u8 east:1;
 };
 
-static void InitMapLayoutData(struct MapHeader *mapHeader);
-static void map_copy_with_padding(u16 *map, u16 width, u16 height);
-static void mapheader_copy_mapdata_of_adjacent_maps(struct MapHeader *mapHeader);
+static void InitMapLayoutData(void);
+static void map_copy_with_padding(const u16 *map, u16 width, u16 y, u16 height);
+static void FillMapConnection(struct MapHeader const *mapHeader, struct MapConnection *connection);
 static void fillSouthConnection(struct MapHeader const *mapHeader, struct MapHeader const *connectedMapHeader, s32 offset);
 static void fillNorthConnection(struct MapHeader const *mapHeader, struct MapHeader const *connectedMapHeader, s32 offset);
 static void fillWestConnection(struct MapHeader const *mapHeader, struct MapHeader const *connectedMapHeader, s32 offset);
 static void fillEastConnection(struct MapHeader const *mapHeader, struct MapHeader const *connectedMapHeader, s32 offset);
 static void LoadSavedMapView(void);
+static void BuildPackedMetatileAttributes(const struct MapLayout *mapLayout);
 static struct MapConnection *sub_8059600(u8 direction, s32 x, s32 y);
 static bool8 sub_8059658(u8 direction, s32 x, s32 y, struct MapConnection *connection);
 static bool8 sub_80596BC(s32 x, s32 src_width, s32 dest_width, s32 offset);
@@ -36,6 +38,52 @@ EWRAM_DATA u8 gGlobalFieldTintMode = QL_TINT_NONE;
 
 static const struct ConnectionFlags sDummyConnectionFlags = {};
 
+// InitMap's work on VMap, split up so a map can be loaded over several frames:
+// the fill, the layout MAP_LOAD_STEP_SIZE bytes at a time, then one
+// connection per step, the last of them along with the attribute table.
+enum
+{
+    MAP_LAYOUT_LOAD_FILL,
+    MAP_LAYOUT_LOAD_COPY,
+    MAP_LAYOUT_LOAD_CONNECTIONS,
+    MAP_LAYOUT_LOAD_DONE,
+};
+
+static EWRAM_DATA u8 sMapLayoutLoadStep = 0;
+static EWRAM_DATA u16 sMapLayoutLoadPos = 0; // next row or connection
+
+// The tilesets are copied to VRAM the same way, a slice of tiles per step.
+// Compressed ones are decompressed by a stream into a heap buffer and each
+// slice is queued for DMA as it comes out; the buffers are freed once the
+// last of them has been copied.
+struct TilesetCopy
+{
+    struct LZDecompressStream stream;
+    const struct MapLayout *mapLayout;
+    u8 *buffers[2];
+    u32 size;    // bytes of the current tileset to copy
+    u32 copied;  // bytes of it queued so far
+    u8 tileset;  // 0 primary, 1 secondary, 2 waiting for the DMA
+    bool8 started;
+};
+
+static EWRAM_DATA struct TilesetCopy sTilesetCopy = {0};
+
+// The attributes the field code looks up on every step (behavior, terrain,
+// encounter type and layer type) for each metatile of the current layout's
+// tilesets, packed into 16 bits and indexed by metatile id. Connected maps are
+// drawn with the current map's tilesets, so this covers all of VMap.
+// Metatiles whose attributes don't fit are marked PACKED_ATTRS_NONE and looked
+// up the slow way.
+#define PACKED_ATTRS_NONE 0xFFFF
+#define PACKED_BEHAVIOR(packed)       ((packed) & 0xFF)
+#define PACKED_TERRAIN(packed)        (((packed) >> 8) & 7)
+#define PACKED_ENCOUNTER_TYPE(packed) (((packed) >> 11) & 7)
+#define PACKED_LAYER_TYPE(packed)     ((packed) >> 14)
+
+static EWRAM_DATA u16 sPackedMetatileAttributes[NUM_METATILES_TOTAL] = {0};
+static EWRAM_DATA const struct MapLayout *sPackedMetatileAttributesLayout = NULL;
+
 static const u32 sMetatileAttrMasks[METATILE_ATTRIBUTE_COUNT] = {
     [METATILE_ATTRIBUTE_BEHAVIOR]       = 0x000001ff,
     [METATILE_ATTRIBUTE_TERRAIN]        = 0x00003e00,
@@ -65,36 +113,91 @@ const struct MapHeader * mapconnection_get_mapheader(struct MapConnection * conn
 
 void InitMap(void)
 {
-    InitMapLayoutData(&gMapHeader);
+    InitMapLayoutData();
     RunOnLoadMapScript();
 }
 
 void InitMapFromSavedGame(void)
 {
-    InitMapLayoutData(&gMapHeader);
+    InitMapLayoutData();
     LoadSavedMapView();
     RunOnLoadMapScript();
 }
 
-static void InitMapLayoutData(struct MapHeader * mapHeader)
+static void InitMapLayoutData(void)
 {
-    const struct MapLayout * mapLayout = mapHeader->mapLayout;
-    CpuFastFill(0x03FF03FF, gBackupMapData, sizeof(gBackupMapData));
-    VMap.map = gBackupMapData;
-    VMap.Xsize = mapLayout->width + 15;
-    VMap.Ysize = mapLayout->height + 14;
-    AGB_ASSERT_EX(VMap.Xsize * VMap.Ysize <= VIRTUAL_MAP_SIZE, ABSPATH("fieldmap.c"), 158);
-    map_copy_with_padding(mapLayout->map, mapLayout->width, mapLayout->height);
-    mapheader_copy_mapdata_of_adjacent_maps(mapHeader);
+    StartLoadMapLayout();
+    while (!LoadMapLayoutStep())
+        ;
 }
 
-static void map_copy_with_padding(u16 *map, u16 width, u16 height)
+void StartLoadMapLayout(void)
+{
+    sMapLayoutLoadStep = MAP_LAYOUT_LOAD_FILL;
+    sMapLayoutLoadPos = 0;
+}
+
+// Returns TRUE once VMap is ready for the on-load script.
+bool8 LoadMapLayoutStep(void)
+{
+    const struct MapLayout *mapLayout = gMapHeader.mapLayout;
+    const struct MapConnections *connections = gMapHeader.connections;
+    u16 rows;
+
+    switch (sMapLayoutLoadStep)
+    {
+    case MAP_LAYOUT_LOAD_FILL:
+        CpuFastFill(0x03FF03FF, gBackupMapData, sizeof(gBackupMapData));
+        VMap.map = gBackupMapData;
+        VMap.Xsize = mapLayout->width + 15;
+        VMap.Ysize = mapLayout->height + 14;
+        AGB_ASSERT_EX(VMap.Xsize * VMap.Ysize <= VIRTUAL_MAP_SIZE, ABSPATH("fieldmap.c"), 158);
+        gMapConnectionFlags = sDummyConnectionFlags;
+        sMapLayoutLoadPos = 0;
+        sMapLayoutLoadStep++;
+        break;
+    case MAP_LAYOUT_LOAD_COPY:
+        rows = MAP_LOAD_STEP_SIZE / (mapLayout->width * sizeof(u16));
+        if (rows == 0)
+            rows = 1;
+        if (rows > mapLayout->height - sMapLayoutLoadPos)
+            rows = mapLayout->height - sMapLayoutLoadPos;
+        map_copy_with_padding(mapLayout->map, mapLayout->width, sMapLayoutLoadPos, rows);
+        sMapLayoutLoadPos += rows;
+        if (sMapLayoutLoadPos >= mapLayout->height)
+        {
+            sMapLayoutLoadPos = 0;
+            sMapLayoutLoadStep++;
+        }
+        break;
+    case MAP_LAYOUT_LOAD_CONNECTIONS:
+        /*
+         * This null pointer check is new to FireRed.  It was kept in
+         * Emerald, with the connection flags reset moved to after
+         * this check.
+         */
+        if (connections != NULL && sMapLayoutLoadPos < connections->count)
+            FillMapConnection(&gMapHeader, &connections->connections[sMapLayoutLoadPos++]);
+        if (connections == NULL || sMapLayoutLoadPos >= connections->count)
+        {
+            BuildPackedMetatileAttributes(mapLayout);
+            sMapLayoutLoadStep++;
+            return TRUE;
+        }
+        break;
+    case MAP_LAYOUT_LOAD_DONE:
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void map_copy_with_padding(const u16 *map, u16 width, u16 y, u16 height)
 {
-    s32 y;
     u16 *dest = VMap.map;
-    dest += VMap.Xsize * 7 + 7;
+    dest += VMap.Xsize * (y + 7) + 7;
+    map += width * y;
 
-    for (y = 0; y < height; y++)
+    for (; height != 0; height--)
     {
         CpuCopy16(map, dest, width * sizeof(u16));
         dest += width + 15;
@@ -102,49 +205,29 @@ static void map_copy_with_padding(u16 *map, u16 width, u16 height)
     }
 }
 
-static void mapheader_copy_mapdata_of_adjacent_maps(struct MapHeader *mapHeader)
+static void FillMapConnection(struct MapHeader const *mapHeader, struct MapConnection *connection)
 {
-    s32 count;
-    struct MapConnection *connection;
-    s32 i;
-
-    gMapConnectionFlags = sDummyConnectionFlags;
+    struct MapHeader const *cMap = mapconnection_get_mapheader(connection);
+    u32 offset = connection->offset;
 
-    /*
-     * This null pointer check is new to FireRed.  It was kept in
-     * Emerald, with the above struct assignment moved to after
-     * this check.
-     */
-    if (mapHeader->connections)
+    switch (connection->direction)
     {
-        count = mapHeader->connections->count;
-        connection = mapHeader->connections->connections;
-        // Emerald puts this line here instead:
-        // gMapConnectionFlags = sDummyConnectionFlags;
-        for (i = 0; i < count; i++, connection++)
-        {
-            struct MapHeader const *cMap = mapconnection_get_mapheader(connection);
-            u32 offset = connection->offset;
-            switch (connection->direction)
-            {
-                case CONNECTION_SOUTH:
-                    fillSouthConnection(mapHeader, cMap, offset);
-                    gMapConnectionFlags.south = 1;
-                    break;
-                case CONNECTION_NORTH:
-                    fillNorthConnection(mapHeader, cMap, offset);
-                    gMapConnectionFlags.north = 1;
-                    break;
-                case CONNECTION_WEST:
-                    fillWestConnection(mapHeader, cMap, offset);
-                    gMapConnectionFlags.west = 1;
-                    break;
-                case CONNECTION_EAST:
-                    fillEastConnection(mapHeader, cMap, offset);
-                    gMapConnectionFlags.east = 1;
-                    break;
-            }
-        }
+        case CONNECTION_SOUTH:
+            fillSouthConnection(mapHeader, cMap, offset);
+            gMapConnectionFlags.south = 1;
+            break;
+        case CONNECTION_NORTH:
+            fillNorthConnection(mapHeader, cMap, offset);
+            gMapConnectionFlags.north = 1;
+            break;
+        case CONNECTION_WEST:
+            fillWestConnection(mapHeader, cMap, offset);
+            gMapConnectionFlags.west = 1;
+            break;
+        case CONNECTION_EAST:
+            fillEastConnection(mapHeader, cMap, offset);
+            gMapConnectionFlags.east = 1;
+            break;
     }
 }
 
@@ -431,9 +514,83 @@ u32 GetMetatileAttributeFromRawMetatileBehavior(u32 original, u8 bit)
     return (original & sMetatileAttrMasks[bit]) >> sMetatileAttrShifts[bit];
 }
 
+static u16 PackMetatileAttributes(u32 attributes)
+{
+    u32 behavior = GetMetatileAttributeFromRawMetatileBehavior(attributes, METATILE_ATTRIBUTE_BEHAVIOR);
+    u32 terrain = GetMetatileAttributeFromRawMetatileBehavior(attributes, METATILE_ATTRIBUTE_TERRAIN);
+    u32 encounterType = GetMetatileAttributeFromRawMetatileBehavior(attributes, METATILE_ATTRIBUTE_ENCOUNTER_TYPE);
+    u32 layerType = GetMetatileAttributeFromRawMetatileBehavior(attributes, METATILE_ATTRIBUTE_LAYER_TYPE);
+
+    if (behavior > 0xFF || terrain > 7 || encounterType > 7)
+        return PACKED_ATTRS_NONE;
+    return behavior | (terrain << 8) | (encounterType << 11) | (layerType << 14);
+}
+
+// Packs count attributes into dest and zeroes the rest of its size entries,
+// so metatile IDs past the end of a tileset read as all-zero attributes
+// rather than whatever follows its attribute array in ROM. A tileset with
+// no metatile count isn't known to end anywhere, so all of its entries are
+// left to the slow path.
+static void PackTilesetMetatileAttributes(u16 *dest, const struct Tileset *tileset, u16 size)
+{
+    u16 i;
+    u16 count = tileset->numMetatiles;
+    const u32 *attributes = tileset->metatileAttributes;
+
+    if (count == 0)
+    {
+        CpuFill16(PACKED_ATTRS_NONE, dest, size * sizeof(*dest));
+        return;
+    }
+    if (count > size)
+        count = size;
+    for (i = 0; i < count; i++)
+        dest[i] = PackMetatileAttributes(attributes[i]);
+    for (; i < size; i++)
+        dest[i] = 0;
+}
+
+static void BuildPackedMetatileAttributes(const struct MapLayout *mapLayout)
+{
+    sPackedMetatileAttributesLayout = mapLayout;
+    if (mapLayout->primaryTileset == NULL || mapLayout->secondaryTileset == NULL)
+    {
+        CpuFill16(PACKED_ATTRS_NONE, sPackedMetatileAttributes, sizeof(sPackedMetatileAttributes));
+        return;
+    }
+
+    PackTilesetMetatileAttributes(sPackedMetatileAttributes,
+                                  mapLayout->primaryTileset,
+                                  NUM_METATILES_IN_PRIMARY);
+    PackTilesetMetatileAttributes(sPackedMetatileAttributes + NUM_METATILES_IN_PRIMARY,
+                                  mapLayout->secondaryTileset,
+                                  NUM_METATILES_TOTAL - NUM_METATILES_IN_PRIMARY);
+}
+
 u32 MapGridGetMetatileAttributeAt(s16 x, s16 y, u8 attr)
 {
     u16 metatileId = MapGridGetMetatileIdAt(x, y);
+    u16 packed;
+
+    // The layout can be swapped by a script without the map being reloaded.
+    if (gMapHeader.mapLayout != sPackedMetatileAttributesLayout)
+        BuildPackedMetatileAttributes(gMapHeader.mapLayout);
+
+    packed = sPackedMetatileAttributes[metatileId];
+    if (packed != PACKED_ATTRS_NONE)
+    {
+        switch (attr)
+        {
+        case METATILE_ATTRIBUTE_BEHAVIOR:
+            return PACKED_BEHAVIOR(packed);
+        case METATILE_ATTRIBUTE_TERRAIN:
+            return PACKED_TERRAIN(packed);
+        case METATILE_ATTRIBUTE_ENCOUNTER_TYPE:
+            return PACKED_ENCOUNTER_TYPE(packed);
+        case METATILE_ATTRIBUTE_LAYER_TYPE:
+            return PACKED_LAYER_TYPE(packed);
+        }
+    }
     return GetBehaviorByMetatileIdAndMapLayout(gMapHeader.mapLayout, metatileId, attr);
 }
 
@@ -978,6 +1135,101 @@ void copy_map_tileset2_to_vram(const struct MapLayout *mapLayout)
     copy_tileset_patterns_to_vram(mapLayout->secondaryTileset, NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY, NUM_TILES_IN_PRIMARY);
 }
 
+void StartCopyMapTilesetsToVram(const struct MapLayout *mapLayout)
+{
+    sTilesetCopy.mapLayout = mapLayout;
+    sTilesetCopy.buffers[0] = NULL;
+    sTilesetCopy.buffers[1] = NULL;
+    sTilesetCopy.tileset = 0;
+    sTilesetCopy.started = FALSE;
+}
+
+static void StartTilesetCopy(const struct Tileset *tileset, u16 numTiles)
+{
+    u8 *buffer;
+
+    sTilesetCopy.started = TRUE;
+    sTilesetCopy.copied = 0;
+    sTilesetCopy.size = 0;
+    if (tileset == NULL)
+        return;
+
+    sTilesetCopy.size = numTiles * TILE_SIZE_4BPP;
+    if (tileset->isCompressed)
+    {
+        if (GetDecompressedDataSize(tileset->tiles) < sTilesetCopy.size)
+            sTilesetCopy.size = GetDecompressedDataSize(tileset->tiles);
+        buffer = Alloc(sTilesetCopy.size);
+        sTilesetCopy.buffers[sTilesetCopy.tileset] = buffer;
+        if (buffer == NULL)
+        {
+            sTilesetCopy.size = 0;
+            return;
+        }
+        LZDecompressStreamInit(&sTilesetCopy.stream, tileset->tiles, buffer, FALSE);
+        sTilesetCopy.stream.remaining = sTilesetCopy.size;
+    }
+}
+
+// Queues at most MAP_LOAD_STEP_SIZE bytes of tiles per call. Returns TRUE
+// once every slice has been copied to VRAM and the buffers are freed.
+bool8 CopyMapTilesetsToVramStep(void)
+{
+    const struct Tileset *tileset;
+    const u8 *src;
+    u16 numTiles, offset;
+    u32 size;
+
+    while (sTilesetCopy.tileset < 2)
+    {
+        if (sTilesetCopy.tileset == 0)
+        {
+            tileset = sTilesetCopy.mapLayout->primaryTileset;
+            numTiles = NUM_TILES_IN_PRIMARY;
+            offset = 0;
+        }
+        else
+        {
+            tileset = sTilesetCopy.mapLayout->secondaryTileset;
+            numTiles = NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY;
+            offset = NUM_TILES_IN_PRIMARY;
+        }
+
+        if (!sTilesetCopy.started)
+            StartTilesetCopy(tileset, numTiles);
+
+        if (sTilesetCopy.copied < sTilesetCopy.size)
+        {
+            size = sTilesetCopy.size - sTilesetCopy.copied;
+            if (size > MAP_LOAD_STEP_SIZE)
+                size = MAP_LOAD_STEP_SIZE;
+            if (tileset->isCompressed)
+            {
+                LZDecompressStreamRun(&sTilesetCopy.stream, size);
+                src = sTilesetCopy.buffers[sTilesetCopy.tileset];
+            }
+            else
+            {
+                src = tileset->tiles;
+            }
+            LoadBgTiles(2, src + sTilesetCopy.copied, size, offset + sTilesetCopy.copied / TILE_SIZE_4BPP);
+            sTilesetCopy.copied += size;
+            return FALSE;
+        }
+
+        sTilesetCopy.tileset++;
+        sTilesetCopy.started = FALSE;
+    }
+
+    if (IsDma3ManagerBusyWithBgCopy())
+        return FALSE;
+    if (sTilesetCopy.buffers[0] != NULL)
+        FREE_AND_SET_NULL(sTilesetCopy.buffers[0]);
+    if (sTilesetCopy.buffers[1] != NULL)
+        FREE_AND_SET_NULL(sTilesetCopy.buffers[1]);
+    return TRUE;
+}
+
 void copy_map_tileset2_to_vram_2(const struct MapLayout *mapLayout)
 {
     copy_tileset_patterns_to_vram2(mapLayout->secondaryTileset, NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY, NUM_TILES_IN_PRIMARY);
@@ -498,6 +498,7 @@ static bool8 LoadBagMenuGraphics(void)
         gMain.state++;
         break;
     default:
+        ListMenuAllocRowCache(sListMenuItems);
         SetVBlankCallback(VBlankCB_BagMenuRun);
         SetMainCallback2(CB2_BagMenuRun);
         return TRUE;
@@ -887,6 +888,7 @@ static void DestroyBagMenuResources(void)
     FREE_IF_SET(sBagBgTilemapBuffer);
     FREE_IF_SET(sListMenuItems);
     FREE_IF_SET(sListMenuItemStrings);
+    ListMenuFreeRowCache();
     FreeAllWindowBuffers();
 }
 
@@ -1222,6 +1224,7 @@ static void BeginMovingItemInPocket(u8 taskId, s16 itemIndex)
     ListMenuSetUnkIndicatorsStructField(data[0], 0x10, 1);
     data[1] = itemIndex;
     sBagMenuDisplay->itemOriginalLocation = itemIndex;
+    ListMenuClearRowCache();
     StringCopy(gStringVar1, ItemId_GetName(BagGetItemIdByPocketPosition(gBagMenuState.pocket + 1, data[1])));
     StringExpandPlaceholders(gStringVar4, gOtherText_WhereShouldTheStrVar1BePlaced);
     FillWindowPixelBuffer(1, PIXEL_FILL(0));
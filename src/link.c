@@ -21,6 +21,7 @@
 #include "graphics.h"
 #include "strings.h"
 #include "reset_save_heap.h"
+#include "util.h"
 #include "constants/battle.h"
 #include "constants/songs.h"
 
@@ -35,6 +36,32 @@ struct BlockTransfer
     u8 multiplayerId;
 };
 
+// Block windows split a block into windows of up to sBlockWindowPackets
+// packets, each followed by the CRC of the window. Every player acks or naks
+// every window it sees, and the sender goes back to the oldest window that
+// hasn't been acked by everyone when it gets a nak or the acks stop coming.
+struct BlockWindowSend
+{
+    u16 basePos; // start of the oldest window someone is still waiting for
+    u16 windowPos; // start of the window being sent
+    u8 baseWindow;
+    u8 window;
+    u8 packet;
+    u8 waitFrames;
+    u8 acked[MAX_LINK_PLAYERS]; // next window each player expects
+    bool8 nak;
+    bool8 transfer;
+};
+
+struct BlockWindowRecv
+{
+    u8 window;
+    u8 packet;
+    bool8 active;
+    bool8 bad; // a packet went missing; nak the window when it ends
+    bool8 transfer;
+};
+
 struct LinkTestBGInfo
 {
     u32 screenBaseBlock;
@@ -45,6 +72,30 @@ struct LinkTestBGInfo
 
 #define SIO_MULTI_CNT ((struct SioMultiCnt *)REG_ADDR_SIOCNT)
 
+#define SERIAL_TIMER_RELOAD -197
+
+#define BLOCK_PACKET_SIZE ((CMD_LENGTH - 1) * 2)
+#define BLOCK_WINDOW_PACKETS 16
+#define BLOCK_WINDOWS_IN_FLIGHT 2
+#define BLOCK_WINDOW_TIMEOUT 10
+#define BLOCK_WINDOW_NUM(n) ((n) & 0xF)
+#define BLOCK_CMD_WINDOW(cmd) (((cmd) >> 4) & 0xF)
+#define BLOCK_CMD_PACKET(cmd) ((cmd) & 0xF)
+
+#define BLOCK_INIT_WINDOWS 0x8000
+#define BLOCK_INIT_TRANSFER 0x0001
+
+#define BLOCK_ACK_VALID 0x8000
+#define BLOCK_ACK_NAK 0x4000
+#define BLOCK_ACK_TRANSFER 0x2000
+#define BLOCK_ACK_WINDOW 0x000F
+
+// While block windows are in flight, the master runs this many command cycles
+// a frame instead of one. With the shorter wait between transfers, two cycles
+// between two players still end well before the next VBlank.
+#define FAST_CYCLES_PER_FRAME 2
+#define FAST_SERIAL_TIMER_RELOAD -96
+
 static struct BlockTransfer sBlockSend;
 ALIGNED(8) static struct BlockTransfer sBlockRecv[MAX_LINK_PLAYERS];
 static u32 sBlockSendDelayCounter;
@@ -61,6 +112,14 @@ static u16 sSendNonzeroCheck;
 static u16 sRecvNonzeroCheck;
 static u8 sChecksumAvailable;
 static u8 sHandshakePlayerCount;
+static bool8 sRecvCommitPending;
+static u8 sFastCyclesLeft;
+static s16 sSerialTimerReload;
+static u8 sBlockWindowPackets; // 0 unless every player supports block windows
+static u8 sLinkBlockCaps[MAX_LINK_PLAYERS];
+static struct BlockWindowSend sBlockWindowSend;
+static struct BlockWindowRecv sBlockWindowRecv[MAX_LINK_PLAYERS];
+static u16 sBlockWindowAcks[MAX_LINK_PLAYERS];
 
 u16 gLinkPartnersHeldKeys[6];
 u32 gLinkDebugSeed;
@@ -104,6 +163,7 @@ EWRAM_DATA u32 gUnknown_2022114 = 0;
 EWRAM_DATA u16 gBlockRecvBuffer[MAX_RFU_PLAYERS][BLOCK_BUFFER_SIZE / 2] = {};
 EWRAM_DATA u8 gBlockSendBuffer[BLOCK_BUFFER_SIZE] = {};
 EWRAM_DATA bool8 gLinkOpen = FALSE;
+EWRAM_DATA bool8 gLinkBlockWindowsDisabled = FALSE;
 EWRAM_DATA u16 gLinkType = 0;
 EWRAM_DATA u16 gLinkTimeOutCounter = 0;
 EWRAM_DATA struct LinkPlayer gLocalLinkPlayer = {};
@@ -128,6 +188,13 @@ static bool32 InitBlockSend(const void *src, size_t size);
 static void LinkCB_BlockSendBegin(void);
 static void LinkCB_BlockSend(void);
 static void LinkCB_BlockSendEnd(void);
+static void ResetBlockWindows(void);
+static void NegotiateBlockWindows(void);
+static void InitBlockWindowSend(void);
+static void LinkCB_BlockWindowSend(void);
+static bool32 ProcessBlockWindowCmd(u8 who, const u16 *cmd);
+static void ProcessQueuedBlockWindows(void);
+static bool32 IsBlockWindowTransferActive(void);
 static void sub_800A3CC(void);
 static void SetBlockReceivedFlag(u8 id);
 static u16 LinkTestCalcBlockChecksum(const u16 *src, u16 size);
@@ -148,6 +215,8 @@ static void CheckMasterOrSlave(void);
 static void InitTimer(void);
 static void EnqueueSendCmd(u16 *sendCmd);
 static void DequeueRecvCmds(u16 (*recvCmds)[CMD_LENGTH]);
+static bool32 DequeueBlockWindowCmds(u16 (*recvCmds)[CMD_LENGTH]);
+static bool32 IsBlockWindowCycle(u8 index);
 static void StartTransfer(void);
 static bool8 DoHandshake(void);
 static void DoRecv(void);
@@ -369,6 +438,7 @@ void OpenLink(void)
         gSuppressLinkErrorMessage = FALSE;
         ResetBlockReceivedFlags();
         ResetBlockSend();
+        ResetBlockWindows();
         gUnknown_3000E4C = 0;
         gUnknown_3003F28 = FALSE;
         gLinkAllAcked5FFF = FALSE;
@@ -396,6 +466,7 @@ void CloseLink(void)
         LinkRfu_Shutdown();
     }
     gLinkOpen = FALSE;
+    sBlockWindowPackets = 0;
     DisableSerial();
 }
 
@@ -494,6 +565,10 @@ u16 LinkMain2(const u16 *heldKeys)
     if (gLinkStatus & LINK_STAT_CONN_ESTABLISHED)
     {
         ProcessRecvCmds(SIO_MULTI_CNT->id);
+        if (sBlockWindowPackets != 0)
+        {
+            ProcessQueuedBlockWindows();
+        }
         if (gLinkCallback != NULL)
         {
             gLinkCallback();
@@ -517,6 +592,7 @@ void HandleReceiveRemoteLinkPlayer(u8 who)
     if (count == 0 && !gReceivedRemoteLinkPlayers)
     {
         gReceivedRemoteLinkPlayers = TRUE;
+        NegotiateBlockWindows();
     }
 }
 
@@ -531,6 +607,10 @@ void ProcessRecvCmds(u8 unused)
         {
             continue;
         }
+        if (ProcessBlockWindowCmd(i, gRecvCmds[i]))
+        {
+            continue;
+        }
         switch (gRecvCmds[i][0])
         {
         case LINKCMD_SEND_LINK_TYPE:
@@ -540,8 +620,12 @@ void ProcessRecvCmds(u8 unused)
             InitLocalLinkPlayer();
             block = &gLocalLinkPlayerBlock;
             block->linkPlayer = gLocalLinkPlayer;
-            memcpy(block->magic1, sASCIIGameFreakInc, sizeof(block->magic1) - 1);
+            memcpy(block->magic1, sASCIIGameFreakInc, sizeof(block->magic1));
             memcpy(block->magic2, sASCIIGameFreakInc, sizeof(block->magic2) - 1);
+            if (gLinkBlockWindowsDisabled)
+                block->blockCaps = 0;
+            else
+                block->blockCaps = LINK_BLOCK_CAPS_WINDOWS | BLOCK_WINDOW_PACKETS;
             InitBlockSend(block, sizeof(*block));
             break;
         }
@@ -562,6 +646,11 @@ void ProcessRecvCmds(u8 unused)
             blockRecv->pos = 0;
             blockRecv->size = gRecvCmds[i][1];
             blockRecv->multiplayerId = gRecvCmds[i][2];
+            sBlockWindowRecv[i].active = (gRecvCmds[i][3] & BLOCK_INIT_WINDOWS) != 0;
+            sBlockWindowRecv[i].transfer = gRecvCmds[i][3] & BLOCK_INIT_TRANSFER;
+            sBlockWindowRecv[i].window = 0;
+            sBlockWindowRecv[i].packet = 0;
+            sBlockWindowRecv[i].bad = FALSE;
             break;
         }
         case LINKCMD_CONT_BLOCK:
@@ -613,6 +702,7 @@ void ProcessRecvCmds(u8 unused)
                     }
                     else
                     {
+                        sLinkBlockCaps[i] = block->blockCaps;
                         HandleReceiveRemoteLinkPlayer(i);
                     }
                 }
@@ -911,6 +1001,11 @@ static bool32 InitBlockSend(const void *src, size_t size)
         }
         sBlockSend.src = gBlockSendBuffer;
     }
+    if (sBlockWindowPackets != 0)
+    {
+        InitBlockWindowSend();
+        return TRUE;
+    }
     BuildSendCmd(LINKCMD_INIT_BLOCK);
     gLinkCallback = LinkCB_BlockSendBegin;
     sBlockSendDelayCounter = 0;
@@ -948,6 +1043,368 @@ static void LinkCB_BlockSendEnd(void)
 {
     gLinkCallback = NULL;
 }
+
+static void ResetBlockWindows(void)
+{
+    int i;
+
+    sBlockWindowPackets = 0;
+    sBlockWindowSend = (struct BlockWindowSend){};
+    for (i = 0; i < MAX_LINK_PLAYERS; i++)
+    {
+        sLinkBlockCaps[i] = 0;
+        sBlockWindowRecv[i] = (struct BlockWindowRecv){};
+        sBlockWindowAcks[i] = 0;
+    }
+}
+
+// Called once every player's LinkPlayerBlock has arrived, so all of them come
+// to the same answer from the same blockCaps. Windows only pay for themselves
+// when the master can run more than one command cycle a frame, which is only
+// quick enough between two players.
+static void NegotiateBlockWindows(void)
+{
+    u8 i;
+    u8 packets;
+
+    sBlockWindowPackets = 0;
+    if (gWirelessCommType || GetLinkPlayerCount_2() != 2)
+        return;
+
+    packets = BLOCK_WINDOW_PACKETS;
+    for (i = 0; i < GetLinkPlayerCount_2(); i++)
+    {
+        if (!(sLinkBlockCaps[i] & LINK_BLOCK_CAPS_WINDOWS))
+            return;
+        if (packets > (sLinkBlockCaps[i] & LINK_BLOCK_CAPS_PACKETS))
+            packets = sLinkBlockCaps[i] & LINK_BLOCK_CAPS_PACKETS;
+    }
+    sBlockWindowPackets = packets;
+}
+
+// The command words go straight into the send queue rather than through
+// gSendCmd, so that a window can take more than one command cycle a frame.
+static void InitBlockWindowSend(void)
+{
+    u16 cmd[CMD_LENGTH];
+    int i;
+
+    sBlockWindowSend.basePos = 0;
+    sBlockWindowSend.windowPos = 0;
+    sBlockWindowSend.baseWindow = 0;
+    sBlockWindowSend.window = 0;
+    sBlockWindowSend.packet = 0;
+    sBlockWindowSend.waitFrames = 0;
+    sBlockWindowSend.nak = FALSE;
+    sBlockWindowSend.transfer ^= 1;
+    for (i = 0; i < MAX_LINK_PLAYERS; i++)
+        sBlockWindowSend.acked[i] = 0;
+
+    for (i = 0; i < CMD_LENGTH; i++)
+        cmd[i] = 0;
+    cmd[0] = LINKCMD_INIT_BLOCK;
+    cmd[1] = sBlockSend.size;
+    cmd[2] = sBlockSend.multiplayerId + 0x80;
+    cmd[3] = BLOCK_INIT_WINDOWS | sBlockWindowSend.transfer;
+    EnqueueSendCmd(cmd);
+    gLinkCallback = LinkCB_BlockWindowSend;
+}
+
+// Number of bytes of the window at pos that are part of the block.
+static u16 GetBlockWindowLength(u16 pos, u16 size)
+{
+    u16 length = sBlockWindowPackets * BLOCK_PACKET_SIZE;
+
+    if (length > size - pos)
+        length = size - pos;
+    return length;
+}
+
+static void SendBlockWindowCmd(void)
+{
+    u16 cmd[CMD_LENGTH];
+    u16 length;
+    u16 pos;
+    u8 numPackets;
+    int i;
+
+    length = GetBlockWindowLength(sBlockWindowSend.windowPos, sBlockSend.size);
+    numPackets = (length + BLOCK_PACKET_SIZE - 1) / BLOCK_PACKET_SIZE;
+    if (sBlockWindowSend.packet < numPackets)
+    {
+        pos = sBlockWindowSend.windowPos + sBlockWindowSend.packet * BLOCK_PACKET_SIZE;
+        cmd[0] = LINKCMD_BLOCK_WINDOW_DATA | (BLOCK_WINDOW_NUM(sBlockWindowSend.window) << 4) | sBlockWindowSend.packet;
+        for (i = 0; i < CMD_LENGTH - 1; i++)
+        {
+            cmd[i + 1] = (sBlockSend.src[pos + i * 2 + 1] << 8) | sBlockSend.src[pos + i * 2];
+        }
+        sBlockSend.pos = pos + BLOCK_PACKET_SIZE;
+        sBlockWindowSend.packet++;
+    }
+    else
+    {
+        cmd[0] = LINKCMD_BLOCK_WINDOW_END;
+        cmd[1] = BLOCK_WINDOW_NUM(sBlockWindowSend.window);
+        cmd[2] = numPackets;
+        cmd[3] = CalcCRC16(sBlockSend.src + sBlockWindowSend.windowPos, length);
+        for (i = 4; i < CMD_LENGTH; i++)
+            cmd[i] = 0;
+        sBlockWindowSend.windowPos += sBlockWindowPackets * BLOCK_PACKET_SIZE;
+        sBlockWindowSend.window++;
+        sBlockWindowSend.packet = 0;
+    }
+    EnqueueSendCmd(cmd);
+}
+
+static void LinkCB_BlockWindowSend(void)
+{
+    u8 i;
+    u8 sent;
+    u8 acked;
+    u8 advance;
+
+    // Move the base up to the oldest window that someone still expects.
+    sent = sBlockWindowSend.window - sBlockWindowSend.baseWindow;
+    advance = sent;
+    for (i = 0; i < GetLinkPlayerCount(); i++)
+    {
+        acked = BLOCK_WINDOW_NUM(sBlockWindowSend.acked[i] - sBlockWindowSend.baseWindow);
+        if (acked > sent)
+            acked = sent;
+        if (advance > acked)
+            advance = acked;
+    }
+    if (advance != 0)
+    {
+        sBlockWindowSend.baseWindow += advance;
+        sBlockWindowSend.basePos += advance * sBlockWindowPackets * BLOCK_PACKET_SIZE;
+        sBlockWindowSend.waitFrames = 0;
+    }
+    if (sBlockWindowSend.basePos >= sBlockSend.size)
+    {
+        sBlockSend.active = FALSE;
+        gLinkCallback = NULL;
+        return;
+    }
+
+    // Go back and send everything from the base again.
+    if (sBlockWindowSend.nak || sBlockWindowSend.waitFrames > BLOCK_WINDOW_TIMEOUT)
+    {
+        sBlockWindowSend.window = sBlockWindowSend.baseWindow;
+        sBlockWindowSend.windowPos = sBlockWindowSend.basePos;
+        sBlockWindowSend.packet = 0;
+        sBlockWindowSend.nak = FALSE;
+        sBlockWindowSend.waitFrames = 0;
+    }
+
+    // Keep no more in the send queue than goes out in a frame.
+    while (gLink.sendQueue.count < FAST_CYCLES_PER_FRAME
+        && (u8)(sBlockWindowSend.window - sBlockWindowSend.baseWindow) < BLOCK_WINDOWS_IN_FLIGHT
+        && sBlockWindowSend.windowPos < sBlockSend.size)
+    {
+        SendBlockWindowCmd();
+    }
+    if ((u8)(sBlockWindowSend.window - sBlockWindowSend.baseWindow) >= BLOCK_WINDOWS_IN_FLIGHT
+        || sBlockWindowSend.windowPos >= sBlockSend.size)
+    {
+        sBlockWindowSend.waitFrames++;
+    }
+}
+
+static void QueueBlockWindowAck(u8 who, bool32 nak)
+{
+    struct BlockWindowRecv *recv = &sBlockWindowRecv[who];
+
+    sBlockWindowAcks[who] = BLOCK_ACK_VALID | BLOCK_WINDOW_NUM(recv->window);
+    if (nak)
+        sBlockWindowAcks[who] |= BLOCK_ACK_NAK;
+    if (recv->transfer)
+        sBlockWindowAcks[who] |= BLOCK_ACK_TRANSFER;
+}
+
+static void SendBlockWindowAcks(void)
+{
+    u16 cmd[CMD_LENGTH];
+    bool32 send;
+    int i;
+
+    send = FALSE;
+    cmd[0] = LINKCMD_BLOCK_WINDOW_ACK;
+    for (i = 1; i < CMD_LENGTH; i++)
+        cmd[i] = 0;
+    for (i = 0; i < MAX_LINK_PLAYERS; i++)
+    {
+        if (sBlockWindowAcks[i] != 0)
+            send = TRUE;
+        cmd[i + 1] = sBlockWindowAcks[i];
+        sBlockWindowAcks[i] = 0;
+    }
+    if (send)
+        EnqueueSendCmd(cmd);
+}
+
+static u8 *GetBlockWindowRecvBuffer(u8 who, u16 *bufferSize)
+{
+    if (sBlockRecv[who].size > BLOCK_BUFFER_SIZE)
+    {
+        *bufferSize = sizeof(gDecompressionBuffer);
+        return gDecompressionBuffer;
+    }
+    *bufferSize = BLOCK_BUFFER_SIZE;
+    return (u8 *)gBlockRecvBuffer[who];
+}
+
+// A player that dropped a cycle the others got can still be waiting for its
+// own block while the sender has moved on to the next one. Until it's done,
+// the new block is held off rather than written over the old one before it
+// has been picked up; the sender just times out and sends it again.
+static bool32 IsBlockWindowRecvHeld(u8 who)
+{
+    return gBlockReceivedStatus[who] && sBlockSend.active && who != sBlockSend.multiplayerId;
+}
+
+static void RecvBlockWindowData(u8 who, const u16 *cmd)
+{
+    struct BlockWindowRecv *recv = &sBlockWindowRecv[who];
+    u16 *dest;
+    u16 bufferSize;
+    u16 offset;
+    u8 packet;
+    u8 i;
+
+    if (!recv->active || BLOCK_CMD_WINDOW(cmd[0]) != BLOCK_WINDOW_NUM(recv->window) || IsBlockWindowRecvHeld(who))
+        return;
+
+    // The first packet always starts the window over, in case it's being
+    // sent again after its end went missing.
+    packet = BLOCK_CMD_PACKET(cmd[0]);
+    if (packet == 0)
+    {
+        recv->packet = 0;
+        recv->bad = FALSE;
+    }
+    if (recv->bad)
+        return;
+    if (packet != recv->packet)
+    {
+        recv->bad = TRUE;
+        return;
+    }
+
+    dest = (u16 *)GetBlockWindowRecvBuffer(who, &bufferSize);
+    offset = (sBlockRecv[who].pos + packet * BLOCK_PACKET_SIZE) / 2;
+    for (i = 0; i < CMD_LENGTH - 1 && offset + i < bufferSize / 2; i++)
+    {
+        dest[offset + i] = cmd[i + 1];
+    }
+    recv->packet++;
+}
+
+static void RecvBlockWindowEnd(u8 who, const u16 *cmd)
+{
+    struct BlockWindowRecv *recv = &sBlockWindowRecv[who];
+    u8 *dest;
+    u16 bufferSize;
+    u16 length;
+
+    if (!recv->active)
+    {
+        // Our ack for the last window was lost.
+        if (recv->window != 0)
+            QueueBlockWindowAck(who, FALSE);
+        return;
+    }
+    if (IsBlockWindowRecvHeld(who))
+        return;
+    if (cmd[1] != BLOCK_WINDOW_NUM(recv->window))
+    {
+        // An earlier window sent again is acked again. Later ones are
+        // ignored until the one this is waiting for is sent again.
+        if (BLOCK_WINDOW_NUM(recv->window - cmd[1]) <= BLOCK_WINDOWS_IN_FLIGHT)
+            QueueBlockWindowAck(who, FALSE);
+        return;
+    }
+
+    dest = GetBlockWindowRecvBuffer(who, &bufferSize);
+    length = GetBlockWindowLength(sBlockRecv[who].pos, sBlockRecv[who].size);
+    if (recv->bad || recv->packet != cmd[2] || CalcCRC16(dest + sBlockRecv[who].pos, length) != cmd[3])
+    {
+        recv->packet = 0;
+        recv->bad = FALSE;
+        QueueBlockWindowAck(who, TRUE);
+        return;
+    }
+
+    sBlockRecv[who].pos += length;
+    recv->window++;
+    recv->packet = 0;
+    if (sBlockRecv[who].pos >= sBlockRecv[who].size)
+    {
+        recv->active = FALSE;
+        SetBlockReceivedFlag(who);
+    }
+    QueueBlockWindowAck(who, FALSE);
+}
+
+static void RecvBlockWindowAck(u8 who, const u16 *cmd)
+{
+    u16 ack;
+
+    if (!sBlockSend.active || gLinkCallback != LinkCB_BlockWindowSend)
+        return;
+
+    ack = cmd[sBlockSend.multiplayerId + 1];
+    if (!(ack & BLOCK_ACK_VALID) || ((ack & BLOCK_ACK_TRANSFER) != 0) != sBlockWindowSend.transfer)
+        return;
+    sBlockWindowSend.acked[who] = ack & BLOCK_ACK_WINDOW;
+    if (ack & BLOCK_ACK_NAK)
+        sBlockWindowSend.nak = TRUE;
+}
+
+static bool32 ProcessBlockWindowCmd(u8 who, const u16 *cmd)
+{
+    if ((cmd[0] & 0xFF00) == LINKCMD_BLOCK_WINDOW_DATA)
+        RecvBlockWindowData(who, cmd);
+    else if (cmd[0] == LINKCMD_BLOCK_WINDOW_END)
+        RecvBlockWindowEnd(who, cmd);
+    else if (cmd[0] == LINKCMD_BLOCK_WINDOW_ACK)
+        RecvBlockWindowAck(who, cmd);
+    else
+        return FALSE;
+    return TRUE;
+}
+
+// Commands that only carry block windows are handled here as soon as they
+// arrive, rather than one a frame through gRecvCmds.
+static void ProcessQueuedBlockWindows(void)
+{
+    u16 cmds[MAX_LINK_PLAYERS][CMD_LENGTH];
+    u8 i;
+
+    while (DequeueBlockWindowCmds(cmds))
+    {
+        for (i = 0; i < gLink.playerCount; i++)
+        {
+            if (cmds[i][0] != 0)
+                ProcessBlockWindowCmd(i, cmds[i]);
+        }
+    }
+    SendBlockWindowAcks();
+}
+
+static bool32 IsBlockWindowTransferActive(void)
+{
+    int i;
+
+    if (sBlockSend.active)
+        return TRUE;
+    for (i = 0; i < MAX_LINK_PLAYERS; i++)
+    {
+        if (sBlockWindowRecv[i].active)
+            return TRUE;
+    }
+    return FALSE;
+}
 void sub_800A3AC(void)
 {
     GetMultiplayerId();
@@ -1623,7 +2080,8 @@ void PrepareLocalLinkPlayerBlock(void)
     InitLocalLinkPlayer();
     block = &gLocalLinkPlayerBlock;
     block->linkPlayer = gLocalLinkPlayer;
-    memcpy(block->magic1, sASCIIGameFreakInc, sizeof(block->magic1) - 1);
+    memcpy(block->magic1, sASCIIGameFreakInc, sizeof(block->magic1));
+    block->blockCaps = 0;
     memcpy(block->magic2, sASCIIGameFreakInc, sizeof(block->magic2) - 1);
     memcpy(gBlockSendBuffer, block, sizeof(*block));
 }
@@ -1748,6 +2206,9 @@ static void EnableSerial(void)
     sRecvNonzeroCheck = 0;
     sChecksumAvailable = 0;
     sHandshakePlayerCount = 0;
+    sRecvCommitPending = FALSE;
+    sFastCyclesLeft = 0;
+    sSerialTimerReload = SERIAL_TIMER_RELOAD;
     gLastSendQueueCount = 0;
     gLastRecvQueueCount = 0;
 }
@@ -1879,7 +2340,7 @@ static void InitTimer(void)
 {
     if (gLink.isMaster)
     {
-        REG_TM3CNT_L = -197;
+        REG_TM3CNT_L = SERIAL_TIMER_RELOAD;
         REG_TM3CNT_H = TIMER_64CLK | TIMER_INTR_ENABLE;
         EnableInterrupts(INTR_FLAG_TIMER3);
     }
@@ -1959,6 +2420,57 @@ static void DequeueRecvCmds(u16 (*recvCmds)[CMD_LENGTH])
     REG_IME = gLinkSavedIme;
 }
 
+// Whether the command cycle in the given receive queue slot only holds block
+// window commands.
+static bool32 IsBlockWindowCycle(u8 index)
+{
+    u8 i;
+    u16 cmd;
+
+    for (i = 0; i < gLink.playerCount; i++)
+    {
+        cmd = gLink.recvQueue.data[i][0][index];
+        if (cmd != 0
+         && (cmd & 0xFF00) != LINKCMD_BLOCK_WINDOW_DATA
+         && cmd != LINKCMD_BLOCK_WINDOW_END
+         && cmd != LINKCMD_BLOCK_WINDOW_ACK)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static bool32 DequeueBlockWindowCmds(u16 (*recvCmds)[CMD_LENGTH])
+{
+    u8 i;
+    u8 j;
+    bool32 dequeued;
+
+    dequeued = FALSE;
+    gLinkSavedIme = REG_IME;
+    REG_IME = 0;
+    if (gLink.recvQueue.count != 0 && IsBlockWindowCycle(gLink.recvQueue.pos))
+    {
+        for (i = 0; i < gLink.playerCount; i++)
+        {
+            for (j = 0; j < CMD_LENGTH; j++)
+            {
+                recvCmds[i][j] = gLink.recvQueue.data[i][j][gLink.recvQueue.pos];
+            }
+        }
+        gLink.recvQueue.count--;
+        gLink.recvQueue.pos++;
+        if (gLink.recvQueue.pos >= QUEUE_CAPACITY)
+        {
+            gLink.recvQueue.pos = 0;
+        }
+        dequeued = TRUE;
+    }
+    REG_IME = gLinkSavedIme;
+    return dequeued;
+}
+
 void LinkVSync(void)
 {
     if (gLink.isMaster)
@@ -1980,6 +2492,17 @@ void LinkVSync(void)
             else if (gLink.lag != LAG_MASTER)
             {
                 gLink.serialIntrCounter = 0;
+                if (sBlockWindowPackets != 0 && IsBlockWindowTransferActive())
+                {
+                    sFastCyclesLeft = FAST_CYCLES_PER_FRAME - 1;
+                    sSerialTimerReload = FAST_SERIAL_TIMER_RELOAD;
+                }
+                else
+                {
+                    sFastCyclesLeft = 0;
+                    sSerialTimerReload = SERIAL_TIMER_RELOAD;
+                }
+                REG_TM3CNT_L = sSerialTimerReload;
                 StartTransfer();
             }
             break;
@@ -2110,17 +2633,33 @@ static void DoRecv(void)
     u16 recv[4];
     u8 i;
     u8 index;
+    bool8 badChecksum;
 
     *(u64 *)recv = REG_SIOMLT_RECV;
     if (gLink.sendCmdIndex == 0)
     {
+        badChecksum = FALSE;
         for (i = 0; i < gLink.playerCount; i++)
         {
             if (gLink.checksum != recv[i] && sChecksumAvailable)
             {
-                gLink.badChecksum = TRUE;
+                badChecksum = TRUE;
             }
         }
+        // A command cycle that only carried block windows is dropped rather
+        // than failing the link; the windows it was part of get sent again.
+        if (sRecvCommitPending)
+        {
+            if (!badChecksum)
+            {
+                gLink.recvQueue.count++;
+            }
+            sRecvCommitPending = FALSE;
+        }
+        else if (badChecksum)
+        {
+            gLink.badChecksum = TRUE;
+        }
         gLink.checksum = 0;
         sChecksumAvailable = TRUE;
     }
@@ -2147,7 +2686,14 @@ static void DoRecv(void)
         gLink.recvCmdIndex++;
         if (gLink.recvCmdIndex == CMD_LENGTH && sRecvNonzeroCheck)
         {
-            gLink.recvQueue.count++;
+            if (sBlockWindowPackets != 0 && IsBlockWindowCycle(index))
+            {
+                sRecvCommitPending = TRUE;
+            }
+            else
+            {
+                gLink.recvQueue.count++;
+            }
             sRecvNonzeroCheck = 0;
         }
     }
@@ -2195,7 +2741,7 @@ static void StopTimer(void)
     if (gLink.isMaster)
     {
         REG_TM3CNT_H &= ~TIMER_ENABLE;
-        REG_TM3CNT_L = -197;
+        REG_TM3CNT_L = sSerialTimerReload;
     }
 }
 
@@ -2205,6 +2751,11 @@ static void SendRecvDone(void)
     {
         gLink.sendCmdIndex = 0;
         gLink.recvCmdIndex = 0;
+        if (gLink.isMaster && sFastCyclesLeft != 0)
+        {
+            sFastCyclesLeft--;
+            REG_TM3CNT_H |= TIMER_ENABLE;
+        }
     }
     else if (gLink.isMaster)
     {
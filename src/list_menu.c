@@ -53,6 +53,28 @@ struct ListMenuOverride
     bool8 enabled:1;
 };
 
+// Enough for the bag and TM case lists: a 20-tile wide window with
+// 16-pixel rows, and the 5 or 6 rows they show plus a couple more. Wider
+// windows or taller rows just aren't cached.
+#define ROW_CACHE_SLOTS       8
+#define ROW_CACHE_MAX_WIDTH   20
+#define ROW_CACHE_MAX_HEIGHT  16
+#define ROW_CACHE_EMPTY       0xFFFF
+
+// The cache only saves printing text again, so it isn't allocated unless
+// this much of the heap would still be free besides it.
+#define ROW_CACHE_HEAP_RESERVE 0x2000
+
+// Rendered rows of one list, keyed by their position in items. Each slot
+// holds the row one pixel line at a time, one word per tile of the line.
+struct ListMenuRowCache
+{
+    const struct ListMenuItem *items;
+    u16 rowIds[ROW_CACHE_SLOTS];
+    u8 nextSlot;
+    u32 lines[ROW_CACHE_SLOTS][ROW_CACHE_MAX_WIDTH * ROW_CACHE_MAX_HEIGHT];
+};
+
 struct MoveMenuInfoIcon
 {
     u8 width;
@@ -61,6 +83,7 @@ struct MoveMenuInfoIcon
 };
 
 static EWRAM_DATA struct MysteryGiftLinkMenuStruct sMysteryGiftLinkMenu = {0};
+static EWRAM_DATA struct ListMenuRowCache *sListMenuRowCache = NULL;
 
 struct ListMenuOverride gListMenuOverride;
 struct ListMenuTemplate gMultiuseListMenuTemplate;
@@ -71,6 +94,7 @@ static void ListMenuPrintEntries(struct ListMenu *list, u16 startIndex, u16 yOff
 static void ListMenuDrawCursor(struct ListMenu *list);
 static void ListMenuCallSelectionChangedCallback(struct ListMenu *list, u8 onInit);
 static u8 ListMenuAddCursorObject(struct ListMenu *list, u32 cursorKind);
+static void ListMenuClearRowCacheFor(const struct ListMenuItem *items);
 
 const struct MoveMenuInfoIcon gMoveMenuInfoIcons[] =
 {
@@ -263,6 +287,7 @@ void DestroyListMenuTask(u8 listTaskId, u16 *cursorPos, u16 *itemsAbove)
     if (list->taskId != TAIL_SENTINEL)
         ListMenuRemoveCursorObject(list->taskId, list->template.cursorKind - 2);
 
+    ListMenuClearRowCacheFor(list->template.items);
     DestroyTask(listTaskId);
 }
 
@@ -270,6 +295,7 @@ void RedrawListMenu(u8 listTaskId)
 {
     struct ListMenu *list = (struct ListMenu *)gTasks[listTaskId].data;
 
+    ListMenuClearRowCacheFor(list->template.items);
     FillWindowPixelBuffer(list->template.windowId, PIXEL_FILL(list->template.fillValue));
     ListMenuPrintEntries(list, list->cursorPos, 0, list->template.maxShowed);
     ListMenuDrawCursor(list);
@@ -360,6 +386,7 @@ static u8 ListMenuInitInternal(const struct ListMenuTemplate *listMenuTemplate,
     gListMenuOverride.enabled = FALSE;
     if (list->template.totalItems < list->template.maxShowed)
         list->template.maxShowed = list->template.totalItems;
+    ListMenuClearRowCacheFor(list->template.items);
     FillWindowPixelBuffer(list->template.windowId, PIXEL_FILL(list->template.fillValue));
     ListMenuPrintEntries(list, list->cursorPos, 0, list->template.maxShowed);
     ListMenuDrawCursor(list);
@@ -388,10 +415,125 @@ static void ListMenuPrint(struct ListMenu *list, const u8 *str, u8 x, u8 y)
     }
 }
 
+// Call once the menu has allocated everything else it needs. Lists are
+// drawn the same without the cache, so running out of heap isn't an error.
+void ListMenuAllocRowCache(const struct ListMenuItem *items)
+{
+    void *reserve;
+
+    if (sListMenuRowCache == NULL)
+    {
+        reserve = Alloc(ROW_CACHE_HEAP_RESERVE);
+        if (reserve != NULL)
+        {
+            sListMenuRowCache = Alloc(sizeof(struct ListMenuRowCache));
+            Free(reserve);
+        }
+    }
+    if (sListMenuRowCache != NULL)
+    {
+        sListMenuRowCache->items = items;
+        ListMenuClearRowCache();
+    }
+}
+
+void ListMenuFreeRowCache(void)
+{
+    if (sListMenuRowCache != NULL)
+    {
+        Free(sListMenuRowCache);
+        sListMenuRowCache = NULL;
+    }
+}
+
+// For callers whose itemPrintFunc output changes without the list being
+// rebuilt, e.g. the bag marking the item being moved.
+void ListMenuClearRowCache(void)
+{
+    u8 i;
+
+    if (sListMenuRowCache != NULL)
+    {
+        for (i = 0; i < ROW_CACHE_SLOTS; i++)
+            sListMenuRowCache->rowIds[i] = ROW_CACHE_EMPTY;
+        sListMenuRowCache->nextSlot = 0;
+    }
+}
+
+static void ListMenuClearRowCacheFor(const struct ListMenuItem *items)
+{
+    if (sListMenuRowCache != NULL && sListMenuRowCache->items == items)
+        ListMenuClearRowCache();
+}
+
+static bool8 ListMenuCanCacheRow(struct ListMenu *list, u8 y, u8 height)
+{
+    u8 windowId = list->template.windowId;
+
+    if (sListMenuRowCache == NULL || sListMenuRowCache->items != list->template.items)
+        return FALSE;
+    // The override only applies to the next print, so that row can't be reused.
+    if (gListMenuOverride.enabled)
+        return FALSE;
+    return gWindows[windowId].window.width <= ROW_CACHE_MAX_WIDTH
+        && height <= ROW_CACHE_MAX_HEIGHT
+        && y + height <= gWindows[windowId].window.height * 8;
+}
+
+// Copies the pixel lines [y, y + height) between the window and a cache
+// slot. Lines of a tile row are 4 bytes apart within each 32-byte tile.
+static void ListMenuCopyRowLines(struct ListMenu *list, u32 *lines, u8 y, u8 height, bool8 toWindow)
+{
+    u8 windowId = list->template.windowId;
+    u8 width = gWindows[windowId].window.width;
+    u8 i, j;
+    u32 *dest;
+
+    for (i = 0; i < height; i++, y++)
+    {
+        dest = (u32 *)(gWindows[windowId].tileData + ((y / 8) * width) * TILE_SIZE_4BPP + (y % 8) * 4);
+        for (j = 0; j < width; j++)
+        {
+            if (toWindow)
+                dest[j * 8] = *lines;
+            else
+                *lines = dest[j * 8];
+            lines++;
+        }
+    }
+}
+
+static bool8 ListMenuRestoreCachedRow(struct ListMenu *list, u16 itemIndex, u8 y, u8 height)
+{
+    u8 i;
+
+    for (i = 0; i < ROW_CACHE_SLOTS; i++)
+    {
+        if (sListMenuRowCache->rowIds[i] == itemIndex)
+        {
+            ListMenuCopyRowLines(list, sListMenuRowCache->lines[i], y, height, TRUE);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void ListMenuCacheRow(struct ListMenu *list, u16 itemIndex, u8 y, u8 height)
+{
+    u8 slot = sListMenuRowCache->nextSlot;
+
+    ListMenuCopyRowLines(list, sListMenuRowCache->lines[slot], y, height, FALSE);
+    sListMenuRowCache->rowIds[slot] = itemIndex;
+    if (++slot >= ROW_CACHE_SLOTS)
+        slot = 0;
+    sListMenuRowCache->nextSlot = slot;
+}
+
 static void ListMenuPrintEntries(struct ListMenu *list, u16 startIndex, u16 yOffset, u16 count)
 {
     s32 i;
     u8 x, y;
+    bool8 cacheRow;
     u8 yMultiplier = GetFontAttribute(list->template.fontId, FONTATTR_MAX_LETTER_HEIGHT) + list->template.itemVerticalPadding;
 
     for (i = 0; i < count; i++)
@@ -401,9 +543,19 @@ static void ListMenuPrintEntries(struct ListMenu *list, u16 startIndex, u16 yOff
         else
             x = list->template.header_X;
         y = (yOffset + i) * yMultiplier + list->template.upText_Y;
+        // Rows are only printed onto freshly filled lines, so a cached copy
+        // of the whole row is exactly what printing it again would produce.
+        cacheRow = ListMenuCanCacheRow(list, y, yMultiplier);
+        if (cacheRow && ListMenuRestoreCachedRow(list, startIndex, y, yMultiplier))
+        {
+            startIndex++;
+            continue;
+        }
         if (list->template.itemPrintFunc != NULL)
             list->template.itemPrintFunc(list->template.windowId, list->template.items[startIndex].index, y);
         ListMenuPrint(list, list->template.items[startIndex].label, x, y);
+        if (cacheRow)
+            ListMenuCacheRow(list, startIndex, y, yMultiplier);
         startIndex++;
     }
 }
@@ -7,6 +7,7 @@
 #include "item.h"
 #include "save_location.h"
 #include "berry_powder.h"
+#include "event_object_movement.h"
 #include "overworld.h"
 #include "quest_log.h"
 
@@ -190,6 +191,7 @@ void LoadObjectEvents(void)
 
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
         gObjectEvents[i] = gSaveBlock2Ptr->objectEvents[i];
+    RebuildObjectEventOccupancy();
 }
 
 void SaveSerializedGame(void)
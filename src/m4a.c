@@ -4,7 +4,8 @@ extern const u8 gCgb3Vol[];
 
 #define BSS_CODE __attribute__((section(".bss.code")))
 
-BSS_CODE ALIGNED(4) char SoundMainRAM_Buffer[0xB40] = {0};
+// Must hold SoundMainRAM up to SoundMainRAM_End in src/m4a_1.s (0xBB4 bytes).
+BSS_CODE ALIGNED(4) char SoundMainRAM_Buffer[0xBC0] = {0};
 BSS_CODE ALIGNED(4) u32 hq_buffer_ptr[0xE0] = {0};
 
 EWRAM_DATA struct SoundInfo gSoundInfo;
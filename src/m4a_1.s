@@ -1056,20 +1056,9 @@ C_main_mixer_return:
 	.arm
 	.align 2
 
-C_downsampler:
-	ldr r8, [sp, #ARG_FRAME_LENGTH]
-	ldr r9, [sp, #ARG_BUFFER_POS]
-.if ENABLE_REVERB==1
-	orr r2, r2, r2, lsl#16
-	movne r3, r8
-	addeq r3, r3, #VAR_PCM_BUFFER
-	subeq r3, r3, r9
-.endif
-	ldr r10, hq_buffer_literal
-	mov r11, #0xFF00
-	mov lr, #0xC0000000
-
-C_downsampler_loop:
+	@ Noise shapes the two stereo samples in hq_buffer_ptr at r10 down to
+	@ 8 bits, leaving the left pair in r6 and the right pair in r7.
+	.macro downsample_pair
 	ldmia r10, {r0, r1}
 	add r12, r4, r0         @ left sample #1
 	adds r4, r12, r12
@@ -1096,8 +1085,28 @@ C_downsampler_loop:
 	and r5, r12, #0x007F0000
 	and r12, r11, r12, lsr#15
 	orr r7, r12, r7, lsr#8
+	.endm
 
+C_downsampler:
+	ldr r8, [sp, #ARG_FRAME_LENGTH]
+	ldr r9, [sp, #ARG_BUFFER_POS]
+.if ENABLE_REVERB==1
+	orr r2, r2, r2, lsl#16
+	movne r3, r8
+	addeq r3, r3, #VAR_PCM_BUFFER
+	subeq r3, r3, r9
+.endif
+	ldr r10, hq_buffer_literal
+	mov r11, #0xFF00
+	mov lr, #0xC0000000
 .if ENABLE_REVERB==1
+	cmp r2, #0                         @ with no reverb the feedback is always #0,
+	moveq r3, #0                       @ so take the loop that doesn't read back
+	beq C_downsampler_dry_loop         @ the old buffer and clears hq_buffer_ptr
+
+C_downsampler_loop:
+	downsample_pair
+
 	ldrsh r12, [r9, r3]!
 
 	mov r1, r12, asr#8
@@ -1130,16 +1139,23 @@ C_downsampler_loop:
 	mul r0, r2, r0
 
 	stmia r10!, {r0, r1}
-.else /* if ENABLE_REVERB==0 */
+	subs r8, #2
+	bgt C_downsampler_loop
+	b C_downsampler_end
+.endif
+
+C_downsampler_dry_loop:
+	downsample_pair
+
 	mov r0, #PCM_DMA_BUF_SIZE
 	strh r6, [r9, r0]
 	strh r7, [r9], #2
 
 	stmia r10!, {r2, r3}
-.endif
 	subs r8, #2
-	bgt C_downsampler_loop
+	bgt C_downsampler_dry_loop
 
+C_downsampler_end:
 	adr r0, (C_downsampler_return+1)
 	bx r0
 
@@ -1342,6 +1358,11 @@ SoundMainRAM_End:
 	.syntax unified
 	thumb_func_end SoundMainRAM
 
+@ m4aSoundInit copies this much into SoundMainRAM_Buffer in src/m4a.c.
+.if SoundMainRAM_End - SoundMainRAM > 0xBC0
+	.error "SoundMainRAM no longer fits in SoundMainRAM_Buffer"
+.endif
+
 	thumb_func_start SoundMainBTM
 SoundMainBTM:
 	mov r12, r4
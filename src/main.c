@@ -16,6 +16,7 @@
 #include "save_failed_screen.h"
 #include "quest_log.h"
 #include "mgba.h"
+#include "profiler.h"
 
 extern u32 intr_main[];
 
@@ -144,6 +145,9 @@ void AgbMain()
     InitHeap(gHeap, HEAP_SIZE);
     SetDefaultFontsPointer();
     mgba_open();
+#if PROFILE
+    Profiler_Init();
+#endif
 
     gSoftResetDisabled = FALSE;
 
@@ -160,6 +164,9 @@ void AgbMain()
 
     for (;;)
     {
+#if PROFILE
+        Profiler_FrameTick();
+#endif
         ReadKeys();
 
         if (gSoftResetDisabled == FALSE
@@ -224,7 +231,11 @@ static void CallCallbacks(void)
             gMain.callback1();
 
         if (gMain.callback2)
+        {
+            PROFILE_BEGIN(PROFILER_SCOPE_CALLBACK2);
             gMain.callback2();
+            PROFILE_END(PROFILER_SCOPE_CALLBACK2);
+        }
     }
 }
 
@@ -360,6 +371,7 @@ extern void ProcessDma3Requests(void);
 
 static void VBlankIntr(void)
 {
+    PROFILE_BEGIN(PROFILER_SCOPE_VBLANK);
     if (gWirelessCommType)
         RFUVSync();
     else if (!gLinkVSyncDisabled)
@@ -374,14 +386,18 @@ static void VBlankIntr(void)
     gMain.vblankCounter2++;
 
     CopyBufferedValuesToGpuRegs();
+    PROFILE_BEGIN(PROFILER_SCOPE_DMA3_REQUESTS);
     ProcessDma3Requests();
+    PROFILE_END(PROFILER_SCOPE_DMA3_REQUESTS);
 
     gPcmDmaCounter = gSoundInfo.pcmDmaCounter;
 
 #ifndef NDEBUG
     sVcountBeforeSound = REG_VCOUNT;
 #endif
+    PROFILE_BEGIN(PROFILER_SCOPE_SOUND_MAIN);
     m4aSoundMain();
+    PROFILE_END(PROFILER_SCOPE_SOUND_MAIN);
 #ifndef NDEBUG
     sVcountAfterSound = REG_VCOUNT;
 #endif
@@ -392,6 +408,7 @@ static void VBlankIntr(void)
 
     INTR_CHECK |= INTR_FLAG_VBLANK;
     gMain.intrCheck |= INTR_FLAG_VBLANK;
+    PROFILE_END(PROFILER_SCOPE_VBLANK);
 }
 
 void InitFlashTimer(void)
@@ -33,7 +33,7 @@
 void mgba_printf(int level, const char* ptr, ...) {
 	va_list args;
 
-#if !DEBUG
+#if !DEBUG && !PROFILE
 	// Return for performance reasons.
 	// printf shouldn't have been called in the
 	// first place, but this is a failsafe.
@@ -33,6 +33,7 @@
 #include "new_menu_helpers.h"
 #include "overworld.h"
 #include "play_time.h"
+#include "profiler.h"
 #include "quest_log.h"
 #include "quest_log_objects.h"
 #include "random.h"
@@ -68,6 +69,11 @@
 #define FACING_FORCED_LEFT 9
 #define FACING_FORCED_RIGHT 10
 
+// CB2_LoadMap2 stops starting load steps once the frame reaches this
+// scanline. The 40 lines left before VBlank leave room for the step that
+// crosses it and the rest of the frame.
+#define LOAD_MAP_LAST_STEP_LINE 120
+
 typedef u16 (*KeyInterCB)(u32 key);
 
 struct InitialPlayerAvatarState
@@ -144,6 +150,7 @@ static void VBlankCB_Field(void);
 static bool32 map_loading_iteration_3(u8 *state);
 static bool32 sub_8056CD8(u8 *state);
 static bool32 map_loading_iteration_2_link(u8 *state);
+static bool32 load_map_stuff(u8 *state, bool32 a1);
 static void do_load_map_stuff_loop(u8 *state);
 static void MoveSaveBlocks_ResetHeap_(void);
 static void sub_8056E80(void);
@@ -428,6 +435,7 @@ static void LoadObjEventTemplatesFromHeader(void)
             j++;
         }
     }
+    InvalidateObjectEventTemplateIndex();
 }
 
 static void LoadSaveblockObjEventScripts(void)
@@ -452,6 +460,7 @@ void Overworld_SetMapObjTemplateCoords(u8 localId, s16 x, s16 y)
         {
             savObjTemplates[i].x = x;
             savObjTemplates[i].y = y;
+            InvalidateObjectEventTemplateIndex();
             break;
         }
     }
@@ -783,7 +792,8 @@ void LoadMapFromCameraTransition(u8 mapGroup, u8 mapNum)
         ShowMapNamePopup(TRUE);
 }
 
-static void mli0_load_map(bool32 a1)
+// Everything mli0_load_map does before building VMap.
+static void LoadMapDataBeforeLayout(void)
 {
     bool8 isOutdoors;
 
@@ -808,6 +818,11 @@ static void mli0_load_map(bool32 a1)
     UpdateLocationHistoryForRoamer();
     RoamerMoveToOtherLocationSet();
     sub_8110920();
+}
+
+static void mli0_load_map(bool32 a1)
+{
+    LoadMapDataBeforeLayout();
     InitMap();
 }
 
@@ -1490,6 +1505,7 @@ static void OverworldBasic(void)
     ScriptContext2_RunScript();
     RunTasks();
     AnimateSprites();
+    SpawnPendingObjectEvents();
     CameraUpdate();
     sub_8115798();
     UpdateCameraPanning();
@@ -1598,9 +1614,26 @@ void CB2_LoadMap(void)
     gMain.savedCallback = CB2_LoadMap2;
 }
 
+// As many steps of the load per frame as fit before LOAD_MAP_LAST_STEP_LINE,
+// so small maps still load in a frame or two and only the steps that don't
+// fit go on to the next one.
 static void CB2_LoadMap2(void)
 {
-    do_load_map_stuff_loop(&gMain.state);
+    bool32 done;
+    u32 vblanks = gMain.vblankCounter2;
+    u16 vcount;
+
+    PROFILE_BEGIN(PROFILER_SCOPE_LOAD_MAP_STEPS);
+    do
+    {
+        done = load_map_stuff(&gMain.state, FALSE);
+        vcount = REG_VCOUNT;
+    } while (!done && gMain.vblankCounter2 == vblanks
+          && !(vcount >= LOAD_MAP_LAST_STEP_LINE && vcount < DISPLAY_HEIGHT));
+    PROFILE_END(PROFILER_SCOPE_LOAD_MAP_STEPS);
+    if (!done)
+        return;
+
     if (QuestLog_ShouldEndSceneOnMapChange() == TRUE)
     {
         QuestLog_AdvancePlayhead_();
@@ -1879,23 +1912,31 @@ static bool32 load_map_stuff(u8 *state, bool32 a1)
     case 0:
         InitOverworldBgs();
         FieldClearVBlankHBlankCallbacks();
-        mli0_load_map(a1);
+        LoadMapDataBeforeLayout();
+        StartLoadMapLayout();
         (*state)++;
         break;
     case 1:
+        if (LoadMapLayoutStep())
+        {
+            RunOnLoadMapScript();
+            (*state)++;
+        }
+        break;
+    case 2:
         QuestLog_InitPalettesBackup();
         (*state)++;
         break;
-    case 2:
+    case 3:
         sub_8057024(a1);
         (*state)++;
         break;
-    case 3:
+    case 4:
         if (QuestLog_ShouldEndSceneOnMapChange() == TRUE)
             return TRUE;
         (*state)++;
         break;
-    case 4:
+    case 5:
         mli4_mapscripts_and_other();
         sub_8057114();
         if (gQuestLogState != QL_STATE_PLAYBACK)
@@ -1905,22 +1946,19 @@ static bool32 load_map_stuff(u8 *state, bool32 a1)
         }
         (*state)++;
         break;
-    case 5:
+    case 6:
         InitCurrentFlashLevelScanlineEffect();
         InitOverworldGraphicsRegisters();
         (*state)++;
         break;
-    case 6:
-        move_tilemap_camera_to_upper_left_corner();
-        (*state)++;
-        break;
     case 7:
-        copy_map_tileset1_to_vram(gMapHeader.mapLayout);
+        move_tilemap_camera_to_upper_left_corner();
+        StartCopyMapTilesetsToVram(gMapHeader.mapLayout);
         (*state)++;
         break;
     case 8:
-        copy_map_tileset2_to_vram(gMapHeader.mapLayout);
-        (*state)++;
+        if (CopyMapTilesetsToVramStep())
+            (*state)++;
         break;
     case 9:
         if (FreeTempTileDataBuffersIfPossible() != TRUE)
@@ -3327,6 +3365,7 @@ static void InitLinkPlayerObjectEventPos(struct ObjectEvent *objEvent, s16 x, s1
     SetSpritePosToMapCoords(x, y, &objEvent->initialCoords.x, &objEvent->initialCoords.y);
     objEvent->initialCoords.x += 8;
     ObjectEventUpdateZCoord(objEvent);
+    UpdateObjectEventOccupancy(objEvent);
 }
 
 static void SetLinkPlayerObjectRange(u8 linkPlayerId, u8 dir)
@@ -3348,6 +3387,7 @@ static void DestroyLinkPlayerObject(u8 linkPlayerId)
         DestroySprite(&gSprites[objEvent->spriteId]);
     linkPlayerObjEvent->active = FALSE;
     objEvent->active = FALSE;
+    UpdateObjectEventOccupancy(objEvent);
 }
 
 // Returns the spriteId corresponding to this player.
@@ -3,6 +3,7 @@
 #include "day_night.h"
 #include "util.h"
 #include "decompress.h"
+#include "profiler.h"
 #include "task.h"
 
 enum
@@ -119,6 +120,8 @@ u8 UpdatePaletteFade(void)
 
     if (sPlttBufferTransferPending)
         return PALETTE_FADE_STATUS_LOADING;
+
+    PROFILE_BEGIN(PROFILER_SCOPE_UPDATE_PALETTE_FADE);
     if (gPaletteFade.mode == NORMAL_FADE)
         result = UpdateNormalPaletteFade();
     else if (gPaletteFade.mode == FAST_FADE)
@@ -126,6 +129,7 @@ u8 UpdatePaletteFade(void)
     else
         result = UpdateHardwarePaletteFade();
     sPlttBufferTransferPending = gPaletteFade.multipurpose1 | dummy;
+    PROFILE_END(PROFILER_SCOPE_UPDATE_PALETTE_FADE);
     return result;
 }
 
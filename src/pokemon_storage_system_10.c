@@ -0,0 +1,178 @@
+#include "global.h"
+#include "gflib.h"
+#include "pokemon_storage_system_internal.h"
+#include "constants/items.h"
+
+// ******************************************************************
+// Box index
+// ******************************************************************
+// A compact copy of the fields the PC searches and sorts on, so that
+// finding a mon across all boxes doesn't have to walk every BoxPokemon.
+// It is built when the PC opens and kept in sync by the box accessors
+// in pokemon_storage_system.c.
+
+static EWRAM_DATA struct BoxIndexEntry (*sBoxIndex)[IN_BOX_COUNT] = NULL;
+
+static void SetBoxIndexEntry(struct BoxIndexEntry *entry, struct BoxPokemon *boxMon);
+static u32 GetBoxIndexSortKey(const struct BoxIndexEntry *entry, u8 sortMode);
+
+bool8 CreateBoxIndex(void)
+{
+    u8 boxId, boxPosition;
+
+    if (sBoxIndex == NULL)
+        sBoxIndex = Alloc(sizeof(struct BoxIndexEntry) * TOTAL_BOXES_COUNT * IN_BOX_COUNT);
+    if (sBoxIndex == NULL)
+        return FALSE;
+
+    for (boxId = 0; boxId < TOTAL_BOXES_COUNT; boxId++)
+    {
+        for (boxPosition = 0; boxPosition < IN_BOX_COUNT; boxPosition++)
+            SetBoxIndexEntry(&sBoxIndex[boxId][boxPosition], GetBoxedMonPtr(boxId, boxPosition));
+    }
+
+    return TRUE;
+}
+
+void DestroyBoxIndex(void)
+{
+    FREE_AND_SET_NULL(sBoxIndex);
+}
+
+bool8 IsBoxIndexActive(void)
+{
+    return (sBoxIndex != NULL);
+}
+
+void UpdateBoxIndexAt(u8 boxId, u8 boxPosition)
+{
+    if (sBoxIndex != NULL && boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+        SetBoxIndexEntry(&sBoxIndex[boxId][boxPosition], GetBoxedMonPtr(boxId, boxPosition));
+}
+
+const struct BoxIndexEntry *GetBoxIndexEntry(u8 boxId, u8 boxPosition)
+{
+    if (sBoxIndex != NULL && boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+        return &sBoxIndex[boxId][boxPosition];
+    else
+        return NULL;
+}
+
+static void SetBoxIndexEntry(struct BoxIndexEntry *entry, struct BoxPokemon *boxMon)
+{
+    u32 personality;
+
+    entry->species = GetBoxMonData(boxMon, MON_DATA_SPECIES, NULL);
+    if (entry->species == SPECIES_NONE)
+    {
+        entry->heldItem = ITEM_NONE;
+        entry->level = 0;
+        entry->nature = 0;
+        entry->isShiny = FALSE;
+        entry->isEgg = FALSE;
+        return;
+    }
+
+    personality = GetBoxMonData(boxMon, MON_DATA_PERSONALITY, NULL);
+    entry->heldItem = GetBoxMonData(boxMon, MON_DATA_HELD_ITEM, NULL);
+    entry->level = GetLevelFromBoxMonExp(boxMon);
+    entry->nature = personality % 25;
+    entry->isShiny = IsShinyOtIdPersonality(GetBoxMonData(boxMon, MON_DATA_OT_ID, NULL), personality);
+    entry->isEgg = GetBoxMonData(boxMon, MON_DATA_IS_EGG, NULL);
+}
+
+// Looks for the next slot after (*boxId, *boxPosition) holding the given
+// species, wrapping around through every box. The starting slot itself is
+// checked last. Eggs never match.
+bool8 FindNextBoxMonWithSpecies(u16 species, u8 *boxId, u8 *boxPosition)
+{
+    u16 i;
+    u16 slot;
+    const struct BoxIndexEntry *entry;
+
+    if (sBoxIndex == NULL || species == SPECIES_NONE)
+        return FALSE;
+
+    slot = *boxId * IN_BOX_COUNT + *boxPosition;
+    for (i = 0; i < TOTAL_BOXES_COUNT * IN_BOX_COUNT; i++)
+    {
+        if (++slot >= TOTAL_BOXES_COUNT * IN_BOX_COUNT)
+            slot = 0;
+
+        entry = &sBoxIndex[slot / IN_BOX_COUNT][slot % IN_BOX_COUNT];
+        if (entry->species == species && !entry->isEgg)
+        {
+            *boxId = slot / IN_BOX_COUNT;
+            *boxPosition = slot % IN_BOX_COUNT;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+// Empty slots always sort last, with Eggs just before them.
+static u32 GetBoxIndexSortKey(const struct BoxIndexEntry *entry, u8 sortMode)
+{
+    u16 dexNum;
+
+    if (entry->species == SPECIES_NONE)
+        return 0xFFFFFFFF;
+    if (entry->isEgg)
+        return 0xFFFFFFFE;
+
+    dexNum = SpeciesToNationalPokedexNum(entry->species);
+    if (sortMode == BOX_SORT_LEVEL)
+        return ((MAX_LEVEL - entry->level) << 16) | dexNum;
+    else
+        return (dexNum << 8) | (MAX_LEVEL - entry->level);
+}
+
+// Returns FALSE if the box was already in order and nothing was moved.
+bool8 SortBoxByIndex(u8 boxId, u8 sortMode)
+{
+    u8 order[IN_BOX_COUNT];
+    u32 keys[IN_BOX_COUNT];
+    struct BoxPokemon *boxMons;
+    u8 i, j, temp;
+    bool8 changed;
+
+    if (sBoxIndex == NULL || boxId >= TOTAL_BOXES_COUNT)
+        return FALSE;
+
+    for (i = 0; i < IN_BOX_COUNT; i++)
+    {
+        order[i] = i;
+        keys[i] = GetBoxIndexSortKey(&sBoxIndex[boxId][i], sortMode);
+    }
+
+    // Insertion sort keeps mons with equal keys in their current order.
+    for (i = 1; i < IN_BOX_COUNT; i++)
+    {
+        temp = order[i];
+        for (j = i; j > 0 && keys[order[j - 1]] > keys[temp]; j--)
+            order[j] = order[j - 1];
+        order[j] = temp;
+    }
+
+    changed = FALSE;
+    for (i = 0; i < IN_BOX_COUNT; i++)
+    {
+        if (order[i] != i)
+            changed = TRUE;
+    }
+    if (!changed)
+        return FALSE;
+
+    boxMons = Alloc(sizeof(struct BoxPokemon) * IN_BOX_COUNT);
+    if (boxMons == NULL)
+        return FALSE;
+
+    for (i = 0; i < IN_BOX_COUNT; i++)
+        CopyBoxMonAt(boxId, order[i], &boxMons[i]);
+    for (i = 0; i < IN_BOX_COUNT; i++)
+        SetBoxMonAt(boxId, i, &boxMons[i]);
+
+    Free(boxMons);
+    return TRUE;
+}
@@ -385,6 +385,7 @@ static void PSS_CreatePCMenu(u8 whichMenu, s16 *windowIdPtr)
 void Cb2_ExitPSS(void)
 {
     sPreviousBoxOption = GetCurrentBoxOption();
+    DestroyBoxIndex();
     gFieldCallback = FieldCb_ReturnToPcMenu;
     SetMainCallback2(CB2_ReturnToField);
 }
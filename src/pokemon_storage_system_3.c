@@ -57,6 +57,8 @@ static void Cb_HandleBoxOptions(u8 taskId);
 static void Cb_HandleWallpapers(u8 taskId);
 static void Cb_JumpBox(u8 taskId);
 static void Cb_NameBox(u8 taskId);
+static void Cb_SortBox(u8 taskId);
+static void Cb_FindMon(u8 taskId);
 static void Cb_ShowMonSummary(u8 taskId);
 static void Cb_GiveItemFromBag(u8 taskId);
 static void Cb_OnCloseBoxPressed(u8 taskId);
@@ -97,6 +99,7 @@ static void PrintStorageActionText(u8 textId);
 static void ShowYesNoWindow(s8 species);
 static void ClearBottomWindow(void);
 static void AddWallpaperSetsMenu(void);
+static void AddSortBoxMenu(void);
 static void AddWallpapersMenu(u8 wallpaperSet);
 static void sub_808FDFC(void);
 static void sub_808FE54(u8 species);
@@ -257,6 +260,8 @@ static const struct StorageAction sPCStorageActionTexts[] = {
     [PC_TEXT_ITEM_IS_HELD] = {gText_ItemIsNowHeld, PC_TEXT_FMT_ITEM_NAME},
     [PC_TEXT_CHANGED_TO_ITEM] = {gText_ChangedToNewItem, PC_TEXT_FMT_ITEM_NAME},
     [PC_TEXT_CANT_STORE_MAIL] = {gText_MailCantBeStored, PC_TEXT_FMT_NORMAL},
+    [PC_TEXT_SORT_BY_WHAT] = {gText_SortBoxByWhat, PC_TEXT_FMT_NORMAL},
+    [PC_TEXT_NO_OTHERS_FOUND] = {gText_NoOtherPkmnFound, PC_TEXT_FMT_NORMAL},
 };
 
 // Yes/No menu
@@ -377,6 +382,7 @@ void Cb2_EnterPSS(u8 boxOption)
         gPSSData->state = 0;
         gPSSData->taskId = CreateTask(Cb_InitPSS, 3);
         sLastUsedBox = StorageGetCurrentBox();
+        CreateBoxIndex();
         SetMainCallback2(Cb2_PSS);
     }
 }
@@ -1025,6 +1031,10 @@ static void Cb_OnSelectedMon(u8 taskId)
         case 17:
             SetPSSCallback(Cb_ShowItemInfo);
             break;
+        case PC_TEXT_FIND:
+            PlaySE(SE_SELECT);
+            SetPSSCallback(Cb_FindMon);
+            break;
         }
         break;
     case 3:
@@ -1722,6 +1732,11 @@ static void Cb_HandleBoxOptions(u8 taskId)
             PlaySE(SE_SELECT);
             SetPSSCallback(Cb_NameBox);
             break;
+        case PC_TEXT_SORT:
+            PlaySE(SE_SELECT);
+            ClearBottomWindow();
+            SetPSSCallback(Cb_SortBox);
+            break;
         case 10:
             PlaySE(SE_SELECT);
             ClearBottomWindow();
@@ -1870,6 +1885,101 @@ static void Cb_NameBox(u8 taskId)
     }
 }
 
+static void Cb_SortBox(u8 taskId)
+{
+    s16 textId;
+
+    switch (gPSSData->state)
+    {
+    case 0:
+        AddSortBoxMenu();
+        PrintStorageActionText(PC_TEXT_SORT_BY_WHAT);
+        gPSSData->state++;
+        break;
+    case 1:
+        textId = sub_8094F94();
+        switch (textId)
+        {
+        case MENU_NOTHING_CHOSEN:
+            break;
+        case PC_TEXT_SORT_DEX:
+        case PC_TEXT_SORT_LEVEL:
+            PlaySE(SE_SELECT);
+            ClearBottomWindow();
+            if (SortBoxByIndex(StorageGetCurrentBox(), (textId == PC_TEXT_SORT_DEX) ? BOX_SORT_DEX : BOX_SORT_LEVEL))
+                RefreshBoxMonIcons();
+            sub_80920FC(TRUE);
+            SetPSSCallback(Cb_MainPSS);
+            break;
+        default:
+            sub_80920FC(TRUE);
+            ClearBottomWindow();
+            SetPSSCallback(Cb_MainPSS);
+            break;
+        }
+        break;
+    }
+}
+
+static void Cb_FindMon(u8 taskId)
+{
+    switch (gPSSData->state)
+    {
+    case 0:
+        gPSSData->findBoxId = StorageGetCurrentBox();
+        gPSSData->findBoxPosition = GetBoxCursorPosition();
+        if (gPSSData->cursorMonIsEgg
+         || !FindNextBoxMonWithSpecies(gPSSData->cursorMonSpecies, &gPSSData->findBoxId, &gPSSData->findBoxPosition)
+         || (gPSSData->findBoxId == StorageGetCurrentBox() && gPSSData->findBoxPosition == GetBoxCursorPosition()))
+        {
+            PlaySE(SE_FAILURE);
+            PrintStorageActionText(PC_TEXT_NO_OTHERS_FOUND);
+            gPSSData->state = 5;
+        }
+        else
+        {
+            ClearBottomWindow();
+            if (gPSSData->findBoxId != StorageGetCurrentBox())
+            {
+                SetUpScrollToBox(gPSSData->findBoxId);
+                gPSSData->state = 1;
+            }
+            else
+            {
+                gPSSData->state = 2;
+            }
+        }
+        break;
+    case 1:
+        if (!ScrollToBox())
+        {
+            SetCurrentBox(gPSSData->findBoxId);
+            gPSSData->state++;
+        }
+        break;
+    case 2:
+        sub_8092B3C(gPSSData->findBoxPosition);
+        gPSSData->state++;
+        break;
+    case 3:
+        if (!sub_80924A8())
+        {
+            sub_808F974();
+            if (gPSSData->setMosaic)
+                BoxSetMosaic();
+            SetPSSCallback(Cb_MainPSS);
+        }
+        break;
+    case 5:
+        if (JOY_NEW(A_BUTTON | B_BUTTON | DPAD_ANY))
+        {
+            ClearBottomWindow();
+            SetPSSCallback(Cb_MainPSS);
+        }
+        break;
+    }
+}
+
 static void Cb_ShowMonSummary(u8 taskId)
 {
     switch (gPSSData->state)
@@ -2617,6 +2727,14 @@ static void AddWallpaperSetsMenu(void)
     AddMenu();
 }
 
+static void AddSortBoxMenu(void)
+{
+    InitMenu();
+    SetMenuText(PC_TEXT_SORT_DEX);
+    SetMenuText(PC_TEXT_SORT_LEVEL);
+    AddMenu();
+}
+
 static void AddWallpapersMenu(u8 wallpaperSet)
 {
     InitMenu();
@@ -559,6 +559,17 @@ void SetBoxMonIconObjMode(u8 boxPosition, u8 objMode)
     }
 }
 
+void RefreshBoxMonIcons(void)
+{
+    u8 boxPosition;
+
+    for (boxPosition = 0; boxPosition < IN_BOX_COUNT; boxPosition++)
+    {
+        DestroyBoxMonIconAtPosition(boxPosition);
+        sub_80901EC(boxPosition);
+    }
+}
+
 void CreatePartyMonsSprites(bool8 arg0)
 {
     u16 i, count;
@@ -1748,6 +1748,8 @@ static void AddBoxMenu(void)
     SetMenuText(PC_TEXT_JUMP);
     SetMenuText(PC_TEXT_WALLPAPER);
     SetMenuText(PC_TEXT_NAME);
+    if (IsBoxIndexActive() && gPSSData->boxOption != BOX_OPTION_MOVE_ITEMS)
+        SetMenuText(PC_TEXT_SORT);
     SetMenuText(PC_TEXT_CANCEL);
 }
 
@@ -1810,6 +1812,9 @@ static bool8 sub_809494C(void)
 
     SetMenuText(PC_TEXT_MARK);
     SetMenuText(PC_TEXT_RELEASE);
+    if (IsBoxIndexActive() && gPSSData->boxOption == BOX_OPTION_MOVE_MONS
+     && !sIsMonBeingMoved && sBoxCursorArea == CURSOR_AREA_IN_BOX)
+        SetMenuText(PC_TEXT_FIND);
     SetMenuText(PC_TEXT_CANCEL);
     return TRUE;
 }
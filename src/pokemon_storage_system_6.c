@@ -54,6 +54,10 @@ static const u8 *const sMenuTexts[] = {
     [PC_TEXT_POKECENTER] = gPCText_Pokecenter,
     [PC_TEXT_MACHINE]    = gPCText_Machine,
     [PC_TEXT_SIMPLE]     = gPCText_Simple,
+    [PC_TEXT_SORT]       = gPCText_Sort,
+    [PC_TEXT_FIND]       = gPCText_Find,
+    [PC_TEXT_SORT_DEX]   = gPCText_DexNo,
+    [PC_TEXT_SORT_LEVEL] = gPCText_Level,
 };
 
 void SetMenuText(u8 textId)
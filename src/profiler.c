@@ -0,0 +1,230 @@
+#include "global.h"
+#include "main.h"
+#include "profiler.h"
+
+#if PROFILE
+
+// Timer 2 is taken over and left free-running. At 64 cycles per tick a
+// scope can run for ~15 frames before it wraps. The flash driver borrows it
+// while writing a save and stops it when done, so Profiler_FrameTick
+// restarts it, and a scope open across a flash write reports a bogus time.
+#define PROFILER_TIMER_CNT (TIMER_ENABLE | TIMER_64CLK)
+#define PROFILER_CYCLES_PER_TICK 64
+
+#define PROFILER_MAX_NODES 32
+#define PROFILER_MAX_DEPTH 8
+#define PROFILER_NO_PARENT 0xFF
+
+// One node per distinct call path, so a scope that runs both directly from
+// callback2 and from inside a task is reported under each parent.
+struct ProfilerNode
+{
+    u8 scope;
+    u8 parent;
+    u16 calls;
+    u32 frameTicks;
+    u32 minTicks;
+    u32 maxTicks;
+    u32 totalTicks;
+    u16 frames;
+};
+
+static EWRAM_DATA struct ProfilerNode sNodes[PROFILER_MAX_NODES] = {0};
+static EWRAM_DATA u8 sNodeCount = 0;
+static EWRAM_DATA u8 sNodeStack[PROFILER_MAX_DEPTH] = {0};
+static EWRAM_DATA u16 sStartTicks[PROFILER_MAX_DEPTH] = {0};
+static EWRAM_DATA vu8 sDepth = 0;
+static EWRAM_DATA u16 sFrameCount = 0;
+static EWRAM_DATA MainCallback sProfiledCallback2 = NULL;
+
+static const char *const sScopeNames[PROFILER_SCOPE_COUNT] = {
+    [PROFILER_SCOPE_CALLBACK2]           = "callback2",
+    [PROFILER_SCOPE_RUN_TASKS]           = "RunTasks",
+    [PROFILER_SCOPE_ANIMATE_SPRITES]     = "AnimateSprites",
+    [PROFILER_SCOPE_BUILD_OAM_BUFFER]    = "BuildOamBuffer",
+    [PROFILER_SCOPE_RUN_TEXT_PRINTERS]   = "RunTextPrinters",
+    [PROFILER_SCOPE_UPDATE_PALETTE_FADE] = "UpdatePaletteFade",
+    [PROFILER_SCOPE_VBLANK]              = "VBlankIntr",
+    [PROFILER_SCOPE_DMA3_REQUESTS]       = "ProcessDma3Requests",
+    [PROFILER_SCOPE_SOUND_MAIN]          = "m4aSoundMain",
+    [PROFILER_SCOPE_LOAD_MAP_STEPS]      = "LoadMapSteps",
+};
+
+static void StartProfilerTimer(void)
+{
+    REG_TM2CNT_H = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM2CNT_H = PROFILER_TIMER_CNT;
+}
+
+static void ResetProfilerStats(void)
+{
+    u8 i;
+
+    for (i = 0; i < sNodeCount; i++)
+    {
+        sNodes[i].calls = 0;
+        sNodes[i].frameTicks = 0;
+        sNodes[i].minTicks = 0xFFFFFFFF;
+        sNodes[i].maxTicks = 0;
+        sNodes[i].totalTicks = 0;
+        sNodes[i].frames = 0;
+    }
+    sFrameCount = 0;
+}
+
+void Profiler_Init(void)
+{
+    sNodeCount = 0;
+    sDepth = 0;
+    sProfiledCallback2 = NULL;
+    ResetProfilerStats();
+    StartProfilerTimer();
+}
+
+static u8 GetProfilerNode(u8 scope, u8 parent)
+{
+    u8 i;
+    u16 ime;
+
+    for (i = 0; i < sNodeCount; i++)
+    {
+        if (sNodes[i].scope == scope && sNodes[i].parent == parent)
+            return i;
+    }
+
+    // The VBlank scopes can interrupt a node being added from the main loop.
+    ime = REG_IME;
+    REG_IME = 0;
+    i = sNodeCount;
+    if (i < PROFILER_MAX_NODES)
+    {
+        sNodes[i].scope = scope;
+        sNodes[i].parent = parent;
+        sNodes[i].calls = 0;
+        sNodes[i].frameTicks = 0;
+        sNodes[i].minTicks = 0xFFFFFFFF;
+        sNodes[i].maxTicks = 0;
+        sNodes[i].totalTicks = 0;
+        sNodes[i].frames = 0;
+        sNodeCount++;
+    }
+    else
+    {
+        i = PROFILER_NO_PARENT;
+    }
+    REG_IME = ime;
+    return i;
+}
+
+// The depth is claimed before the slot is written and released after it is
+// read, so an interrupt that opens its own scopes in between only ever uses
+// the slots above ours.
+void Profiler_BeginScope(u8 scope)
+{
+    u8 depth = sDepth;
+    u8 parent = (depth != 0) ? sNodeStack[depth - 1] : PROFILER_NO_PARENT;
+
+    sDepth = depth + 1;
+    if (depth >= PROFILER_MAX_DEPTH)
+        return;
+
+    sNodeStack[depth] = GetProfilerNode(scope, parent);
+    sStartTicks[depth] = REG_TM2CNT_L;
+}
+
+void Profiler_EndScope(void)
+{
+    u8 depth = sDepth - 1;
+    u8 node;
+
+    if (depth < PROFILER_MAX_DEPTH)
+    {
+        node = sNodeStack[depth];
+        if (node != PROFILER_NO_PARENT)
+        {
+            sNodes[node].frameTicks += (u16)(REG_TM2CNT_L - sStartTicks[depth]);
+            sNodes[node].calls++;
+        }
+    }
+    sDepth = depth;
+}
+
+static char *AppendScopePath(char *dest, u8 node)
+{
+    const char *name;
+
+    if (sNodes[node].parent != PROFILER_NO_PARENT)
+    {
+        dest = AppendScopePath(dest, sNodes[node].parent);
+        *dest++ = ';';
+    }
+    for (name = sScopeNames[sNodes[node].scope]; *name != '\0'; name++)
+        *dest++ = *name;
+    *dest = '\0';
+    return dest;
+}
+
+// Log format, one line each:
+//   PROF_BEGIN <callback2 address> <frames>
+//   PROF <path;of;scopes> <min> <avg> <max> <calls>   (cycles per frame)
+//   PROF_END
+static void ReportProfilerStats(void)
+{
+    u8 i;
+    char path[PROFILER_MAX_DEPTH * 24];
+
+    if (sFrameCount == 0)
+        return;
+
+    mgba_printf(MGBA_LOG_INFO, "PROF_BEGIN %08x %u", (u32)sProfiledCallback2, sFrameCount);
+    for (i = 0; i < sNodeCount; i++)
+    {
+        if (sNodes[i].frames == 0)
+            continue;
+        AppendScopePath(path, i);
+        mgba_printf(MGBA_LOG_INFO, "PROF %s %u %u %u %u",
+                    path,
+                    sNodes[i].minTicks * PROFILER_CYCLES_PER_TICK,
+                    sNodes[i].totalTicks * PROFILER_CYCLES_PER_TICK / sFrameCount,
+                    sNodes[i].maxTicks * PROFILER_CYCLES_PER_TICK,
+                    sNodes[i].calls);
+    }
+    mgba_printf(MGBA_LOG_INFO, "PROF_END");
+}
+
+// Called once per iteration of the main loop, right after VBlank, when no
+// scope is open.
+void Profiler_FrameTick(void)
+{
+    u8 i;
+    struct ProfilerNode *node;
+
+    if (REG_TM2CNT_H != PROFILER_TIMER_CNT)
+        StartProfilerTimer();
+
+    for (i = 0; i < sNodeCount; i++)
+    {
+        node = &sNodes[i];
+        if (node->frameTicks != 0)
+        {
+            if (node->frameTicks < node->minTicks)
+                node->minTicks = node->frameTicks;
+            if (node->frameTicks > node->maxTicks)
+                node->maxTicks = node->frameTicks;
+            node->totalTicks += node->frameTicks;
+            node->frames++;
+            node->frameTicks = 0;
+        }
+    }
+    sFrameCount++;
+
+    if (gMain.callback2 != sProfiledCallback2 || sFrameCount >= PROFILER_REPORT_FRAMES)
+    {
+        ReportProfilerStats();
+        ResetProfilerStats();
+        sProfiledCallback2 = gMain.callback2;
+    }
+}
+
+#endif // PROFILE
@@ -1,5 +1,6 @@
 #include "global.h"
 #include "quest_log.h"
+#include "event_object_movement.h"
 #include "fieldmap.h"
 #include "field_player_avatar.h"
 #include "metatile_behavior.h"
@@ -126,6 +127,7 @@ void SetSav1ObjectEventsFromQuestLog(const struct QuestLog * questLog, const str
         }
     }
 
+    RebuildObjectEventOccupancy();
     CpuCopy16(gObjectEvents, gSaveBlock2Ptr->objectEvents, sizeof(gObjectEvents));
 }
 
@@ -34,6 +34,17 @@ static u8 sQuestLogInput;
 static u8 sQuestLogInputIsDpad;
 static u8 sMsgIsSignPost;
 
+// Map script pointers by tag, resolved once per map header rather than by
+// walking the header's list on every lookup.
+#define NUM_MAP_SCRIPT_TAGS 8
+static const u8 *sMapScriptsCachedFor;
+static u8 *sMapScriptsByTag[NUM_MAP_SCRIPT_TAGS];
+
+// The on-frame table found no match the last time it was checked, and
+// gVarWriteCount was this then; until it moves the result can't change.
+static bool8 sOnFrameNoMatchValid;
+static u16 sOnFrameNoMatchWriteCount;
+
 extern ScrCmdFunc gScriptCmdTable[];
 extern ScrCmdFunc gScriptCmdTableEnd[];
 extern void *gNullScriptPtr;
@@ -356,10 +367,8 @@ void ScriptContext2_RunNewScript(const u8 *ptr)
     while (RunScriptCommand(&sScriptContext2) == TRUE);
 }
 
-u8 *mapheader_get_tagged_pointer(u8 tag)
+static u8 *FindMapScriptByTag(const u8 *mapScripts, u8 tag)
 {
-    const u8 *mapScripts = gMapHeader.mapScripts;
-
     if (mapScripts == NULL)
         return NULL;
 
@@ -376,6 +385,25 @@ u8 *mapheader_get_tagged_pointer(u8 tag)
     }
 }
 
+static void CacheMapScriptsByTag(void)
+{
+    u8 tag;
+
+    sMapScriptsCachedFor = gMapHeader.mapScripts;
+    for (tag = 0; tag < NUM_MAP_SCRIPT_TAGS; tag++)
+        sMapScriptsByTag[tag] = tag != 0 ? FindMapScriptByTag(sMapScriptsCachedFor, tag) : NULL;
+    sOnFrameNoMatchValid = FALSE;
+}
+
+u8 *mapheader_get_tagged_pointer(u8 tag)
+{
+    if (tag >= NUM_MAP_SCRIPT_TAGS)
+        return FindMapScriptByTag(gMapHeader.mapScripts, tag);
+    if (gMapHeader.mapScripts != sMapScriptsCachedFor)
+        CacheMapScriptsByTag();
+    return sMapScriptsByTag[tag];
+}
+
 void mapheader_run_script_by_tag(u8 tag)
 {
     u8 *ptr = mapheader_get_tagged_pointer(tag);
@@ -383,6 +411,23 @@ void mapheader_run_script_by_tag(u8 tag)
         ScriptContext2_RunNewScript(ptr);
 }
 
+// Special vars are written directly rather than through VarSet, so a table
+// comparing any of them can't be skipped on gVarWriteCount alone.
+static bool8 TaggedPtrListReadsSpecialVars(const u8 *ptr)
+{
+    while (1)
+    {
+        u16 varIndex1 = ptr[0] | (ptr[1] << 8);
+        u16 varIndex2 = ptr[2] | (ptr[3] << 8);
+
+        if (!varIndex1)
+            return FALSE;
+        if (varIndex1 >= SPECIAL_VARS_START || varIndex2 >= SPECIAL_VARS_START)
+            return TRUE;
+        ptr += 8;
+    }
+}
+
 u8 *mapheader_get_first_match_from_tagged_ptr_list(u8 tag)
 {
     u8 *ptr = mapheader_get_tagged_pointer(tag);
@@ -408,6 +453,7 @@ u8 *mapheader_get_first_match_from_tagged_ptr_list(u8 tag)
 
 void RunOnLoadMapScript(void)
 {
+    CacheMapScriptsByTag();
     mapheader_run_script_by_tag(1);
 }
 
@@ -438,10 +484,25 @@ bool8 TryRunOnFrameMapScript(void)
     if(gQuestLogState == QL_STATE_PLAYBACK_LAST)
         return 0;
 
+    // Nothing the table compares has been written since it last failed to
+    // match. Quest log playback loads vars as they are read, so always look.
+    if (sOnFrameNoMatchValid
+     && sOnFrameNoMatchWriteCount == gVarWriteCount
+     && gMapHeader.mapScripts == sMapScriptsCachedFor
+     && gQuestLogPlaybackState == 0)
+        return 0;
+
     ptr = mapheader_get_first_match_from_tagged_ptr_list(2);
 
     if (!ptr)
+    {
+        sOnFrameNoMatchWriteCount = gVarWriteCount;
+        sOnFrameNoMatchValid = sMapScriptsByTag[2] == NULL
+                            || !TaggedPtrListReadsSpecialVars(sMapScriptsByTag[2]);
         return 0;
+    }
+
+    sOnFrameNoMatchValid = FALSE;
 
     ScriptContext1_SetupScript(ptr);
     return 1;
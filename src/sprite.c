@@ -1,6 +1,7 @@
 #include "global.h"
 #include "gflib.h"
 #include "day_night.h"
+#include "profiler.h"
 
 #define MAX_SPRITE_COPY_REQUESTS 64
 
@@ -47,6 +48,7 @@ static u8 CreateSpriteAt(u8 index, const struct SpriteTemplate *template, s16 x,
 static void ResetOamMatrices(void);
 static void ResetSprite(struct Sprite *sprite);
 s16 AllocSpriteTiles(u16 tileCount);
+static s16 TryAllocSpriteTiles(u16 tileCount);
 static void RequestSpriteFrameImageCopy(u16 index, u16 tileNum, const struct SpriteFrameImage *images);
 static void ResetAllSprites(void);
 static void BeginAnim(struct Sprite *sprite);
@@ -314,6 +316,7 @@ EWRAM_DATA s16 gSpriteCoordOffsetX = 0;
 EWRAM_DATA s16 gSpriteCoordOffsetY = 0;
 EWRAM_DATA struct OamMatrix gOamMatrices[OAM_MATRIX_COUNT] = {0};
 EWRAM_DATA bool8 gAffineAnimsDisabled = 0;
+EWRAM_DATA bool8 (*gSpriteTilesReclaimCallback)(void) = NULL;
 
 void ResetSpriteData(void)
 {
@@ -332,6 +335,8 @@ void ResetSpriteData(void)
 void AnimateSprites(void)
 {
     u8 i;
+
+    PROFILE_BEGIN(PROFILER_SCOPE_ANIMATE_SPRITES);
     for (i = 0; i < MAX_SPRITES; i++)
     {
         struct Sprite *sprite = &gSprites[i];
@@ -344,11 +349,14 @@ void AnimateSprites(void)
                 AnimateSprite(sprite);
         }
     }
+    PROFILE_END(PROFILER_SCOPE_ANIMATE_SPRITES);
 }
 
 void BuildOamBuffer(void)
 {
     u8 temp;
+
+    PROFILE_BEGIN(PROFILER_SCOPE_BUILD_OAM_BUFFER);
     UpdateOamCoords();
     BuildSpritePriorities();
     SortSprites();
@@ -358,6 +366,7 @@ void BuildOamBuffer(void)
     CopyMatricesToOamBuffer();
     gMain.oamLoadDisabled = temp;
     gShouldProcessSpriteCopyRequests = TRUE;
+    PROFILE_END(PROFILER_SCOPE_BUILD_OAM_BUFFER);
 }
 
 void UpdateOamCoords(void)
@@ -724,6 +733,17 @@ void CalcCenterToCornerVec(struct Sprite *sprite, u8 shape, u8 size, u8 affineMo
 }
 
 s16 AllocSpriteTiles(u16 tileCount)
+{
+    s16 start = TryAllocSpriteTiles(tileCount);
+
+    // Tiles only kept around as a cache are given back before giving up.
+    if (start == -1 && gSpriteTilesReclaimCallback != NULL && gSpriteTilesReclaimCallback())
+        start = TryAllocSpriteTiles(tileCount);
+
+    return start;
+}
+
+static s16 TryAllocSpriteTiles(u16 tileCount)
 {
     u16 i;
     s16 start;
@@ -649,6 +649,8 @@ const u8 gText_PutItemInBag[] = _("Put this item in the Bag?");
 const u8 gText_ItemIsNowHeld[] = _("{DYNAMIC 0x00} is now held.");
 const u8 gText_ChangedToNewItem[] = _("Changed to {DYNAMIC 0x00}.");
 const u8 gText_MailCantBeStored[] = _("Mail can't be stored!");
+const u8 gText_SortBoxByWhat[] = _("Sort the Box by what?");
+const u8 gText_NoOtherPkmnFound[] = _("No others of its kind found.");
 const u8 gPCText_Cancel[] = _("Cancel");
 const u8 gPCText_Store[] = _("Store");
 const u8 gPCText_Withdraw[] = _("Withdraw");
@@ -686,6 +688,10 @@ const u8 gPCText_PolkaDot[] = _("Stars");
 const u8 gPCText_Pokecenter[] = _("Pokécenter");
 const u8 gPCText_Machine[] = _("Tiles");
 const u8 gPCText_Simple[] = _("Simple");
+const u8 gPCText_Sort[] = _("Sort");
+const u8 gPCText_Find[] = _("Find");
+const u8 gPCText_DexNo[] = _("Dex No.");
+const u8 gPCText_Level[] = _("Level");
 const u8 gUnknown_8418562[] = _("なにを しますか?");
 const u8 gText_WithdrawPokemon[] = _("Withdraw Pokémon");
 const u8 gText_DepositPokemon[] = _("Deposit Pokémon");
@@ -1,11 +1,25 @@
 #include "global.h"
 #include "task.h"
+#include "profiler.h"
 
 #define HEAD_SENTINEL 0xFE
 #define TAIL_SENTINEL 0xFF
 
+#define NUM_TASK_PRIORITIES 256
+
 struct Task gTasks[NUM_TASKS];
 
+// The task list is kept sorted by priority as before, but each priority
+// value remembers the last task that has it and a bitmap says which values
+// are in use, so a new task is linked in after the right one without
+// walking the list. The list itself is what RunTasks follows.
+static EWRAM_DATA u8 sPriorityTails[NUM_TASK_PRIORITIES] = {0};
+static EWRAM_DATA u32 sUsedPriorities[NUM_TASK_PRIORITIES / 32] = {0};
+
+static EWRAM_DATA u8 sFirstTaskId = 0;
+static EWRAM_DATA u16 sActiveTaskMask = 0;
+static EWRAM_DATA u8 sActiveTaskCount = 0;
+
 static void InsertTask(u8 newTaskId);
 static u8 FindFirstActiveTask();
 
@@ -25,6 +39,12 @@ void ResetTasks(void)
 
     gTasks[0].prev = HEAD_SENTINEL;
     gTasks[NUM_TASKS - 1].next = TAIL_SENTINEL;
+
+    for (i = 0; i < NELEMS(sUsedPriorities); i++)
+        sUsedPriorities[i] = 0;
+    sFirstTaskId = TAIL_SENTINEL;
+    sActiveTaskMask = 0;
+    sActiveTaskCount = 0;
 }
 
 u8 CreateTask(TaskFunc func, u8 priority)
@@ -40,6 +60,8 @@ u8 CreateTask(TaskFunc func, u8 priority)
             InsertTask(i);
             memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
             gTasks[i].isActive = TRUE;
+            sActiveTaskMask |= 1 << i;
+            sActiveTaskCount++;
             return i;
         }
     }
@@ -47,51 +69,78 @@ u8 CreateTask(TaskFunc func, u8 priority)
     return 0;
 }
 
+// Returns the highest priority value in use that is no higher than
+// priority, or -1 if there is none.
+static s32 FindUsedPriorityAtOrBelow(u8 priority)
+{
+    s32 word = priority / 32;
+    s32 bit = priority % 32;
+    u32 bits = sUsedPriorities[word] & (0xFFFFFFFF >> (31 - bit));
+
+    while (bits == 0)
+    {
+        if (--word < 0)
+            return -1;
+        bits = sUsedPriorities[word];
+        bit = 31;
+    }
+    while (!(bits & (1u << bit)))
+        bit--;
+    return word * 32 + bit;
+}
+
 static void InsertTask(u8 newTaskId)
 {
-    u8 taskId = FindFirstActiveTask();
+    u8 priority = gTasks[newTaskId].priority;
+    s32 prevPriority = FindUsedPriorityAtOrBelow(priority);
 
-    if (taskId == NUM_TASKS)
+    if (prevPriority < 0)
     {
-        // The new task is the only task.
+        // Nothing runs before the new task, so it goes at the head.
         gTasks[newTaskId].prev = HEAD_SENTINEL;
-        gTasks[newTaskId].next = TAIL_SENTINEL;
-        return;
+        gTasks[newTaskId].next = sFirstTaskId;
+        if (sFirstTaskId != TAIL_SENTINEL)
+            gTasks[sFirstTaskId].prev = newTaskId;
+        sFirstTaskId = newTaskId;
     }
-
-    while (1)
+    else
     {
-        if (gTasks[newTaskId].priority < gTasks[taskId].priority)
-        {
-            // We've found a task with a higher priority value,
-            // so we insert the new task before it.
-            gTasks[newTaskId].prev = gTasks[taskId].prev;
-            gTasks[newTaskId].next = taskId;
-            if (gTasks[taskId].prev != HEAD_SENTINEL)
-                gTasks[gTasks[taskId].prev].next = newTaskId;
-            gTasks[taskId].prev = newTaskId;
-            return;
-        }
-        if (gTasks[taskId].next == TAIL_SENTINEL)
-        {
-            // We've reached the end.
-            gTasks[newTaskId].prev = taskId;
-            gTasks[newTaskId].next = gTasks[taskId].next;
-            gTasks[taskId].next = newTaskId;
-            return;
-        }
-        taskId = gTasks[taskId].next;
+        // After the last task with the same or a lower priority value, which
+        // is where walking the list for the first higher value would stop.
+        u8 taskId = sPriorityTails[prevPriority];
+
+        gTasks[newTaskId].prev = taskId;
+        gTasks[newTaskId].next = gTasks[taskId].next;
+        if (gTasks[taskId].next != TAIL_SENTINEL)
+            gTasks[gTasks[taskId].next].prev = newTaskId;
+        gTasks[taskId].next = newTaskId;
     }
+
+    sPriorityTails[priority] = newTaskId;
+    sUsedPriorities[priority / 32] |= 1u << (priority % 32);
 }
 
 void DestroyTask(u8 taskId)
 {
     if (gTasks[taskId].isActive)
     {
+        u8 priority = gTasks[taskId].priority;
+
         gTasks[taskId].isActive = FALSE;
+        sActiveTaskMask &= ~(1 << taskId);
+        sActiveTaskCount--;
+
+        if (sPriorityTails[priority] == taskId)
+        {
+            if (gTasks[taskId].prev != HEAD_SENTINEL && gTasks[gTasks[taskId].prev].priority == priority)
+                sPriorityTails[priority] = gTasks[taskId].prev;
+            else
+                sUsedPriorities[priority / 32] &= ~(1u << (priority % 32));
+        }
 
         if (gTasks[taskId].prev == HEAD_SENTINEL)
         {
+            sFirstTaskId = gTasks[taskId].next;
             if (gTasks[taskId].next != TAIL_SENTINEL)
                 gTasks[gTasks[taskId].next].prev = HEAD_SENTINEL;
         }
@@ -112,8 +161,10 @@ void DestroyTask(u8 taskId)
 
 void RunTasks(void)
 {
-    u8 taskId = FindFirstActiveTask();
+    u8 taskId;
 
+    PROFILE_BEGIN(PROFILER_SCOPE_RUN_TASKS);
+    taskId = FindFirstActiveTask();
     if (taskId != NUM_TASKS)
     {
         do
@@ -122,23 +173,37 @@ void RunTasks(void)
             taskId = gTasks[taskId].next;
         } while (taskId != TAIL_SENTINEL);
     }
+    PROFILE_END(PROFILER_SCOPE_RUN_TASKS);
 }
 
 static u8 FindFirstActiveTask()
 {
-    u8 taskId;
-
-    for (taskId = 0; taskId < NUM_TASKS; taskId++)
-        if (gTasks[taskId].isActive == TRUE && gTasks[taskId].prev == HEAD_SENTINEL)
-            break;
+    if (sFirstTaskId == TAIL_SENTINEL)
+        return NUM_TASKS;
 
-    return taskId;
+    return sFirstTaskId;
 }
 
 void TaskDummy(u8 taskId)
 {
 }
 
+#ifdef HOST_BUILD
+// A host func pointer doesn't fit in data[14] and data[15], so the followup
+// is kept here instead.
+static TaskFunc sFollowupFuncs[NUM_TASKS];
+
+void SetTaskFuncWithFollowupFunc(u8 taskId, TaskFunc func, TaskFunc followupFunc)
+{
+    sFollowupFuncs[taskId] = followupFunc;
+    gTasks[taskId].func = func;
+}
+
+void SwitchTaskToFollowupFunc(u8 taskId)
+{
+    gTasks[taskId].func = sFollowupFuncs[taskId];
+}
+#else
 #define TASK_DATA_OP(taskId, offset, op)                    \
 {                                                           \
     u32 tasksAddr = (u32)gTasks;                            \
@@ -166,24 +231,22 @@ void SwitchTaskToFollowupFunc(u8 taskId)
 
     gTasks[taskId].func = (TaskFunc)func;
 }
+#endif // HOST_BUILD
 
+// Task funcs are reassigned directly all over the game, so there is no
+// index by func to keep current; these only visit the active slots.
 bool8 FuncIsActiveTask(TaskFunc func)
 {
-    u8 i;
-
-    for (i = 0; i < NUM_TASKS; i++)
-        if (gTasks[i].isActive == TRUE && gTasks[i].func == func)
-            return TRUE;
-
-    return FALSE;
+    return FindTaskIdByFunc(func) != 0xFF;
 }
 
 u8 FindTaskIdByFunc(TaskFunc func)
 {
     s32 i;
+    u16 active = sActiveTaskMask;
 
-    for (i = 0; i < NUM_TASKS; i++)
-        if (gTasks[i].isActive == TRUE && gTasks[i].func == func)
+    for (i = 0; active != 0; i++, active >>= 1)
+        if ((active & 1) && gTasks[i].func == func)
             return (u8)i;
 
     return -1;
@@ -191,14 +254,7 @@ u8 FindTaskIdByFunc(TaskFunc func)
 
 u8 GetTaskCount(void)
 {
-    u8 i;
-    u8 count = 0;
-
-    for (i = 0; i < NUM_TASKS; i++)
-        if (gTasks[i].isActive == TRUE)
-            count++;
-
-    return count;
+    return sActiveTaskCount;
 }
 
 void SetWordTaskArg(u8 taskId, u8 dataElem, unsigned long value)
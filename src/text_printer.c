@@ -1,6 +1,7 @@
 #include "global.h"
 #include "window.h"
 #include "text.h"
+#include "profiler.h"
 
 static EWRAM_DATA struct TextPrinter sTempTextPrinter = {0};
 static EWRAM_DATA struct TextPrinter sTextPrinters[NUM_TEXT_PRINTERS] = {0};
@@ -116,6 +117,7 @@ void RunTextPrinters(void)
     int i;
     u16 temp;
 
+    PROFILE_BEGIN(PROFILER_SCOPE_RUN_TEXT_PRINTERS);
     for (i = 0; i < 0x20; ++i)
     {
         if (sTextPrinters[i].active != 0)
@@ -134,6 +136,7 @@ void RunTextPrinters(void)
             }
         }
     }
+    PROFILE_END(PROFILER_SCOPE_RUN_TEXT_PRINTERS);
 }
 
 bool16 IsTextPrinterActive(u8 id)
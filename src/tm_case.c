@@ -399,6 +399,7 @@ static bool8 DoSetUpTMCaseUI(void)
         gMain.state++;
         break;
     default:
+        ListMenuAllocRowCache(sListMenuItemsBuffer);
         SetVBlankCallback(VBlankCB_Idle);
         SetMainCallback2(CB2_Idle);
         return TRUE;
@@ -720,6 +721,7 @@ static void DestroyTMCaseBuffers(void)
         Free(sListMenuStringsBuffer);
     if (sTMSpritePaletteBuffer != NULL)
         Free(sTMSpritePaletteBuffer);
+    ListMenuFreeRowCache();
     FreeAllWindowBuffers();
 }
 
@@ -18,7 +18,22 @@ extern const struct SpritePalette gObjectEventPalette0;
 typedef u8 (*TrainerApproachFunc)(struct ObjectEvent *, s16, s16, s16);
 typedef bool8 (*TrainerSeeFunc)(u8, struct Task *, struct ObjectEvent *);
 
-static bool8 CheckTrainer(u8 trainerObjId);
+// The script of the trainer occupying each object event slot, looked up the
+// first time the slot is checked. Keyed by the object's local id and map so a
+// slot reused for a different object looks its script up again.
+struct TrainerSightLine
+{
+    const u8 *script;
+    u8 localId;
+    u8 mapNum;
+    u8 mapGroup;
+};
+
+static EWRAM_DATA struct TrainerSightLine sTrainerSightLines[OBJECT_EVENTS_COUNT] = {0};
+
+static const u8 *GetTrainerSightLineScript(u8 trainerObjId);
+static bool8 IsTileInTrainerSightLine(struct ObjectEvent * trainerObj, s16 x, s16 y);
+static bool8 CheckTrainer(u8 trainerObjId, const u8 *script);
 static u8 GetTrainerApproachDistance(struct ObjectEvent * trainerObj);
 static u8 GetTrainerApproachDistanceSouth(struct ObjectEvent * trainerObj, s16 range, s16 x, s16 y);
 static u8 GetTrainerApproachDistanceNorth(struct ObjectEvent * trainerObj, s16 range, s16 x, s16 y);
@@ -88,33 +103,85 @@ static const TrainerSeeFunc sTrainerSeeFuncList2[] = {
     TrainerSeeFunc_EndJumpOutOfAsh
 };
 
+void ResetTrainerSightLines(void)
+{
+    CpuFill32(0, sTrainerSightLines, sizeof(sTrainerSightLines));
+}
+
+// Runs on every step, so the cheap tests go first: trainers that are already
+// beaten or whose sight lines don't reach the player's tile are skipped before
+// any of the collision checks along the line are done.
 bool8 CheckForTrainersWantingBattle(void)
 {
     u8 i;
+    s16 x, y;
+    const u8 *script;
+
     if (sub_8111C2C() == TRUE)
         return FALSE;
 
+    PlayerGetDestCoords(&x, &y);
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
     {
-        if (gObjectEvents[i].active
-         && (
-             gObjectEvents[i].trainerType == 1
-          || gObjectEvents[i].trainerType == 3
-         )
-         && CheckTrainer(i)
-      )
+        if (!gObjectEvents[i].active
+         || (gObjectEvents[i].trainerType != 1 && gObjectEvents[i].trainerType != 3))
+            continue;
+        if (!IsTileInTrainerSightLine(&gObjectEvents[i], x, y))
+            continue;
+        script = GetTrainerSightLineScript(i);
+        if (GetTrainerFlagFromScriptPointer(script))
+            continue;
+        if (CheckTrainer(i, script))
             return TRUE;
     }
     return FALSE;
 }
 
-static bool8 CheckTrainer(u8 trainerObjId)
+static const u8 *GetTrainerSightLineScript(u8 trainerObjId)
 {
-    const u8 *script = GetObjectEventScriptPointerByObjectEventId(trainerObjId);
-    u8 approachDistance;
-    if (GetTrainerFlagFromScriptPointer(script))
-        return FALSE;
-    approachDistance = GetTrainerApproachDistance(&gObjectEvents[trainerObjId]);
+    struct ObjectEvent *trainerObj = &gObjectEvents[trainerObjId];
+    struct TrainerSightLine *sightLine = &sTrainerSightLines[trainerObjId];
+
+    if (sightLine->script == NULL
+     || sightLine->localId != trainerObj->localId
+     || sightLine->mapNum != trainerObj->mapNum
+     || sightLine->mapGroup != trainerObj->mapGroup)
+    {
+        sightLine->script = GetObjectEventScriptPointerByObjectEventId(trainerObjId);
+        sightLine->localId = trainerObj->localId;
+        sightLine->mapNum = trainerObj->mapNum;
+        sightLine->mapGroup = trainerObj->mapGroup;
+    }
+    return sightLine->script;
+}
+
+// Whether (x, y) lies on one of the straight lines the trainer can see along,
+// ignoring anything in the way. GetTrainerApproachDistance only ever finds the
+// player on one of these tiles.
+static bool8 IsTileInTrainerSightLine(struct ObjectEvent *trainerObj, s16 x, s16 y)
+{
+    s16 range = trainerObj->trainerRange_berryTreeId;
+    s16 dx = x - trainerObj->currentCoords.x;
+    s16 dy = y - trainerObj->currentCoords.y;
+
+    if (dx == 0 && dy != 0 && dy >= -range && dy <= range)
+    {
+        if (trainerObj->trainerType != 1)
+            return TRUE;
+        return (dy > 0) ? trainerObj->facingDirection == DIR_SOUTH : trainerObj->facingDirection == DIR_NORTH;
+    }
+    if (dy == 0 && dx != 0 && dx >= -range && dx <= range)
+    {
+        if (trainerObj->trainerType != 1)
+            return TRUE;
+        return (dx > 0) ? trainerObj->facingDirection == DIR_EAST : trainerObj->facingDirection == DIR_WEST;
+    }
+    return FALSE;
+}
+
+static bool8 CheckTrainer(u8 trainerObjId, const u8 *script)
+{
+    u8 approachDistance = GetTrainerApproachDistance(&gObjectEvents[trainerObjId]);
     if (approachDistance != 0)
     {
         if (script[1] == TRAINER_BATTLE_DOUBLE && GetMonsStateToDoubles())
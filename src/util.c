@@ -228,49 +228,94 @@ int CountTrailingZeroBits(u32 value)
     return 0;
 }
 
-u16 CalcCRC16(const u8 *data, u32 length)
+// gCrc16Table extended for slice-by-4: sCrc16Slices[k][b] is the CRC step
+// for byte b followed by k zero bytes, so a word of input takes four lookups
+// instead of four dependent table steps. Built on first use; at 2 KB it
+// lives in EWRAM rather than IWRAM, which is still quicker to read than the
+// cartridge.
+static EWRAM_DATA u16 sCrc16Slices[4][256] = {0};
+static EWRAM_DATA bool8 sCrc16SlicesReady = FALSE;
+
+static void InitCrc16Slices(void)
 {
-    u16 i, j;
-    u16 crc = 0x1121;
+    u32 i, k;
 
-    for (i = 0; i < length; i++)
+    for (i = 0; i < 256; i++)
+        sCrc16Slices[0][i] = gCrc16Table[i];
+    for (k = 1; k < 4; k++)
     {
-        crc ^= data[i];
-        for (j = 0; j < 8; j++)
+        for (i = 0; i < 256; i++)
         {
-            if (crc & 1)
-                crc = (crc >> 1) ^ 0x8408;
-            else
-                crc >>= 1;
+            u16 prev = sCrc16Slices[k - 1][i];
+            sCrc16Slices[k][i] = (prev >> 8) ^ sCrc16Slices[0][prev & 0xFF];
         }
     }
-    return ~crc;
+    sCrc16SlicesReady = TRUE;
 }
 
-u16 CalcCRC16WithTable(const u8 *data, u32 length)
+static u16 UpdateCrc16(u16 crc, const u8 *data, u32 length)
 {
-    u16 i;
-    u16 crc = 0x1121;
-    u8 byte;
+    if (!sCrc16SlicesReady)
+        InitCrc16Slices();
 
-    for (i = 0; i < length; i++)
+    for (; length != 0 && ((uintptr_t)data & 3); length--)
+        crc = (crc >> 8) ^ sCrc16Slices[0][(u8)(crc ^ *data++)];
+    for (; length >= 4; length -= 4)
     {
-        byte = crc >> 8;
-        crc ^= data[i];
-        crc = byte ^ gCrc16Table[(u8)crc];
+        u32 word = *(const u32 *)data ^ crc;
+
+        crc = sCrc16Slices[3][word & 0xFF]
+            ^ sCrc16Slices[2][(word >> 8) & 0xFF]
+            ^ sCrc16Slices[1][(word >> 16) & 0xFF]
+            ^ sCrc16Slices[0][word >> 24];
+        data += 4;
     }
-    return ~crc;
+    for (; length != 0; length--)
+        crc = (crc >> 8) ^ sCrc16Slices[0][(u8)(crc ^ *data++)];
+    return crc;
+}
+
+// Both of these compute the same CRC-16 (reflected 0x8408, initial value
+// 0x1121, inverted result); they used to do it bit by bit and byte by byte.
+u16 CalcCRC16(const u8 *data, u32 length)
+{
+    return ~UpdateCrc16(0x1121, data, length);
+}
+
+u16 CalcCRC16WithTable(const u8 *data, u32 length)
+{
+    return ~UpdateCrc16(0x1121, data, length);
 }
 
 u32 CalcByteArraySum(const u8 * array, u32 size)
 {
-    s32 i;
     u32 result = 0;
 
-    for (i = 0; i < size; i++)
+    for (; size != 0 && ((uintptr_t)array & 3); size--)
+        result += *array++;
+
+    // A word at a time, with the even and odd bytes summed in two 16-bit
+    // lanes. Each word adds at most 510 to a lane, so they're folded into
+    // the result every 128 words, before a lane can carry into the next.
+    while (size >= 4)
     {
-        result += array[i];
+        u32 lanes = 0;
+        u32 words = size / 4;
+
+        if (words > 128)
+            words = 128;
+        size -= words * 4;
+        do
+        {
+            u32 word = *(const u32 *)array;
+
+            lanes += (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+            array += 4;
+        } while (--words != 0);
+        result += (lanes & 0xFFFF) + (lanes >> 16);
     }
 
+    for (; size != 0; size--)
+        result += *array++;
     return result;
 }
@@ -24,6 +24,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <limits.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* extended.c */
 void ieee754_write_extended (double, uint8_t*);
@@ -438,7 +441,93 @@ int get_delta_index(uint8_t sample, uint8_t prev_sample)
 	return best_index;
 }
 
-struct Bytes *delta_compress(struct Bytes *pcm)
+// get_delta_index for every (prev_sample, sample) pair, filled in once.
+static uint8_t sDeltaIndexTable[256][256];
+static pthread_once_t sDeltaIndexTableOnce = PTHREAD_ONCE_INIT;
+
+static void init_delta_index_table(void)
+{
+	for (int prev = 0; prev < 256; prev++)
+	{
+		for (int sample = 0; sample < 256; sample++)
+		{
+			sDeltaIndexTable[prev][sample] = get_delta_index(sample, prev);
+		}
+	}
+}
+
+static inline int lookup_delta_index(uint8_t sample, uint8_t prev_sample)
+{
+	return sDeltaIndexTable[prev_sample][sample];
+}
+
+// Chooses the deltas for one block (the raw base sample followed by up to 63
+// deltas) that minimise the total squared error of the decoded samples, rather
+// than the error of each sample on its own. Each step only depends on the
+// previous decoded value, so a Viterbi search over all 256 of them is exact.
+static void trellis_block(const uint8_t *samples, int count, uint8_t *indices)
+{
+	static _Thread_local uint32_t cost[2][256];
+	static _Thread_local uint8_t from[63][256];
+	static _Thread_local uint8_t choice[63][256];
+	uint32_t *prev_cost = cost[0];
+	uint32_t *next_cost = cost[1];
+
+	for (int v = 0; v < 256; v++)
+	{
+		prev_cost[v] = UINT32_MAX;
+	}
+	prev_cost[samples[0]] = 0;
+
+	for (int step = 1; step < count; step++)
+	{
+		int8_t target = (int8_t)samples[step];
+
+		for (int v = 0; v < 256; v++)
+		{
+			next_cost[v] = UINT32_MAX;
+		}
+		for (int v = 0; v < 256; v++)
+		{
+			if (prev_cost[v] == UINT32_MAX)
+			{
+				continue;
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				uint8_t next = v + gDeltaEncodingTable[i];
+				int error = (int8_t)next - target;
+				uint32_t total = prev_cost[v] + error * error;
+
+				if (total < next_cost[next])
+				{
+					next_cost[next] = total;
+					from[step - 1][next] = v;
+					choice[step - 1][next] = i;
+				}
+			}
+		}
+		uint32_t *swap = prev_cost;
+		prev_cost = next_cost;
+		next_cost = swap;
+	}
+
+	int best = 0;
+	for (int v = 1; v < 256; v++)
+	{
+		if (prev_cost[v] < prev_cost[best])
+		{
+			best = v;
+		}
+	}
+	for (int step = count - 1; step >= 1; step--)
+	{
+		indices[step - 1] = choice[step - 1][best];
+		best = from[step - 1][best];
+	}
+}
+
+struct Bytes *delta_compress(struct Bytes *pcm, bool trellis)
 {
 	struct Bytes *delta = malloc(sizeof(struct Bytes));
 	// estimate the length so we can malloc
@@ -468,9 +557,23 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 	int k;
 	uint8_t base;
 	int delta_index;
+	uint8_t trellis_indices[63];
+	int n = 0;
+
+	pthread_once(&sDeltaIndexTableOnce, init_delta_index_table);
 
 	while (i < pcm->length)
 	{
+		if (trellis)
+		{
+			unsigned long count = pcm->length - i;
+			if (count > 64)
+			{
+				count = 64;
+			}
+			trellis_block(&pcm->data[i], count, trellis_indices);
+			n = 0;
+		}
 		base = pcm->data[i++];
 		delta->data[j++] = base;
 
@@ -478,7 +581,8 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 		{
 			break;
 		}
-		delta_index = get_delta_index(pcm->data[i++], base);
+		delta_index = trellis ? trellis_indices[n++] : lookup_delta_index(pcm->data[i], base);
+		i++;
 		base += gDeltaEncodingTable[delta_index];
 		delta->data[j++] = delta_index;
 
@@ -488,7 +592,8 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 			{
 				break;
 			}
-			delta_index = get_delta_index(pcm->data[i++], base);
+			delta_index = trellis ? trellis_indices[n++] : lookup_delta_index(pcm->data[i], base);
+			i++;
 			base += gDeltaEncodingTable[delta_index];
 			delta->data[j] = (delta_index << 4);
 
@@ -496,7 +601,8 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 			{
 				break;
 			}
-			delta_index = get_delta_index(pcm->data[i++], base);
+			delta_index = trellis ? trellis_indices[n++] : lookup_delta_index(pcm->data[i], base);
+			i++;
 			base += gDeltaEncodingTable[delta_index];
 			delta->data[j++] |= delta_index;
 		}
@@ -524,7 +630,7 @@ do { \
 } while (0)
 
 // Reads an .aif file and produces a .pcm file containing an array of 8-bit samples.
-void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress)
+void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress, bool trellis)
 {
 	struct Bytes *aif = read_bytearray(aif_filename);
 	AifData aif_data = {0,0,0,0,0,0,0};
@@ -539,7 +645,7 @@ void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress)
 		struct Bytes *input = malloc(sizeof(struct Bytes));
 		input->data = aif_data.samples;
 		input->length = aif_data.real_num_samples;
-		pcm = delta_compress(input);
+		pcm = delta_compress(input, trellis);
 		free(input);
 	}
 	else
@@ -821,10 +927,169 @@ void pcm2aif(const char *pcm_filename, const char *aif_filename, uint32_t base_n
 	free(aif);
 }
 
+struct Job {
+	char *input_file;
+	char *output_file;
+	bool compress;
+};
+
+struct Batch {
+	struct Job *jobs;
+	int num_jobs;
+	int next_job;
+	bool trellis;
+	bool force;
+	int num_converted;
+	pthread_mutex_t lock;
+};
+
+// An output that is at least as new as its input was made by a previous run.
+bool is_up_to_date(const char *input_file, const char *output_file)
+{
+	struct stat input_stat, output_stat;
+
+	if (stat(input_file, &input_stat) != 0 || stat(output_file, &output_stat) != 0)
+	{
+		return false;
+	}
+	return output_stat.st_mtime >= input_stat.st_mtime;
+}
+
+void *batch_worker(void *arg)
+{
+	struct Batch *batch = arg;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&batch->lock);
+		int index = batch->next_job++;
+		pthread_mutex_unlock(&batch->lock);
+
+		if (index >= batch->num_jobs)
+		{
+			break;
+		}
+
+		struct Job *job = &batch->jobs[index];
+		if (!batch->force && is_up_to_date(job->input_file, job->output_file))
+		{
+			continue;
+		}
+		aif2pcm(job->input_file, job->output_file, job->compress, batch->trellis);
+
+		pthread_mutex_lock(&batch->lock);
+		batch->num_converted++;
+		pthread_mutex_unlock(&batch->lock);
+	}
+
+	return NULL;
+}
+
+// Each line of the list is "aif_file bin_file [--compress]".
+void read_job_list(const char *list_filename, struct Batch *batch)
+{
+	FILE *f = strcmp(list_filename, "-") == 0 ? stdin : fopen(list_filename, "r");
+	if (!f)
+	{
+		FATAL_ERROR("Failed to open '%s' for reading!\n", list_filename);
+	}
+
+	int capacity = 256;
+	char line[4096];
+	int line_number = 0;
+
+	batch->jobs = malloc(capacity * sizeof(struct Job));
+	batch->num_jobs = 0;
+
+	while (fgets(line, sizeof(line), f))
+	{
+		char *input_file = strtok(line, " \t\r\n");
+		char *output_file = strtok(NULL, " \t\r\n");
+		char *option = strtok(NULL, " \t\r\n");
+
+		line_number++;
+		if (!input_file || input_file[0] == '#')
+		{
+			continue;
+		}
+		if (!output_file)
+		{
+			FATAL_ERROR("%s:%d: missing output file\n", list_filename, line_number);
+		}
+		if (option && strcmp(option, "--compress") != 0)
+		{
+			FATAL_ERROR("%s:%d: unknown option '%s'\n", list_filename, line_number, option);
+		}
+		if (batch->num_jobs == capacity)
+		{
+			capacity *= 2;
+			batch->jobs = realloc(batch->jobs, capacity * sizeof(struct Job));
+		}
+		batch->jobs[batch->num_jobs].input_file = strdup(input_file);
+		batch->jobs[batch->num_jobs].output_file = strdup(output_file);
+		batch->jobs[batch->num_jobs].compress = option != NULL;
+		batch->num_jobs++;
+	}
+
+	if (f != stdin)
+	{
+		fclose(f);
+	}
+}
+
+void run_batch(const char *list_filename, int num_threads, bool trellis, bool force)
+{
+	struct Batch batch = {0};
+
+	read_job_list(list_filename, &batch);
+	batch.trellis = trellis;
+	batch.force = force;
+	pthread_mutex_init(&batch.lock, NULL);
+
+	if (num_threads <= 0)
+	{
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		num_threads = cpus > 0 ? cpus : 1;
+	}
+	if (num_threads > batch.num_jobs)
+	{
+		num_threads = batch.num_jobs > 0 ? batch.num_jobs : 1;
+	}
+
+	pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+	for (int i = 0; i < num_threads; i++)
+	{
+		if (pthread_create(&threads[i], NULL, batch_worker, &batch) != 0)
+		{
+			FATAL_ERROR("Failed to start worker thread\n");
+		}
+	}
+	for (int i = 0; i < num_threads; i++)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	fprintf(stderr, "aif2pcm: converted %d of %d files\n", batch.num_converted, batch.num_jobs);
+
+	for (int i = 0; i < batch.num_jobs; i++)
+	{
+		free(batch.jobs[i].input_file);
+		free(batch.jobs[i].output_file);
+	}
+	free(batch.jobs);
+	free(threads);
+	pthread_mutex_destroy(&batch.lock);
+}
+
 void usage(void)
 {
 	fprintf(stderr, "Usage: aif2pcm bin_file [aif_file]\n");
-	fprintf(stderr, "       aif2pcm aif_file [bin_file] [--compress]\n");
+	fprintf(stderr, "       aif2pcm aif_file [bin_file] [--compress] [--trellis]\n");
+	fprintf(stderr, "       aif2pcm --batch list_file [-j threads] [--trellis] [--force]\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "In batch mode each line of list_file (or stdin, for \"-\") is\n");
+	fprintf(stderr, "\"aif_file bin_file [--compress]\". Outputs newer than their input are skipped\n");
+	fprintf(stderr, "unless --force is given.\n");
 }
 
 int main(int argc, char **argv)
@@ -835,10 +1100,46 @@ int main(int argc, char **argv)
 		exit(1);
 	}
 
+	if (strcmp(argv[1], "--batch") == 0)
+	{
+		int num_threads = 0;
+		bool trellis = false;
+		bool force = false;
+
+		if (argc < 3)
+		{
+			usage();
+			exit(1);
+		}
+		for (int i = 3; i < argc; i++)
+		{
+			if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			{
+				num_threads = atoi(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--trellis") == 0)
+			{
+				trellis = true;
+			}
+			else if (strcmp(argv[i], "--force") == 0)
+			{
+				force = true;
+			}
+			else
+			{
+				usage();
+				exit(1);
+			}
+		}
+		run_batch(argv[2], num_threads, trellis, force);
+		return 0;
+	}
+
 	char *input_file = argv[1];
 	char *extension = get_file_extension(input_file);
 	char *output_file;
 	bool compressed = false;
+	bool trellis = false;
 
 	if (argc > 3)
 	{
@@ -848,20 +1149,23 @@ int main(int argc, char **argv)
 			{
 				compressed = true;
 			}
+			else if (strcmp(argv[i], "--trellis") == 0)
+			{
+				trellis = true;
+			}
 		}
 	}
-
 	if (strcmp(extension, "aif") == 0 || strcmp(extension, "aiff") == 0)
 	{
 		if (argc >= 3)
 		{
 			output_file = argv[2];
-			aif2pcm(input_file, output_file, compressed);
+			aif2pcm(input_file, output_file, compressed, trellis);
 		}
 		else
 		{
 			output_file = new_file_extension(input_file, "bin");
-			aif2pcm(input_file, output_file, compressed);
+			aif2pcm(input_file, output_file, compressed, trellis);
 			free(output_file);
 		}
 	}
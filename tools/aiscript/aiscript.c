@@ -0,0 +1,204 @@
+// Turns the preprocessed source of data/battle_ai_scripts.s into the source of
+// its compiled copy, in which every command is assembled in the fixed-width
+// form chosen by the ai_cmd macro in asm/macros/battle_ai_script.inc.
+//
+// Usage: aiscript TABLE COMPILED_TABLE < battle_ai_scripts.s > compiled.s
+//
+// The compiled copy is linked next to the original, so apart from defining
+// AI_SCRIPT_COMPILED for the macros this:
+//  - makes every label local, except TABLE, which is renamed COMPILED_TABLE
+//    and stays global;
+//  - realigns the command stream to 4 bytes wherever a byte or halfword list
+//    in the middle of a script has left it unaligned.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+
+#define FATAL_ERROR(format, ...)            \
+do                                          \
+{                                           \
+    fprintf(stderr, format, ##__VA_ARGS__); \
+    exit(1);                                \
+} while (0)
+
+#define MAX_LINE_LENGTH 1024
+
+static const char *const sDataDirectives[] =
+{
+    ".byte",
+    ".2byte",
+    ".4byte",
+    ".hword",
+    ".word",
+    ".space",
+    ".string",
+    ".ascii",
+    NULL,
+};
+
+static bool IsLabelStart(char c)
+{
+    return isalpha((unsigned char)c) || c == '_' || c == '.' || c == '$';
+}
+
+static bool IsLabelChar(char c)
+{
+    return isalnum((unsigned char)c) || c == '_' || c == '.' || c == '$';
+}
+
+static bool IsToken(const char *token, size_t length, const char *name)
+{
+    return strlen(name) == length && strncmp(name, token, length) == 0;
+}
+
+static bool IsDataDirective(const char *token, size_t length)
+{
+    int i;
+
+    for (i = 0; sDataDirectives[i] != NULL; i++)
+    {
+        if (IsToken(token, length, sDataDirectives[i]))
+            return true;
+    }
+    return false;
+}
+
+// Returns the length of the label defined at the start of line, or 0 if the
+// line doesn't start with one.
+static size_t GetLabelLength(const char *line)
+{
+    size_t length = 0;
+
+    if (!IsLabelStart(line[0]))
+        return 0;
+    while (IsLabelChar(line[length]))
+        length++;
+    if (line[length] != ':')
+        return 0;
+    return length;
+}
+
+// Returns whether rest, the text after the colon of the label at the start of
+// line, is only whitespace or the "; .global LABEL" that preproc turns a
+// LABEL:: into. Either way it is dropped.
+static bool IsLabelSuffix(const char *rest, const char *line, size_t labelLength)
+{
+    static const char globalDirective[] = "; .global ";
+
+    while (*rest == ' ' || *rest == '\t')
+        rest++;
+    if (strncmp(rest, globalDirective, strlen(globalDirective)) == 0)
+    {
+        rest += strlen(globalDirective);
+        if (strncmp(rest, line, labelLength) != 0 || IsLabelChar(rest[labelLength]))
+            return false;
+        rest += labelLength;
+    }
+    while (isspace((unsigned char)*rest))
+        rest++;
+    return *rest == '\0';
+}
+
+int main(int argc, char **argv)
+{
+    char line[MAX_LINE_LENGTH];
+    const char *table;
+    const char *compiledTable;
+    bool afterData = false;
+    bool foundTable = false;
+    int macroDepth = 0;
+    int lineNum = 0;
+
+    if (argc != 3)
+        FATAL_ERROR("Usage: aiscript TABLE COMPILED_TABLE < input.s > output.s\n");
+
+    table = argv[1];
+    compiledTable = argv[2];
+
+    printf("\t.set AI_SCRIPT_COMPILED, 1\n");
+
+    while (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        size_t labelLength;
+        const char *token;
+        size_t tokenLength;
+
+        lineNum++;
+        if (strchr(line, '\n') == NULL && !feof(stdin))
+            FATAL_ERROR("Line %d is too long.\n", lineNum);
+
+        labelLength = macroDepth == 0 ? GetLabelLength(line) : 0;
+        if (labelLength != 0)
+        {
+            const char *rest = line + labelLength + 1;
+
+            if (*rest == ':')
+                rest++;
+            if (!IsLabelSuffix(rest, line, labelLength))
+                FATAL_ERROR("Line %d: unexpected text after label \"%.*s\".\n", lineNum, (int)labelLength, line);
+            if (afterData)
+                printf("\t.balign 4\n");
+            afterData = false;
+
+            if (labelLength == strlen(table) && strncmp(line, table, labelLength) == 0)
+            {
+                printf("\t.global %s\n%s:\n", compiledTable, compiledTable);
+                foundTable = true;
+            }
+            else
+            {
+                printf("%.*s:\n", (int)labelLength, line);
+            }
+            continue;
+        }
+
+        token = line;
+        while (*token == ' ' || *token == '\t')
+            token++;
+        tokenLength = 0;
+        while (IsLabelChar(token[tokenLength]))
+            tokenLength++;
+
+        // Indented lines are either directives or script commands; anything
+        // else (blank lines, comments, line markers) is copied as is, and so
+        // are macro definitions, which preproc has pasted in from the
+        // .include of asm/macros/battle_ai_script.inc.
+        if (token != line && tokenLength != 0)
+        {
+            if (IsToken(token, tokenLength, ".macro"))
+            {
+                macroDepth++;
+            }
+            else if (IsToken(token, tokenLength, ".endm"))
+            {
+                if (macroDepth == 0)
+                    FATAL_ERROR("Line %d: .endm outside a macro.\n", lineNum);
+                macroDepth--;
+            }
+            else if (macroDepth != 0)
+            {
+                // Copied as is.
+            }
+            else if (token[0] == '.')
+            {
+                if (IsDataDirective(token, tokenLength))
+                    afterData = true;
+            }
+            else
+            {
+                if (afterData)
+                    printf("\t.balign 4\n");
+                afterData = false;
+            }
+        }
+        fputs(line, stdout);
+    }
+
+    if (!foundTable)
+        FATAL_ERROR("Label \"%s\" was not found.\n", table);
+
+    return 0;
+}
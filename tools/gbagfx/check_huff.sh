@@ -0,0 +1,48 @@
+#!/bin/sh
+# Huffman compresses every file under the given directories at both bit
+# depths with huff_check, which fails unless the output is byte for byte
+# what the encoder before the rewrite made, other than where that encoder
+# was wrong (see huff_check.c), and decompresses back to the file. At depth 8, data with many
+# distinct byte values can make a tree too deep for the format's 6-bit child
+# offsets. Both encoders refuse those, so they are counted separately rather
+# than as failures.
+#
+# Usage: check_huff.sh DIR...
+
+HUFF_CHECK="$(dirname "$0")/huff_check"
+err="$(mktemp)"
+trap 'rm -f "$err"' EXIT
+
+total=0
+lastword=0
+treeorpadding=0
+failed=0
+toodeep=0
+
+for file in $(find "$@" -type f -size +0c \( -name '*.png' -o -name '*.bin' \)); do
+	for depth in 4 8; do
+		total=$((total + 1))
+		if result="$("$HUFF_CHECK" "$file" $depth 2>"$err")"; then
+			case "$result" in
+			"last word") lastword=$((lastword + 1)) ;;
+			"tree or padding") treeorpadding=$((treeorpadding + 1)) ;;
+			esac
+		else
+			if grep -q "unable to encode binary tree" "$err"; then
+				toodeep=$((toodeep + 1))
+			else
+				failed=$((failed + 1))
+				echo "$file (depth $depth): $(cat "$err")" >&2
+			fi
+		fi
+	done
+done
+
+if [ $total -eq 0 ]; then
+	echo "check_huff.sh: no files found" >&2
+	exit 1
+fi
+echo "$((total - lastword - treeorpadding - failed - toodeep)) of $total compressions matched the old encoder," \
+	"$lastword only differed in the last word, $treeorpadding in the tree or padding," \
+	"$toodeep had trees too deep to encode, $failed failed"
+[ $failed -eq 0 ]
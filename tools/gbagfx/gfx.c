@@ -36,8 +36,70 @@ static void AdvanceMetatilePosition(int *subTileX, int *subTileY, int *metatileX
 	}
 }
 
+// A row of 8 pixels, as up to 8 bytes in the low end of a word, converted
+// between the order pixels are stored in tiles and the order they are
+// stored in a PNG. The conversion is its own inverse.
+static inline uint64_t ConvertPixelRow(uint64_t row, int bitDepth, bool invertColors)
+{
+	switch (bitDepth) {
+	case 1:
+		row = ((row >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((row << 4) & 0xF0F0F0F0F0F0F0F0ULL);
+		row = ((row >> 2) & 0x3333333333333333ULL) | ((row << 2) & 0xCCCCCCCCCCCCCCCCULL);
+		row = ((row >> 1) & 0x5555555555555555ULL) | ((row << 1) & 0xAAAAAAAAAAAAAAAAULL);
+		break;
+	case 4:
+		row = ((row >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((row << 4) & 0xF0F0F0F0F0F0F0F0ULL);
+		break;
+	}
+
+	if (invertColors)
+		row = ~row;
+
+	return row;
+}
+
+// With 1x1 metatiles the tiles are simply in reading order, so each tile
+// is 8 rows of bitDepth bytes, a pitch apart in the image.
+static inline void ConvertTilesByRow(unsigned char *tiles, unsigned char *pixels, int numTiles, int tilesWidth, int bitDepth, bool invertColors, bool toTiles)
+{
+	int pitch = tilesWidth * bitDepth;
+	unsigned char *tileStart = pixels;
+	int tileX = 0;
+
+	for (int i = 0; i < numTiles; i++) {
+		unsigned char *pixelRow = tileStart;
+
+		tileStart += bitDepth;
+		if (++tileX == tilesWidth) {
+			tileX = 0;
+			tileStart += 7 * pitch;
+		}
+
+		for (int j = 0; j < 8; j++) {
+			uint64_t row = 0;
+
+			if (toTiles) {
+				memcpy(&row, pixelRow, bitDepth);
+				row = ConvertPixelRow(row, bitDepth, invertColors);
+				memcpy(tiles, &row, bitDepth);
+			} else {
+				memcpy(&row, tiles, bitDepth);
+				row = ConvertPixelRow(row, bitDepth, invertColors);
+				memcpy(pixelRow, &row, bitDepth);
+			}
+			tiles += bitDepth;
+			pixelRow += pitch;
+		}
+	}
+}
+
 static void ConvertFromTiles1Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(src, dest, numTiles, metatilesWide, 1, invertColors, false);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -64,6 +126,11 @@ static void ConvertFromTiles1Bpp(unsigned char *src, unsigned char *dest, int nu
 
 static void ConvertFromTiles4Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(src, dest, numTiles, metatilesWide, 4, invertColors, false);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -95,6 +162,11 @@ static void ConvertFromTiles4Bpp(unsigned char *src, unsigned char *dest, int nu
 
 static void ConvertFromTiles8Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(src, dest, numTiles, metatilesWide, 8, invertColors, false);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -122,6 +194,11 @@ static void ConvertFromTiles8Bpp(unsigned char *src, unsigned char *dest, int nu
 
 static void ConvertToTiles1Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(dest, src, numTiles, metatilesWide, 1, invertColors, true);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -148,6 +225,11 @@ static void ConvertToTiles1Bpp(unsigned char *src, unsigned char *dest, int numT
 
 static void ConvertToTiles4Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(dest, src, numTiles, metatilesWide, 4, invertColors, true);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -179,6 +261,11 @@ static void ConvertToTiles4Bpp(unsigned char *src, unsigned char *dest, int numT
 
 static void ConvertToTiles8Bpp(unsigned char *src, unsigned char *dest, int numTiles, int metatilesWide, int metatileWidth, int metatileHeight, bool invertColors)
 {
+	if (metatileWidth == 1 && metatileHeight == 1) {
+		ConvertTilesByRow(dest, src, numTiles, metatilesWide, 8, invertColors, true);
+		return;
+	}
+
 	int subTileX = 0;
 	int subTileY = 0;
 	int metatileX = 0;
@@ -204,6 +291,40 @@ static void ConvertToTiles8Bpp(unsigned char *src, unsigned char *dest, int numT
 	}
 }
 
+void ConvertFromTiles(unsigned char *src, unsigned char *dest, int numTiles, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, bool invertColors)
+{
+	int metatilesWide = tilesWidth / metatileWidth;
+
+	switch (bitDepth) {
+	case 1:
+		ConvertFromTiles1Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	case 4:
+		ConvertFromTiles4Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	case 8:
+		ConvertFromTiles8Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	}
+}
+
+void ConvertToTiles(unsigned char *src, unsigned char *dest, int numTiles, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, bool invertColors)
+{
+	int metatilesWide = tilesWidth / metatileWidth;
+
+	switch (bitDepth) {
+	case 1:
+		ConvertToTiles1Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	case 4:
+		ConvertToTiles4Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	case 8:
+		ConvertToTiles8Bpp(src, dest, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		break;
+	}
+}
+
 static void DecodeAffineTilemap(unsigned char *input, unsigned char *output, unsigned char *tilemap, int tileSize, int numTiles)
 {
     for (int i = 0; i < numTiles; i++)
@@ -380,19 +501,7 @@ void ReadImage(char *path, int tilesWidth, int bitDepth, int metatileWidth, int
 	if (image->pixels == NULL)
 		FATAL_ERROR("Failed to allocate memory for pixels.\n");
 
-	int metatilesWide = tilesWidth / metatileWidth;
-
-	switch (bitDepth) {
-	case 1:
-		ConvertFromTiles1Bpp(buffer, image->pixels, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	case 4:
-		ConvertFromTiles4Bpp(buffer, image->pixels, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	case 8:
-		ConvertFromTiles8Bpp(buffer, image->pixels, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	}
+	ConvertFromTiles(buffer, image->pixels, numTiles, tilesWidth, bitDepth, metatileWidth, metatileHeight, invertColors);
 
 	free(buffer);
 }
@@ -429,19 +538,7 @@ void WriteImage(char *path, int numTiles, int bitDepth, int metatileWidth, int m
 	if (buffer == NULL)
 		FATAL_ERROR("Failed to allocate memory for pixels.\n");
 
-	int metatilesWide = tilesWidth / metatileWidth;
-
-	switch (bitDepth) {
-	case 1:
-		ConvertToTiles1Bpp(image->pixels, buffer, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	case 4:
-		ConvertToTiles4Bpp(image->pixels, buffer, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	case 8:
-		ConvertToTiles8Bpp(image->pixels, buffer, numTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
-		break;
-	}
+	ConvertToTiles(image->pixels, buffer, numTiles, tilesWidth, bitDepth, metatileWidth, metatileHeight, invertColors);
 
 	WriteWholeFile(path, buffer, bufferSize);
 
@@ -44,6 +44,8 @@ struct Image {
 	bool isAffine;
 };
 
+void ConvertFromTiles(unsigned char *src, unsigned char *dest, int numTiles, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, bool invertColors);
+void ConvertToTiles(unsigned char *src, unsigned char *dest, int numTiles, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, bool invertColors);
 void ReadImage(char *path, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors);
 void WriteImage(char *path, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors);
 void FreeImage(struct Image *image);
@@ -96,81 +96,57 @@ int msort(void * data, size_t count, size_t size, cmpfun cmp) {
 static void write_tree(unsigned char * dest, HuffNode_t * tree, int nitems, struct BitEncoding * encoding) {
     /*
      * The example used to guide this function encodes the tree in a
-     * breadth-first manner.  We attempt to emulate that here.
+     * breadth-first manner, one level at a time from left to right.
+     * Walking the tree with a queue visits the nodes in that order, and
+     * the queue is the encoded order itself: the children of each branch
+     * are appended to it side by side.
      */
 
-    int i, j, k;
+    int nnodes = 2 * nitems - 1;
+    int i, count;
 
-    // There are (2 * nitems - 1) nodes in the binary tree.  Allocate that.
-    HuffNode_t * traversal = calloc(2 * nitems - 1, sizeof(HuffNode_t));
-    if (traversal == NULL)
+    HuffNode_t ** traversal = malloc(nnodes * sizeof(HuffNode_t *));
+    struct BitEncoding * paths = malloc(nnodes * sizeof(struct BitEncoding));
+    if (traversal == NULL || paths == NULL)
         FATAL_ERROR("Fatal error while compressing Huff file.\n");
 
     // The first node is the root of the tree.
-    traversal[0] = *tree;
-    i = 1;
-
-    // Copy the tree into a breadth-first ordering using brute force.
-    for (int depth = 1; i < 2 * nitems - 1; depth++) {
-        // Consider every possible path up to the current depth.
-        for (j = 0; i < 2 * nitems - 1 && j < 1 << depth; j++) {
-            // The index of the path is used to encode the path itself.
-            // Start from the most significant relevant bit and work our way down.
-            // Keep track of the current and previous nodes.
-            HuffNode_t * currNode = traversal;
-            HuffNode_t * parent = NULL;
-            for (k = 0; k < depth; k++) {
-                if (currNode->header.isLeaf)
-                    break;
-                parent = currNode;
-                if ((j >> (depth - k - 1)) & 1)
-                    currNode = currNode->branch.right;
-                else
-                    currNode = currNode->branch.left;
-            }
-            // Check that the length of the current path equals the current depth.
-            if (k == depth) {
-                // Make sure we can encode the current branch.
-                // Bail here if we cannot.
-                // This is only applicable for 8-bit encodings.
-                if (traversal + i - parent > 128)
-                    FATAL_ERROR("Fatal error while compressing Huff file: unable to encode binary tree.\n");
-                // Copy the current node, and update its parent.
-                traversal[i] = *currNode;
-                if (parent != NULL) {
-                    if ((j & 1) == 1)
-                        parent->branch.right = traversal + i;
-                    else
-                        parent->branch.left = traversal + i;
-                }
-                // Encode the path through the tree in the lookup table
-                if (traversal[i].header.isLeaf) {
-                    encoding[traversal[i].leaf.key].nbits = depth;
-                    encoding[traversal[i].leaf.key].bitstring = j;
-                }
-                i++;
-            }
-        }
-    }
+    traversal[0] = tree;
+    paths[0].nbits = 0;
+    paths[0].bitstring = 0;
+    count = 1;
 
     // Encode the size of the tree.
     // This is used by the decompressor to skip the tree.
     dest[4] = nitems - 1;
 
-    // Encode each node in the tree.
-    for (i = 0; i < 2 * nitems - 1; i++) {
-        HuffNode_t * currNode = traversal + i;
+    for (i = 0; i < nnodes; i++) {
+        HuffNode_t * currNode = traversal[i];
         if (currNode->header.isLeaf) {
-            dest[5 + i] = traversal[i].leaf.key;
-        } else {
-            dest[5 + i] = (((currNode->branch.right - traversal - i) / 2) - 1);
-            if (currNode->branch.left->header.isLeaf)
-                dest[5 + i] |= 0x80;
-            if (currNode->branch.right->header.isLeaf)
-                dest[5 + i] |= 0x40;
+            dest[5 + i] = currNode->leaf.key;
+            encoding[currNode->leaf.key] = paths[i];
+            continue;
         }
+        // Make sure we can encode the offset to the children.
+        // Bail here if we cannot.
+        // This is only applicable for 8-bit encodings.
+        if (count + 1 - i > 128)
+            FATAL_ERROR("Fatal error while compressing Huff file: unable to encode binary tree.\n");
+        dest[5 + i] = (((count + 1 - i) / 2) - 1);
+        if (currNode->branch.left->header.isLeaf)
+            dest[5 + i] |= 0x80;
+        if (currNode->branch.right->header.isLeaf)
+            dest[5 + i] |= 0x40;
+        traversal[count] = currNode->branch.left;
+        paths[count].nbits = paths[i].nbits + 1;
+        paths[count].bitstring = paths[i].bitstring << 1;
+        traversal[count + 1] = currNode->branch.right;
+        paths[count + 1].nbits = paths[i].nbits + 1;
+        paths[count + 1].bitstring = (paths[i].bitstring << 1) | 1;
+        count += 2;
     }
 
+    free(paths);
     free(traversal);
 }
 
@@ -193,22 +169,26 @@ static inline void read_32_le(unsigned char * src, int * srcPos, uint32_t * buff
     *buff = tmp;
 }
 
-static void write_bits(unsigned char * dest, int * destPos, struct BitEncoding * encoding, int value, uint32_t * buff, int * buffBits) {
-    int nbits = encoding[value].nbits;
-    uint32_t bitstring = encoding[value].bitstring;
-
-    if (*buffBits + nbits >= 32) {
-        int diff = *buffBits + nbits - 32;
-        *buff <<= nbits - diff;
-        *buff |= bitstring >> diff;
-        bitstring &= ~(1 << diff);
-        nbits = diff;
-        write_32_le(dest, destPos, buff, buffBits);
-    }
-    if (nbits != 0) {
-        *buff <<= nbits;
-        *buff |= bitstring;
-        *buffBits += nbits;
+/*
+ * The codes for every symbol in a source byte, low nybble first, so the
+ * data can be encoded a byte at a time.
+ */
+struct ByteEncoding {
+    uint32_t bitstring;
+    int nbits;
+};
+
+static void make_byte_encodings(struct ByteEncoding * byteEncoding, struct BitEncoding * encoding, int bitDepth) {
+    for (int i = 0; i < 256; i++) {
+        if (bitDepth == 8) {
+            byteEncoding[i].bitstring = encoding[i].bitstring;
+            byteEncoding[i].nbits = encoding[i].nbits;
+        } else {
+            struct BitEncoding * lo = &encoding[i & 0xF];
+            struct BitEncoding * hi = &encoding[i >> 4];
+            byteEncoding[i].bitstring = ((uint32_t)lo->bitstring << hi->nbits) | (uint32_t)hi->bitstring;
+            byteEncoding[i].nbits = lo->nbits + hi->nbits;
+        }
     }
 }
 
@@ -224,7 +204,7 @@ unsigned char * HuffCompress(unsigned char * src, int srcSize, int * compressedS
 
     int worstCaseDestSize = 4 + (2 << bitDepth) + srcSize * 3;
 
-    unsigned char *dest = malloc(worstCaseDestSize);
+    unsigned char *dest = calloc(worstCaseDestSize, 1);
     if (dest == NULL)
         goto fail;
 
@@ -265,9 +245,13 @@ unsigned char * HuffCompress(unsigned char * src, int srcSize, int * compressedS
     if (!msort(freqs, nitems, sizeof(HuffNode_t), cmp_tree))
         goto fail;
 
-    // Prune zero-frequency values.
+    // Prune zero-frequency values. A tree needs at least two leaves for the
+    // decompressor to read a bit per value, so if only one value is used,
+    // one unused value is kept alongside it.
     for (int i = 0; i < nitems; i++) {
         if (freqs[i].header.value != 0) {
+            if (i == nitems - 1)
+                i--;
             if (i > 0) {
                 for (int j = i; j < nitems; j++) {
                     freqs[j - i] = freqs[j];
@@ -285,47 +269,71 @@ unsigned char * HuffCompress(unsigned char * src, int srcSize, int * compressedS
     if (tree == NULL)
         goto fail;
 
-    // Iteratively collapse the two least frequent nodes.
-    HuffNode_t * endptr = freqs + nitems - 2;
+    HuffNode_t * branches = calloc(nitems, sizeof(HuffNode_t));
+    if (branches == NULL)
+        goto fail;
+
+    // Iteratively collapse the two least frequent nodes. The leaves are
+    // sorted, and every new branch weighs at least as much as the one
+    // before it, so the lightest node is always at the front of either the
+    // leaves or the branches. Ties go to the leaf, which is where a stable
+    // sort of the two together would put it.
+    int leafPos = 0;
+    int branchPos = 0;
 
     for (int i = 0; i < nitems - 1; i++) {
-        HuffNode_t * left = freqs;
-        HuffNode_t * right = freqs + 1;
-        tree[i * 2] = *right;
-        tree[i * 2 + 1] = *left;
-        for (int j = 0; j < nitems - i - 2; j++)
-            freqs[j] = freqs[j + 2];
-        endptr->header.isLeaf = 0;
-        endptr->header.value = tree[i * 2].header.value + tree[i * 2 + 1].header.value;
-        endptr->branch.left = tree + i * 2;
-        endptr->branch.right = tree + i * 2 + 1;
-        endptr--;
-        if (i < nitems - 2 && !msort(freqs, nitems - i - 1, sizeof(HuffNode_t), cmp_tree))
-            goto fail;
+        HuffNode_t * picked[2];
+        for (int j = 0; j < 2; j++) {
+            if (branchPos == i || (leafPos < nitems && freqs[leafPos].header.value <= branches[branchPos].header.value))
+                picked[j] = &freqs[leafPos++];
+            else
+                picked[j] = &branches[branchPos++];
+        }
+        tree[i * 2] = *picked[1];
+        tree[i * 2 + 1] = *picked[0];
+        branches[i].header.isLeaf = 0;
+        branches[i].header.value = tree[i * 2].header.value + tree[i * 2 + 1].header.value;
+        branches[i].branch.left = tree + i * 2;
+        branches[i].branch.right = tree + i * 2 + 1;
     }
 
     // Write the tree breadth-first, and create the path lookup table.
-    write_tree(dest, freqs, nitems, encoding);
+    write_tree(dest, &branches[nitems - 2], nitems, encoding);
 
+    free(branches);
     free(tree);
     free(freqs);
 
-    // Encode the data itself.
+    struct ByteEncoding byteEncoding[256];
+    make_byte_encodings(byteEncoding, encoding, bitDepth);
+
+    // Encode the data itself, a byte at a time, into 32-bit words whose
+    // first bit is the most significant. Data whose size isn't a multiple of
+    // 4 is padded with zeros, or with copies of its last byte if zero has no
+    // code.
     int destPos = 4 + nitems * 2;
-    uint32_t destBuf = 0;
-    uint32_t srcBuf = 0;
+    int paddedSize = (srcSize + 3) & ~3;
+    int padding = byteEncoding[0].nbits != 0 ? 0 : src[srcSize - 1];
+    uint64_t destBuf = 0;
     int destBitPos = 0;
 
-    for (int srcPos = 0; srcPos < srcSize;) {
-        read_32_le(src, &srcPos, &srcBuf);
-        for (int i = 0; i < 32 / bitDepth; i++) {
-            write_bits(dest, &destPos, encoding, srcBuf & (0xFF >> (8 - bitDepth)), &destBuf, &destBitPos);
-            srcBuf >>= bitDepth;
+    for (int srcPos = 0; srcPos < paddedSize; srcPos++) {
+        struct ByteEncoding * code = &byteEncoding[srcPos < srcSize ? src[srcPos] : padding];
+        destBuf = (destBuf << code->nbits) | code->bitstring;
+        destBitPos += code->nbits;
+        if (destBitPos >= 32) {
+            destBitPos -= 32;
+            uint32_t word = destBuf >> destBitPos;
+            int wordPos = 0;
+            write_32_le(dest, &destPos, &word, &wordPos);
         }
     }
 
+    // The last word is read from its most significant bit down like all the
+    // others, so its bits go at the top.
     if (destBitPos != 0) {
-        write_32_le(dest, &destPos, &destBuf, &destBitPos);
+        uint32_t word = (destBuf & ((1ull << destBitPos) - 1)) << (32 - destBitPos);
+        write_32_le(dest, &destPos, &word, &destBitPos);
     }
 
     free(encoding);
@@ -343,7 +351,17 @@ fail:
 }
 
 unsigned char * HuffDecompress(unsigned char * src, int srcSize, int * uncompressedSize_p) {
-    if (srcSize < 4)
+    unsigned char * dest = HuffTryDecompress(src, srcSize, uncompressedSize_p);
+
+    if (dest == NULL)
+        FATAL_ERROR("Fatal error while decompressing Huff file.\n");
+    return dest;
+}
+
+unsigned char * HuffTryDecompress(unsigned char * src, int srcSize, int * uncompressedSize_p) {
+    unsigned char * dest = NULL;
+
+    if (srcSize < 5)
         goto fail;
 
     int bitDepth = *src & 15;
@@ -352,7 +370,8 @@ unsigned char * HuffDecompress(unsigned char * src, int srcSize, int * uncompres
 
     int destSize = (src[3] << 16) | (src[2] << 8) | src[1];
 
-    unsigned char *dest = malloc(destSize);
+    // Values are written out a word at a time, the last one included.
+    dest = malloc((destSize + 3) & ~3);
 
     if (dest == NULL)
         goto fail;
@@ -372,17 +391,21 @@ unsigned char * HuffDecompress(unsigned char * src, int srcSize, int * uncompres
         read_32_le(src, &srcPos, &window);
         for (int i = 0; i < 32; i++) {
             int curBit = (window >> 31) & 1;
+            if (treePos >= srcSize)
+                goto fail;
             unsigned char treeView = src[treePos];
             bool isLeaf = ((treeView << curBit) & 0x80) != 0;
             treePos &= ~1; // align
             treePos += ((treeView & 0x3F) + 1) * 2 + curBit;
             if (isLeaf) {
+                if (treePos >= srcSize)
+                    goto fail;
                 destTmp >>= bitDepth;
                 destTmp |= (src[treePos] << (32 - bitDepth));
                 curValPos++;
                 if (curValPos == 32 / bitDepth) {
                     write_32_le(dest, &destPos, &destTmp, &curValPos);
-                    if (destPos == destSize) {
+                    if (destPos >= destSize) {
                         *uncompressedSize_p = destSize;
                         return dest;
                     }
@@ -394,5 +417,6 @@ unsigned char * HuffDecompress(unsigned char * src, int srcSize, int * uncompres
     }
 
 fail:
-    FATAL_ERROR("Fatal error while decompressing Huff file.\n");
+    free(dest);
+    return NULL;
 }
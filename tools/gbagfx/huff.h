@@ -34,5 +34,7 @@ struct BitEncoding {
 
 unsigned char * HuffCompress(unsigned char * buffer, int srcSize, int * compressedSize_p, int bitDepth);
 unsigned char * HuffDecompress(unsigned char * buffer, int srcSize, int * uncompressedSize_p);
+// Like HuffDecompress, but returns NULL for malformed data instead of exiting.
+unsigned char * HuffTryDecompress(unsigned char * buffer, int srcSize, int * uncompressedSize_p);
 
 #endif //HUFF_H
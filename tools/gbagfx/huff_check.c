@@ -0,0 +1,110 @@
+// Compresses a file with HuffCompress and with the encoder it replaced, kept
+// in huff_old.c, and checks that the two outputs are the same byte for byte,
+// and that the new one decompresses back to the file. The old encoder got
+// three things wrong, and only those may differ:
+// - its last data word was right-aligned, though the decompressor reads
+//   every word from the top. Only that word may differ, reported as
+//   "last word" on stdout;
+// - data with one distinct value got a tree with no branches, and
+// - padding used zero even when zero had no code. Such data may be encoded
+//   differently throughout, reported as "tree or padding".
+// Run over the whole tree by check_huff.sh.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "global.h"
+#include "huff.h"
+#include "util.h"
+
+unsigned char * HuffCompressOld(unsigned char * src, int srcSize, int * compressedSize_p, int bitDepth);
+
+static bool DecompressesTo(unsigned char *data, int size, unsigned char *expected, int expectedSize)
+{
+    int uncompressedSize;
+    unsigned char *uncompressed = HuffTryDecompress(data, size, &uncompressedSize);
+    bool same = uncompressed != NULL && uncompressedSize == expectedSize
+             && memcmp(uncompressed, expected, expectedSize) == 0;
+
+    free(uncompressed);
+    return same;
+}
+
+// Whether the old encoder's tree or padding was wrong for this data.
+static bool HadBadTreeOrPadding(unsigned char *buffer, int fileSize, int bitDepth)
+{
+    int counts[256] = {0};
+    int distinct = 0;
+
+    for (int i = 0; i < fileSize; i++)
+    {
+        if (bitDepth == 8)
+        {
+            counts[buffer[i]]++;
+        }
+        else
+        {
+            counts[buffer[i] >> 4]++;
+            counts[buffer[i] & 0xF]++;
+        }
+    }
+    for (int i = 0; i < 256; i++)
+    {
+        if (counts[i] != 0)
+            distinct++;
+    }
+    return distinct == 1 || (fileSize % 4 != 0 && counts[0] == 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+        FATAL_ERROR("Usage: huff_check FILE DEPTH\n");
+
+    int bitDepth = atoi(argv[2]);
+
+    if (bitDepth != 4 && bitDepth != 8)
+        FATAL_ERROR("DEPTH must be 4 or 8.\n");
+
+    // The old encoder reads the source a word at a time.
+    int fileSize;
+    unsigned char *buffer = ReadWholeFileZeroPadded(argv[1], &fileSize, 3);
+    int newSize, oldSize;
+    unsigned char *newData = HuffCompress(buffer, fileSize, &newSize, bitDepth);
+    unsigned char *oldData = HuffCompressOld(buffer, fileSize, &oldSize, bitDepth);
+
+    if (!DecompressesTo(newData, newSize, buffer, fileSize))
+        FATAL_ERROR("Doesn't decompress back to the file.\n");
+
+    if (HadBadTreeOrPadding(buffer, fileSize, bitDepth))
+    {
+        printf("tree or padding\n");
+        return 0;
+    }
+
+    if (newSize != oldSize)
+        FATAL_ERROR("Compressed to %d bytes, but the old encoder made %d.\n", newSize, oldSize);
+
+    // The data words follow the header and the tree, and the output may end
+    // with two bytes of alignment after them.
+    int dataStart = 4 + (newData[4] + 1) * 2;
+    int dataEnd = dataStart + (newSize - dataStart) / 4 * 4;
+    bool lastWordDiffers = false;
+
+    for (int i = 0; i < newSize; i++)
+    {
+        if (newData[i] == oldData[i])
+            continue;
+        if (i < dataEnd - 4 || i >= dataEnd)
+            FATAL_ERROR("Differs from the old encoder's output at byte %d.\n", i);
+        lastWordDiffers = true;
+    }
+    if (lastWordDiffers)
+        printf("last word\n");
+
+    free(oldData);
+    free(newData);
+    free(buffer);
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <time.h>
 #include "global.h"
 #include "util.h"
 #include "options.h"
@@ -480,10 +481,39 @@ void HandleRLDecompressCommand(char *inputPath, char *outputPath, int argc UNUSE
     free(uncompressedData);
 }
 
+// Compresses the data over and over to time the encoder, and checks that
+// it decompresses back to what went in.
+static void BenchHuffCompress(unsigned char *buffer, int fileSize, int bitDepth, int iterations)
+{
+    int compressedSize;
+    unsigned char *compressedData = NULL;
+    clock_t start = clock();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        free(compressedData);
+        compressedData = HuffCompress(buffer, fileSize, &compressedSize, bitDepth);
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    int uncompressedSize;
+    unsigned char *uncompressedData = HuffDecompress(compressedData, compressedSize, &uncompressedSize);
+
+    if (uncompressedSize != fileSize || memcmp(uncompressedData, buffer, fileSize) != 0)
+        FATAL_ERROR("Huff data doesn't decompress to its source.\n");
+
+    printf("%d bytes -> %d bytes, %.1f us per compression (%d iterations)\n",
+           fileSize, compressedSize, seconds * 1e6 / iterations, iterations);
+
+    free(uncompressedData);
+    free(compressedData);
+}
+
 void HandleHuffCompressCommand(char *inputPath, char *outputPath, int argc, char **argv)
 {
     int fileSize;
     int bitDepth = 4;
+    int benchIterations = 0;
 
     for (int i = 3; i < argc; i++)
     {
@@ -502,6 +532,19 @@ void HandleHuffCompressCommand(char *inputPath, char *outputPath, int argc, char
             if (bitDepth != 4 && bitDepth != 8)
                 FATAL_ERROR("GBA only supports bit depth of 4 or 8.\n");
         }
+        else if (strcmp(option, "-bench") == 0)
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR("No count following \"-bench\".\n");
+
+            i++;
+
+            if (!ParseNumber(argv[i], NULL, 10, &benchIterations))
+                FATAL_ERROR("Failed to parse benchmark iteration count.\n");
+
+            if (benchIterations < 1)
+                FATAL_ERROR("Benchmark iteration count must be positive.\n");
+        }
         else
         {
             FATAL_ERROR("Unrecognized option \"%s\".\n", option);
@@ -510,6 +553,9 @@ void HandleHuffCompressCommand(char *inputPath, char *outputPath, int argc, char
 
     unsigned char *buffer = ReadWholeFile(inputPath, &fileSize);
 
+    if (benchIterations != 0)
+        BenchHuffCompress(buffer, fileSize, bitDepth, benchIterations);
+
     int compressedSize;
     unsigned char *compressedData = HuffCompress(buffer, fileSize, &compressedSize, bitDepth);
 
@@ -535,12 +581,91 @@ void HandleHuffDecompressCommand(char *inputPath, char *outputPath, int argc UNU
     free(uncompressedData);
 }
 
+// Times converting tile files to pixels and back, as the 1bpp, 4bpp and
+// 8bpp conversions do, over every file given. The files are laid out as
+// images 32 tiles wide, and each round trip must give back the original.
+static void BenchTileConversion(int iterations, int numFiles, char **paths)
+{
+    double fromSeconds = 0;
+    double toSeconds = 0;
+    long totalTiles = 0;
+
+    for (int i = 0; i < numFiles; i++)
+    {
+        char *extension = GetFileExtensionAfterDot(paths[i]);
+
+        if (extension == NULL || (strcmp(extension, "1bpp") != 0 && strcmp(extension, "4bpp") != 0 && strcmp(extension, "8bpp") != 0))
+            FATAL_ERROR("\"%s\" isn't a 1bpp, 4bpp or 8bpp file.\n", paths[i]);
+
+        int bitDepth = extension[0] - '0';
+        int tileSize = bitDepth * 8;
+        int fileSize;
+        unsigned char *tiles = ReadWholeFile(paths[i], &fileSize);
+        int numTiles = fileSize / tileSize;
+        int tilesWidth = numTiles < 32 ? numTiles : 32;
+
+        if (numTiles == 0)
+        {
+            free(tiles);
+            continue;
+        }
+
+        int tilesHeight = (numTiles + tilesWidth - 1) / tilesWidth;
+        unsigned char *pixels = calloc(tilesWidth * tilesHeight, tileSize);
+        unsigned char *roundTrip = malloc(numTiles * tileSize);
+
+        if (pixels == NULL || roundTrip == NULL)
+            FATAL_ERROR("Failed to allocate memory for pixels.\n");
+
+        clock_t start = clock();
+        for (int j = 0; j < iterations; j++)
+            ConvertFromTiles(tiles, pixels, numTiles, tilesWidth, bitDepth, 1, 1, false);
+        clock_t middle = clock();
+        for (int j = 0; j < iterations; j++)
+            ConvertToTiles(pixels, roundTrip, numTiles, tilesWidth, bitDepth, 1, 1, false);
+        clock_t end = clock();
+
+        fromSeconds += (double)(middle - start) / CLOCKS_PER_SEC;
+        toSeconds += (double)(end - middle) / CLOCKS_PER_SEC;
+
+        if (memcmp(tiles, roundTrip, numTiles * tileSize) != 0)
+            FATAL_ERROR("\"%s\" doesn't convert back to itself.\n", paths[i]);
+
+        totalTiles += numTiles;
+        free(roundTrip);
+        free(pixels);
+        free(tiles);
+    }
+
+    if (totalTiles == 0)
+        FATAL_ERROR("The files given contain no whole tiles.\n");
+
+    printf("%d files, %ld tiles, %d iterations\n", numFiles, totalTiles, iterations);
+    printf("tiles to pixels: %.2f ns per tile\n", fromSeconds * 1e9 / ((double)totalTiles * iterations));
+    printf("pixels to tiles: %.2f ns per tile\n", toSeconds * 1e9 / ((double)totalTiles * iterations));
+}
+
 int main(int argc, char **argv)
 {
     char converted = 0;
 
+    if (argc >= 3 && strcmp(argv[1], "-bench") == 0)
+    {
+        int iterations;
+
+        if (!ParseNumber(argv[2], NULL, 10, &iterations) || iterations < 1)
+            FATAL_ERROR("Benchmark iteration count must be positive.\n");
+
+        if (argc == 3)
+            FATAL_ERROR("No files following the benchmark iteration count.\n");
+
+        BenchTileConversion(iterations, argc - 3, argv + 3);
+        return 0;
+    }
+
     if (argc < 3)
-        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n");
+        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n"
+                    "       gbagfx -bench ITERATIONS FILE.[148]bpp...\n");
 
     struct CommandHandler handlers[] =
     {